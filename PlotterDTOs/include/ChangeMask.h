@@ -0,0 +1,39 @@
+#ifndef CHANGE_MASK_H
+#define CHANGE_MASK_H
+
+#include <cstdint>
+
+namespace plotter {
+namespace dto {
+
+/**
+ * @brief Which stored fields an update has to write
+ *
+ * Mappers fill this in from the entity's changed fields, and data sources
+ * write only the flagged fields (plus the update timestamp). DTOs default
+ * to ALL, which keeps full-record updates for DTOs built by hand.
+ */
+struct ChangeMask {
+    static constexpr uint32_t NONE = 0;
+    static constexpr uint32_t NAME = 1u << 0;
+    static constexpr uint32_t DESCRIPTION = 1u << 1;
+    static constexpr uint32_t PATH = 1u << 2;
+    static constexpr uint32_t CONTENT = 1u << 3;
+    static constexpr uint32_t PARENT = 1u << 4;      // Parent folder and/or project
+    static constexpr uint32_t CHILDREN = 1u << 5;    // Child ID lists
+    static constexpr uint32_t ALL = ~0u;
+
+    uint32_t fields;
+
+    ChangeMask() : fields(ALL) {}
+    explicit ChangeMask(uint32_t fields) : fields(fields) {}
+
+    bool has(uint32_t field) const {
+        return (fields & field) != 0;
+    }
+};
+
+} // namespace dto
+} // namespace plotter
+
+#endif // CHANGE_MASK_H
@@ -0,0 +1,55 @@
+#ifndef DTO_CURSOR_H
+#define DTO_CURSOR_H
+
+#include "DTOList.h"
+#include <cstddef>
+#include <utility>
+
+namespace plotter {
+namespace dto {
+
+/**
+ * @brief Pull-based sequence of DTOs from a data source
+ *
+ * Unlike a DTOList, a cursor holds at most one DTO at a time, so a result
+ * set of any size is read in constant memory. Data sources that can read
+ * row by row return their own cursor; others hand out a DTOListCursor.
+ */
+template<typename Base>
+class DTOCursor {
+public:
+    virtual ~DTOCursor() = default;
+
+    /**
+     * @brief Advance to the next DTO
+     *
+     * The DTO belongs to the cursor and stays valid until the next call;
+     * callers may move its fields out.
+     *
+     * @return The next DTO, or nullptr once the cursor is exhausted
+     * @throws std::runtime_error if reading from the data source fails
+     */
+    virtual Base* next() = 0;
+};
+
+/**
+ * @brief Cursor over a list that has already been read in full
+ */
+template<typename Base>
+class DTOListCursor : public DTOCursor<Base> {
+public:
+    explicit DTOListCursor(DTOList<Base> list) : list_(std::move(list)) {}
+
+    Base* next() override {
+        return position_ < list_.size() ? &list_[position_++] : nullptr;
+    }
+
+private:
+    DTOList<Base> list_;
+    size_t position_ = 0;
+};
+
+} // namespace dto
+} // namespace plotter
+
+#endif // DTO_CURSOR_H
@@ -0,0 +1,241 @@
+#ifndef DTO_LIST_H
+#define DTO_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace plotter {
+namespace dto {
+
+/**
+ * @brief Owning handle for a single DTO returned by a data source
+ *
+ * Null means "not found". The DTO is freed when the handle goes out of scope.
+ */
+template<typename Base>
+using DTOPtr = std::unique_ptr<Base>;
+
+/**
+ * @brief Bump allocator that frees all of its memory at once
+ *
+ * Memory comes from blocks that grow geometrically; nothing is returned
+ * before the arena itself is destroyed. Objects placed in it are not
+ * destroyed by the arena.
+ */
+class DTOArena {
+public:
+    DTOArena() = default;
+    DTOArena(const DTOArena&) = delete;
+    DTOArena& operator=(const DTOArena&) = delete;
+    DTOArena(DTOArena&&) noexcept = default;
+    DTOArena& operator=(DTOArena&&) noexcept = default;
+
+    void* allocate(size_t size, size_t alignment) {
+        size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+        if (blocks_.empty() || offset + size > capacity_) {
+            capacity_ = std::max(nextBlockSize_, size);
+            nextBlockSize_ = std::min(nextBlockSize_ * 2, MAX_BLOCK_SIZE);
+            blocks_.emplace_back(static_cast<char*>(::operator new(capacity_)));
+            offset = 0;
+        }
+        used_ = offset + size;
+        return blocks_.back().get() + offset;
+    }
+
+    /**
+     * @brief Take over every block of another arena
+     *
+     * Objects placed in either arena stay where they are; new allocations
+     * continue in this arena's current block.
+     */
+    void absorb(DTOArena&& other) {
+        if (blocks_.empty()) {
+            *this = std::move(other);
+            return;
+        }
+        blocks_.reserve(blocks_.size() + other.blocks_.size());
+        blocks_.insert(blocks_.end() - 1, std::make_move_iterator(other.blocks_.begin()),
+                       std::make_move_iterator(other.blocks_.end()));
+        other.blocks_.clear();
+        other.capacity_ = other.used_ = 0;
+    }
+
+private:
+    static constexpr size_t FIRST_BLOCK_SIZE = 4 * 1024;
+    static constexpr size_t MAX_BLOCK_SIZE = 256 * 1024;
+
+    struct BlockDeleter {
+        void operator()(char* block) const { ::operator delete(block); }
+    };
+
+    std::vector<std::unique_ptr<char, BlockDeleter>> blocks_;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t nextBlockSize_ = FIRST_BLOCK_SIZE;
+};
+
+/**
+ * @brief Owning list of DTOs returned by a data source
+ *
+ * Data sources build the concrete DTOs in place with emplace_back(); they
+ * live in an arena owned by the list, so a result set costs a handful of
+ * block allocations rather than one per row. Destroying the list (or an
+ * exception while filling it) destroys every DTO and frees the blocks in
+ * one go. Callers see the elements as Base&, and may move fields out of
+ * them; the list still destroys them.
+ *
+ * The list also remembers whether every element has the same concrete
+ * type, so a mapper can check the type once for the whole list
+ * (holdsOnly()) and skip the per-element dynamic_cast.
+ */
+template<typename Base>
+class DTOList {
+public:
+    static_assert(std::has_virtual_destructor<Base>::value, "DTOs are destroyed through their base");
+
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Base;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Base*;
+        using reference = Base&;
+
+        explicit iterator(Base* const* position) : position_(position) {}
+        Base& operator*() const { return **position_; }
+        Base* operator->() const { return *position_; }
+        iterator& operator++() { ++position_; return *this; }
+        iterator operator++(int) { iterator previous = *this; ++position_; return previous; }
+        iterator& operator--() { --position_; return *this; }
+        iterator& operator+=(difference_type n) { position_ += n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(position_ + n); }
+        difference_type operator-(const iterator& other) const { return position_ - other.position_; }
+        Base& operator[](difference_type n) const { return *position_[n]; }
+        bool operator==(const iterator& other) const { return position_ == other.position_; }
+        bool operator!=(const iterator& other) const { return position_ != other.position_; }
+        bool operator<(const iterator& other) const { return position_ < other.position_; }
+
+    private:
+        Base* const* position_;
+    };
+
+    DTOList() = default;
+    DTOList(const DTOList&) = delete;
+    DTOList& operator=(const DTOList&) = delete;
+
+    DTOList(DTOList&& other) noexcept
+        : arena_(std::move(other.arena_)), items_(std::move(other.items_)),
+          elementType_(other.elementType_), mixedTypes_(other.mixedTypes_) {
+        other.items_.clear();
+        other.elementType_ = nullptr;
+        other.mixedTypes_ = false;
+    }
+
+    DTOList& operator=(DTOList&& other) noexcept {
+        if (this != &other) {
+            destroyItems();
+            arena_ = std::move(other.arena_);
+            items_ = std::move(other.items_);
+            elementType_ = other.elementType_;
+            mixedTypes_ = other.mixedTypes_;
+            other.items_.clear();
+            other.elementType_ = nullptr;
+            other.mixedTypes_ = false;
+        }
+        return *this;
+    }
+
+    ~DTOList() { destroyItems(); }
+
+    /**
+     * @brief Construct a concrete DTO at the end of the list
+     *
+     * @return The new DTO, valid as long as the list
+     */
+    template<typename T, typename... Args>
+    T& emplace_back(Args&&... args) {
+        static_assert(std::is_base_of<Base, T>::value, "DTO must derive from the list's base");
+        if (items_.size() == items_.capacity()) {
+            items_.reserve(std::max<size_t>(16, items_.capacity() * 2));  // So push_back cannot throw
+        }
+        void* memory = arena_.allocate(sizeof(T), alignof(T));
+        T* dto = new (memory) T(std::forward<Args>(args)...);
+        items_.push_back(dto);
+        if (!elementType_) {
+            elementType_ = &typeid(T);
+        } else if (*elementType_ != typeid(T)) {
+            mixedTypes_ = true;
+        }
+        return *dto;
+    }
+
+    /**
+     * @brief Move every DTO of another list to the end of this one
+     *
+     * The DTOs are not copied: their arena blocks change owner.
+     */
+    void append(DTOList&& other) {
+        if (other.items_.empty()) {
+            return;
+        }
+        items_.reserve(items_.size() + other.items_.size());
+        arena_.absorb(std::move(other.arena_));
+        items_.insert(items_.end(), other.items_.begin(), other.items_.end());
+        if (!elementType_) {
+            elementType_ = other.elementType_;
+            mixedTypes_ = other.mixedTypes_;
+        } else if (other.mixedTypes_ || *elementType_ != *other.elementType_) {
+            mixedTypes_ = true;
+        }
+        other.items_.clear();
+        other.elementType_ = nullptr;
+        other.mixedTypes_ = false;
+    }
+
+    void reserve(size_t count) { items_.reserve(count); }
+    size_t size() const { return items_.size(); }
+    bool empty() const { return items_.empty(); }
+
+    /**
+     * @brief Check whether every element is exactly a T
+     *
+     * True for an empty list. When it holds, elements can be static_cast to T&.
+     */
+    template<typename T>
+    bool holdsOnly() const {
+        return items_.empty() || (!mixedTypes_ && *elementType_ == typeid(T));
+    }
+
+    Base& operator[](size_t index) { return *items_[index]; }
+    const Base& operator[](size_t index) const { return *items_[index]; }
+
+    iterator begin() const { return iterator(items_.data()); }
+    iterator end() const { return iterator(items_.data() + items_.size()); }
+
+private:
+    void destroyItems() {
+        for (auto it = items_.rbegin(); it != items_.rend(); ++it) {
+            (*it)->~Base();
+        }
+        items_.clear();
+        elementType_ = nullptr;
+        mixedTypes_ = false;
+    }
+
+    DTOArena arena_;
+    std::vector<Base*> items_;
+    const std::type_info* elementType_ = nullptr;  // Type of the first element
+    bool mixedTypes_ = false;
+};
+
+} // namespace dto
+} // namespace plotter
+
+#endif // DTO_LIST_H
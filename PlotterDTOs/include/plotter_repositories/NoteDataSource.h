@@ -12,6 +12,7 @@
  */
 
 #include "BaseDTOs.h"
+#include "DTOList.h"
 #include <string>
 #include <vector>
 
@@ -31,10 +32,10 @@ public:
     virtual std::string getName() const = 0;
 
     virtual std::string create(dto::ProjectDTO* dto) = 0;
-    virtual dto::ProjectDTO* read(const std::string& id) = 0;
+    virtual dto::DTOPtr<dto::ProjectDTO> read(const std::string& id) = 0;
     virtual bool update(const std::string& id, dto::ProjectDTO* dto) = 0;
     virtual bool remove(const std::string& id) = 0;
-    virtual std::vector<dto::ProjectDTO*> list() = 0;
+    virtual dto::DTOList<dto::ProjectDTO> list() = 0;
 };
 
 /**
@@ -50,11 +51,11 @@ public:
     virtual std::string getName() const = 0;
 
     virtual std::string create(dto::FolderDTO* dto) = 0;
-    virtual dto::FolderDTO* read(const std::string& id) = 0;
+    virtual dto::DTOPtr<dto::FolderDTO> read(const std::string& id) = 0;
     virtual bool update(const std::string& id, dto::FolderDTO* dto) = 0;
     virtual bool remove(const std::string& id) = 0;
-    virtual std::vector<dto::FolderDTO*> listByProject(const std::string& projectId) = 0;
-    virtual std::vector<dto::FolderDTO*> listByParentFolder(const std::string& folderId) = 0;
+    virtual dto::DTOList<dto::FolderDTO> listByProject(const std::string& projectId) = 0;
+    virtual dto::DTOList<dto::FolderDTO> listByParentFolder(const std::string& folderId) = 0;
 };
 
 /**
@@ -70,10 +71,10 @@ public:
     virtual std::string getName() const = 0;
 
     virtual std::string create(dto::NoteDTO* dto) = 0;
-    virtual dto::NoteDTO* read(const std::string& id) = 0;
+    virtual dto::DTOPtr<dto::NoteDTO> read(const std::string& id) = 0;
     virtual bool update(const std::string& id, dto::NoteDTO* dto) = 0;
     virtual bool remove(const std::string& id) = 0;
-    virtual std::vector<dto::NoteDTO*> listByFolder(const std::string& folderId) = 0;
+    virtual dto::DTOList<dto::NoteDTO> listByFolder(const std::string& folderId) = 0;
 
     virtual std::string getContent(const std::string& id) = 0;
     virtual bool updateContent(const std::string& id, const std::string& content) = 0;
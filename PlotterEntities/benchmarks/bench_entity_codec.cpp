@@ -0,0 +1,185 @@
+// Compares EntityCodec with jsoncpp, the JSON library the filesystem backend
+// writes its metadata with, on encoding and decoding a batch of notes.
+//
+// Built with -DBUILD_BENCHMARKS=ON when jsoncpp is found; run
+// bench_entity_codec from an optimised (Release) build.
+
+#include "EntityCodec.h"
+#include <json/json.h>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int NOTES = 2000;
+const int ROUNDS = 10;
+
+std::vector<Note> makeNotes(size_t contentSize) {
+    std::vector<Note> notes;
+    notes.reserve(NOTES);
+    for (int i = 0; i < NOTES; i++) {
+        std::string id = "0190a1b2-c3d4-7e5f-8a9b-" + std::to_string(100000000000LL + i);
+        Note note(id, "Note " + std::to_string(i), "notes/" + id + ".md",
+                  "0190a1b2-c3d4-7e5f-8a9b-0000000000aa");
+        note.setContent(std::string(contentSize, 'a' + i % 26));
+        note.setAttribute("author", std::string("Jane Example"));
+        note.setAttribute("year", 2000 + i % 25);
+        note.setAttribute("rating", (i % 50) * 0.1);
+        note.setAttribute("archived", i % 2 == 0);
+        note.setAttribute("tags", std::vector<std::string>{"reading", "draft"});
+        notes.push_back(note);
+    }
+    return notes;
+}
+
+// The JSON layout mirrors the filesystem note metadata, plus the content and
+// attributes, which the codec also carries
+Json::Value toJson(const Note& note) {
+    Json::Value root;
+    root["id"] = note.getId();
+    root["name"] = note.getName();
+    root["path"] = note.getPath();
+    root["parentFolderId"] = note.getParentFolderId();
+    root["createdAt"] = (Json::Int64)std::chrono::duration_cast<std::chrono::milliseconds>(
+        note.getCreatedAt().time_since_epoch()).count();
+    root["updatedAt"] = (Json::Int64)std::chrono::duration_cast<std::chrono::milliseconds>(
+        note.getUpdatedAt().time_since_epoch()).count();
+    root["content"] = note.getContent();
+
+    Json::Value attributes(Json::objectValue);
+    for (const AttributeStore::Entry& entry : note.getAttributes()) {
+        Json::Value& value = attributes[*entry.key];
+        if (auto text = std::get_if<std::string>(&entry.value)) {
+            value = *text;
+        } else if (auto integer = std::get_if<int64_t>(&entry.value)) {
+            value = (Json::Int64)*integer;
+        } else if (auto real = std::get_if<double>(&entry.value)) {
+            value = *real;
+        } else if (auto boolean = std::get_if<bool>(&entry.value)) {
+            value = *boolean;
+        } else if (auto list = std::get_if<std::vector<std::string>>(&entry.value)) {
+            value = Json::Value(Json::arrayValue);
+            for (const auto& item : *list) {
+                value.append(item);
+            }
+        }
+    }
+    root["attributes"] = attributes;
+    return root;
+}
+
+Note fromJson(const Json::Value& root) {
+    Note note(root["id"].asString(), root["name"].asString(), root["path"].asString(),
+              root["parentFolderId"].asString());
+    note.setContent(root["content"].asString());
+    const Json::Value& attributes = root["attributes"];
+    for (const auto& key : attributes.getMemberNames()) {
+        const Json::Value& value = attributes[key];
+        if (value.isBool()) {
+            note.setAttribute(key, value.asBool());
+        } else if (value.isInt64()) {
+            note.setAttribute(key, value.asInt64());
+        } else if (value.isDouble()) {
+            note.setAttribute(key, value.asDouble());
+        } else if (value.isArray()) {
+            std::vector<std::string> list;
+            for (const auto& item : value) {
+                list.push_back(item.asString());
+            }
+            note.setAttribute(key, list);
+        } else {
+            note.setAttribute(key, value.asString());
+        }
+    }
+    return note;
+}
+
+template<typename Function>
+double timeRounds(Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        function();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char* label, size_t bytes, double seconds) {
+    std::printf("  %-28s %10.1f MB/s  %10.0f notes/s\n", label,
+                bytes * double(ROUNDS) / seconds / 1e6, double(NOTES) * ROUNDS / seconds);
+}
+
+void run(size_t contentSize) {
+    std::vector<Note> notes = makeNotes(contentSize);
+
+    std::vector<std::string> json(NOTES);
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    double jsonEncode = timeRounds([&]() {
+        for (int i = 0; i < NOTES; i++) {
+            json[i] = Json::writeString(builder, toJson(notes[i]));
+        }
+    });
+
+    std::string binary;
+    double binaryEncode = timeRounds([&]() {
+        binary.clear();
+        for (const Note& note : notes) {
+            EntityCodec::encode(note, binary);
+        }
+    });
+
+    size_t jsonBytes = 0;
+    for (const auto& document : json) {
+        jsonBytes += document.size();
+    }
+
+    size_t checksum = 0;
+    Json::CharReaderBuilder readerBuilder;
+    std::unique_ptr<Json::CharReader> reader(readerBuilder.newCharReader());
+    double jsonDecode = timeRounds([&]() {
+        for (const auto& document : json) {
+            Json::Value root;
+            std::string errors;
+            reader->parse(document.data(), document.data() + document.size(), &root, &errors);
+            checksum += fromJson(root).getContent().size();
+        }
+    });
+
+    double binaryDecode = timeRounds([&]() {
+        std::string_view input = binary;
+        while (!input.empty()) {
+            checksum += EntityCodec::decodeNote(EntityCodec::readRecord(input)).toEntity().getContent().size();
+        }
+    });
+
+    // Reading fields straight from the views, without building entities
+    double binaryViews = timeRounds([&]() {
+        std::string_view input = binary;
+        while (!input.empty()) {
+            EntityCodec::NoteView view = EntityCodec::decodeNote(EntityCodec::readRecord(input));
+            checksum += view.content.size() + view.attributes.size();
+        }
+    });
+
+    std::printf("%zu-byte content: JSON %zu B/note, binary %zu B/note  (checksum %zu)\n", contentSize,
+                jsonBytes / NOTES, binary.size() / NOTES, checksum);
+    report("jsoncpp encode", jsonBytes, jsonEncode);
+    report("EntityCodec encode", binary.size(), binaryEncode);
+    report("jsoncpp decode to Note", jsonBytes, jsonDecode);
+    report("EntityCodec decode to Note", binary.size(), binaryDecode);
+    report("EntityCodec decode to view", binary.size(), binaryViews);
+    std::printf("\n");
+}
+
+} // namespace
+
+int main() {
+    std::printf("Note serialization, %d notes x %d rounds\n\n", NOTES, ROUNDS);
+    for (size_t contentSize : {64, 2048, 65536}) {
+        run(contentSize);
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+// Compares the memory and lookup cost of Note attributes stored in
+// AttributeStore against the previous std::unordered_map<std::string, std::any>.
+//
+// Build with -DBUILD_BENCHMARKS=ON and run bench_note_attributes; optimised
+// (Release) builds give the meaningful numbers.
+
+#include "AttributeStore.h"
+#include <any>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+// Live heap usage. With glibc the real block size (request rounded up, plus
+// the chunk header) is counted, since per-allocation overhead is part of what
+// node-based containers cost; elsewhere only the requested bytes are.
+size_t liveBytes = 0;
+size_t liveAllocations = 0;
+
+size_t blockSize(void* memory, size_t requested) {
+#if defined(__GLIBC__)
+    (void)requested;
+    return malloc_usable_size(memory) + sizeof(size_t);
+#else
+    (void)memory;
+    return requested;
+#endif
+}
+
+constexpr size_t HEADER = alignof(std::max_align_t);
+
+} // namespace
+
+void* operator new(size_t size) {
+    char* block = static_cast<char*>(std::malloc(size + HEADER));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    size_t counted = blockSize(block, size + HEADER) - HEADER;
+    *reinterpret_cast<size_t*>(block) = counted;
+    liveBytes += counted;
+    liveAllocations++;
+    return block + HEADER;
+}
+
+void operator delete(void* memory) noexcept {
+    if (memory) {
+        char* block = static_cast<char*>(memory) - HEADER;
+        liveBytes -= *reinterpret_cast<size_t*>(block);
+        liveAllocations--;
+        std::free(block);
+    }
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    operator delete(memory);
+}
+
+namespace {
+
+using LegacyAttributes = std::unordered_map<std::string, std::any>;
+
+const int NOTES = 10000;
+const int LOOKUP_ROUNDS = 20;
+
+// Realistic attribute names: short, shared by every note
+std::string keyName(int index) {
+    static const char* names[] = {"author", "year", "rating", "archived", "journal",
+                                  "doi", "citations", "language", "status", "priority"};
+    return index < 10 ? names[index] : "custom_field_" + std::to_string(index);
+}
+
+template<typename Map>
+void fill(Map& map, int attributes, int note);
+
+template<>
+void fill(LegacyAttributes& map, int attributes, int note) {
+    for (int i = 0; i < attributes; i++) {
+        switch (i % 4) {
+            case 0: map[keyName(i)] = std::string("value of a note attribute ") + std::to_string(note); break;
+            case 1: map[keyName(i)] = note + i; break;
+            case 2: map[keyName(i)] = note * 0.5; break;
+            default: map[keyName(i)] = (note + i) % 2 == 0; break;
+        }
+    }
+}
+
+template<>
+void fill(AttributeStore& store, int attributes, int note) {
+    for (int i = 0; i < attributes; i++) {
+        switch (i % 4) {
+            case 0: store.set(keyName(i), std::string("value of a note attribute ") + std::to_string(note)); break;
+            case 1: store.set(keyName(i), AttributeStore::toValue(note + i)); break;
+            case 2: store.set(keyName(i), AttributeStore::toValue(note * 0.5)); break;
+            default: store.set(keyName(i), AttributeStore::toValue((note + i) % 2 == 0)); break;
+        }
+    }
+}
+
+long long lookupAll(const std::vector<LegacyAttributes>& notes, const std::vector<std::string>& keys) {
+    long long checksum = 0;
+    for (const auto& map : notes) {
+        for (size_t i = 1; i < keys.size(); i += 4) {
+            auto it = map.find(keys[i]);
+            if (it != map.end()) {
+                checksum += std::any_cast<int>(it->second);
+            }
+        }
+    }
+    return checksum;
+}
+
+long long lookupAll(const std::vector<AttributeStore>& notes, const std::vector<std::string>& keys) {
+    long long checksum = 0;
+    for (const auto& store : notes) {
+        for (size_t i = 1; i < keys.size(); i += 4) {
+            if (const AttributeValue* value = store.find(keys[i])) {
+                checksum += *AttributeStore::fromValue<int>(*value);
+            }
+        }
+    }
+    return checksum;
+}
+
+template<typename Map>
+void run(const char* label, int attributes) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < attributes; i++) {
+        keys.push_back(keyName(i));
+    }
+
+    // Intern the keys up front so the pool is not charged to the first notes
+    AttributeStore warmup;
+    fill(warmup, attributes, 0);
+
+    std::vector<Map> notes(NOTES);
+    size_t bytesBefore = liveBytes;
+    size_t countBefore = liveAllocations;
+    for (int note = 0; note < NOTES; note++) {
+        fill(notes[note], attributes, note);
+    }
+    double bytesPerNote = double(liveBytes - bytesBefore) / NOTES + sizeof(Map);
+    double allocationsPerNote = double(liveAllocations - countBefore) / NOTES;
+
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < LOOKUP_ROUNDS; round++) {
+        checksum += lookupAll(notes, keys);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    double lookups = double(NOTES) * LOOKUP_ROUNDS * ((attributes + 2) / 4);
+
+    std::printf("%-14s %3d attrs  %8.0f B/note  %6.1f allocs/note  %6.1f ns/lookup  (checksum %lld)\n",
+                label, attributes, bytesPerNote, allocationsPerNote, elapsed / lookups, checksum);
+}
+
+} // namespace
+
+int main() {
+    std::printf("Note attribute storage, %d notes\n\n", NOTES);
+    for (int attributes : {5, 10, 20}) {
+        run<LegacyAttributes>("unordered_map", attributes);
+        run<AttributeStore>("AttributeStore", attributes);
+        std::printf("\n");
+    }
+    return 0;
+}
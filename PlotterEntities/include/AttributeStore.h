@@ -0,0 +1,178 @@
+#ifndef ATTRIBUTE_STORE_H
+#define ATTRIBUTE_STORE_H
+
+#include "SmallVector.h"
+#include "StringInterner.h"
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+using AttributeTimestamp = std::chrono::system_clock::time_point;
+
+/**
+ * @brief Value of a note attribute: one of a closed set of common types
+ *
+ * All integers are stored as int64_t and all floating-point numbers as
+ * double; the alternatives are listed in the order of AttributeStore::Kind.
+ */
+using AttributeValue = std::variant<std::string, int64_t, double, bool,
+                                    AttributeTimestamp, std::vector<std::string>>;
+
+/**
+ * @brief Flat key/value store for the attributes of one note
+ *
+ * Entries sit in a SmallVector, so a note with a handful of attributes makes
+ * no allocation for the store itself and one for many, instead of one hash
+ * node (plus a possible std::any payload) per attribute. Keys are interned in
+ * the StringInterner, so an attribute name used by every note is stored once
+ * per process and an entry is just a key handle and a value. A lookup is a
+ * linear scan over the entries with no hashing at all, which for the 5-20
+ * attributes a note typically has beats a hash table probe.
+ */
+class AttributeStore {
+public:
+    enum class Kind {
+        String,
+        Integer,
+        Real,
+        Boolean,
+        Timestamp,
+        StringList
+    };
+
+    /**
+     * @brief One attribute: an interned key and its value
+     */
+    struct Entry {
+        InternedString key;
+        AttributeValue value;
+    };
+
+    static constexpr size_t INLINE_CAPACITY = 4;
+
+    /**
+     * @brief Set an attribute, replacing any previous value under the key
+     *
+     * @param key The attribute key
+     * @param value The new value
+     */
+    void set(const std::string& key, AttributeValue value);
+
+    /**
+     * @brief Look up an attribute
+     *
+     * @param key The attribute key
+     * @return Pointer to the value, or nullptr if the key is not set
+     */
+    const AttributeValue* find(const std::string& key) const;
+
+    bool contains(const std::string& key) const;
+
+    /**
+     * @brief Remove an attribute
+     *
+     * @param key The attribute key
+     * @return True if the key was set, false otherwise
+     */
+    bool remove(const std::string& key);
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    const Entry* begin() const { return entries_.begin(); }
+    const Entry* end() const { return entries_.end(); }
+
+    static Kind kindOf(const AttributeValue& value) {
+        return static_cast<Kind>(value.index());
+    }
+
+    /**
+     * @brief Convert a C++ value to the attribute alternative that holds it
+     *
+     * Fails to compile for types outside the closed set.
+     */
+    template<typename T>
+    static AttributeValue toValue(const T& value);
+
+    /**
+     * @brief Read a value as T
+     *
+     * @return The value, or nothing if the stored alternative does not hold a T
+     *         (e.g. reading an integer attribute as a string, or one too large
+     *         for an int as an int)
+     */
+    template<typename T>
+    static std::optional<T> fromValue(const AttributeValue& value);
+
+private:
+    const Entry* findEntry(const std::string& key) const;
+
+    SmallVector<Entry, INLINE_CAPACITY> entries_;
+};
+
+// Template implementations
+template<typename T>
+AttributeValue AttributeStore::toValue(const T& value) {
+    using Type = std::decay_t<T>;
+    if constexpr (std::is_same<Type, bool>::value) {
+        return AttributeValue(std::in_place_type<bool>, value);
+    } else if constexpr (std::is_integral<Type>::value) {
+        return AttributeValue(std::in_place_type<int64_t>, static_cast<int64_t>(value));
+    } else if constexpr (std::is_floating_point<Type>::value) {
+        return AttributeValue(std::in_place_type<double>, static_cast<double>(value));
+    } else if constexpr (std::is_same<Type, AttributeTimestamp>::value) {
+        return AttributeValue(std::in_place_type<AttributeTimestamp>, value);
+    } else if constexpr (std::is_same<Type, std::vector<std::string>>::value) {
+        return AttributeValue(std::in_place_type<std::vector<std::string>>, value);
+    } else {
+        static_assert(std::is_convertible<const T&, std::string>::value,
+                      "Attribute values must be strings, integers, floating point, bool, "
+                      "timestamps or string lists");
+        return AttributeValue(std::in_place_type<std::string>, value);
+    }
+}
+
+template<typename T>
+std::optional<T> AttributeStore::fromValue(const AttributeValue& value) {
+    if constexpr (std::is_same<T, bool>::value) {
+        if (const bool* stored = std::get_if<bool>(&value)) {
+            return *stored;
+        }
+    } else if constexpr (std::is_integral<T>::value) {
+        if (const int64_t* stored = std::get_if<int64_t>(&value)) {
+            // A value T cannot hold is a mismatch, not something to truncate
+            if constexpr (std::is_signed<T>::value) {
+                if (*stored < static_cast<int64_t>(std::numeric_limits<T>::min()) ||
+                    *stored > static_cast<int64_t>(std::numeric_limits<T>::max())) {
+                    return std::nullopt;
+                }
+            } else {
+                if (*stored < 0 || static_cast<uint64_t>(*stored) > std::numeric_limits<T>::max()) {
+                    return std::nullopt;
+                }
+            }
+            return static_cast<T>(*stored);
+        }
+    } else if constexpr (std::is_floating_point<T>::value) {
+        if (const double* stored = std::get_if<double>(&value)) {
+            return static_cast<T>(*stored);
+        }
+    } else if constexpr (std::is_same<T, AttributeTimestamp>::value ||
+                         std::is_same<T, std::vector<std::string>>::value ||
+                         std::is_same<T, std::string>::value) {
+        if (const T* stored = std::get_if<T>(&value)) {
+            return *stored;
+        }
+    } else {
+        static_assert(std::is_same<T, std::string>::value,
+                      "Attributes can only be read as strings, integers, floating point, bool, "
+                      "timestamps or string lists");
+    }
+    return std::nullopt;
+}
+
+#endif // ATTRIBUTE_STORE_H
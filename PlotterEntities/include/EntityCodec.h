@@ -0,0 +1,212 @@
+#ifndef ENTITY_CODEC_H
+#define ENTITY_CODEC_H
+
+#include "Project.h"
+#include "Folder.h"
+#include "Note.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Compact binary encoding of Project, Folder and Note
+ *
+ * For caches, snapshots and IPC that need entities as bytes without going
+ * through a backend's DTOs. Each entity is one record:
+ *
+ *     version (u8) | kind (u8) | payload length (u32, little-endian) | payload
+ *
+ * Records can be concatenated; readRecord() steps through them. In the
+ * payload, strings and lists are prefixed with their length as a LEB128
+ * varint, integers and timestamps (nanoseconds since the epoch) are zigzag
+ * varints and doubles are 8 little-endian bytes. Fields are written in a
+ * fixed order per kind; later versions may only append fields, so a decoder
+ * skips payload bytes it does not know. Records from a newer version than
+ * VERSION are rejected.
+ *
+ * Decoding checks the whole record up front and then hands out views whose
+ * strings point into the input buffer; nothing is copied until toEntity().
+ * The input must outlive the views. Malformed input throws
+ * std::runtime_error.
+ */
+class EntityCodec {
+public:
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 6;
+
+    enum class Kind : uint8_t {
+        Project = 1,
+        Folder = 2,
+        Note = 3
+    };
+
+    /**
+     * @brief One record, header parsed, payload not yet decoded
+     */
+    struct Record {
+        uint8_t version;
+        Kind kind;
+        std::string_view payload;
+    };
+
+    /**
+     * @brief List of strings inside a record, read on iteration
+     */
+    class StringListView {
+    public:
+        class iterator {
+        public:
+            iterator(const char* position, size_t remaining) : position_(position), remaining_(remaining) {}
+            std::string_view operator*() const;
+            iterator& operator++();
+            bool operator!=(const iterator& other) const { return remaining_ != other.remaining_; }
+
+        private:
+            const char* position_;
+            size_t remaining_;
+        };
+
+        StringListView() : data_(nullptr), count_(0) {}
+        StringListView(const char* data, size_t count) : data_(data), count_(count) {}
+
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        iterator begin() const { return iterator(data_, count_); }
+        iterator end() const { return iterator(nullptr, 0); }
+
+    private:
+        const char* data_;
+        size_t count_;
+    };
+
+    /**
+     * @brief One note attribute inside a record
+     *
+     * Only the member matching kind is set.
+     */
+    struct AttributeView {
+        std::string_view key;
+        AttributeStore::Kind kind;
+        std::string_view text;          // String
+        int64_t integer = 0;            // Integer, and Timestamp in nanoseconds
+        double real = 0;                // Real
+        bool boolean = false;           // Boolean
+        StringListView list;            // StringList
+
+        /**
+         * @brief Copy the value out into an AttributeValue
+         */
+        AttributeValue toValue() const;
+    };
+
+    /**
+     * @brief Attributes of a note inside a record, read on iteration
+     */
+    class AttributeListView {
+    public:
+        class iterator {
+        public:
+            iterator(const char* position, size_t remaining) : position_(position), remaining_(remaining) {}
+            AttributeView operator*() const;
+            iterator& operator++();
+            bool operator!=(const iterator& other) const { return remaining_ != other.remaining_; }
+
+        private:
+            const char* position_;
+            size_t remaining_;
+        };
+
+        AttributeListView() : data_(nullptr), count_(0) {}
+        AttributeListView(const char* data, size_t count) : data_(data), count_(count) {}
+
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        iterator begin() const { return iterator(data_, count_); }
+        iterator end() const { return iterator(nullptr, 0); }
+
+    private:
+        const char* data_;
+        size_t count_;
+    };
+
+    struct ProjectView {
+        std::string_view id;
+        std::string_view name;
+        std::string_view description;
+        StringListView folderIds;
+
+        Project toEntity() const;
+    };
+
+    struct FolderView {
+        std::string_view id;
+        std::string_view name;
+        std::string_view description;
+        std::string_view parentProjectId;
+        std::string_view parentFolderId;
+        StringListView noteIds;
+        StringListView subfolderIds;
+
+        Folder toEntity() const;
+    };
+
+    struct NoteView {
+        std::string_view id;
+        std::string_view name;
+        std::string_view path;
+        std::string_view parentFolderId;
+        AttributeTimestamp createdAt;
+        AttributeTimestamp updatedAt;
+        std::string_view content;
+        AttributeListView attributes;
+
+        /**
+         * @brief Build the note, timestamps included
+         *
+         * Like any new entity, the result has every field marked dirty.
+         */
+        Note toEntity() const;
+    };
+
+    /**
+     * @brief Append the encoding of an entity to a buffer
+     *
+     * Encoding a note with lazily bound content loads the content.
+     */
+    static void encode(const Project& project, std::string& out);
+    static void encode(const Folder& folder, std::string& out);
+    static void encode(const Note& note, std::string& out);
+
+    template<typename Entity>
+    static std::string encode(const Entity& entity) {
+        std::string out;
+        encode(entity, out);
+        return out;
+    }
+
+    /**
+     * @brief Split the first record off the input
+     *
+     * @param input Encoded records; advanced past the record on success
+     * @return The record
+     * @throws std::runtime_error if the header is truncated or invalid, the
+     *         version is newer than VERSION or the payload is cut short
+     */
+    static Record readRecord(std::string_view& input);
+
+    /**
+     * @brief Decode one record of the given kind
+     *
+     * @param record An encoded record, or a Record from readRecord()
+     * @return A view into the record's bytes
+     * @throws std::runtime_error if the record is malformed or of another kind
+     */
+    static ProjectView decodeProject(std::string_view record);
+    static ProjectView decodeProject(const Record& record);
+    static FolderView decodeFolder(std::string_view record);
+    static FolderView decodeFolder(const Record& record);
+    static NoteView decodeNote(std::string_view record);
+    static NoteView decodeNote(const Record& record);
+};
+
+#endif // ENTITY_CODEC_H
@@ -0,0 +1,175 @@
+#ifndef ENTITY_ID_H
+#define ENTITY_ID_H
+
+#include "StringInterner.h"
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+
+/**
+ * @brief Compact, interned identifier of a project, folder or note
+ *
+ * An EntityId is a handle to the identifier's single copy in the
+ * StringInterner plus its precomputed hash: 16 bytes however long the ID.
+ * Entities that share a parent share one copy of the parent's ID, equality is
+ * a pointer comparison and hashing is a load. Copies count as references, so
+ * the pooled copy goes away with the last EntityId that names it.
+ *
+ * Constructing an EntityId from a string interns it (one hash plus a shared
+ * lock), so EntityIds are for references to other entities; FileItem keeps
+ * its own ID as a plain string. Lookups that should not add anything to the
+ * pool go through find(). The empty ID holds no handle, so default
+ * construction never touches the interner.
+ */
+class EntityId {
+private:
+    InternedString value_;
+    size_t hash_;
+
+    static const std::string& emptyString() {
+        static const std::string empty;
+        return empty;
+    }
+
+    EntityId(InternedString value, size_t hash) noexcept : value_(std::move(value)), hash_(hash) {}
+
+public:
+    /**
+     * @brief Construct the empty ID
+     */
+    EntityId() noexcept : hash_(0) {}
+
+    /**
+     * @brief Construct from a string, interning it
+     *
+     * Implicit so that string IDs can be passed wherever an EntityId is taken.
+     *
+     * @param value The identifier; an empty string gives the empty ID
+     */
+    EntityId(const std::string& value)
+        : hash_(0) {
+        if (!value.empty()) {
+            hash_ = std::hash<std::string>()(value);
+            value_ = InternedString(value, hash_);
+        }
+    }
+
+    /**
+     * @brief Construct from a C string, interning it
+     *
+     * @param value The identifier; an empty string gives the empty ID
+     */
+    EntityId(const char* value) : EntityId(std::string(value)) {}
+
+    EntityId(const EntityId&) = default;
+    EntityId& operator=(const EntityId&) = default;
+
+    EntityId(EntityId&& other) noexcept : value_(std::move(other.value_)), hash_(other.hash_) {
+        other.hash_ = 0;
+    }
+
+    EntityId& operator=(EntityId&& other) noexcept {
+        value_ = std::move(other.value_);
+        hash_ = other.hash_;
+        other.hash_ = 0;
+        return *this;
+    }
+
+    /**
+     * @brief Look up the EntityId of a string without interning it
+     *
+     * @param value The identifier
+     * @return The ID if some EntityId already holds it, otherwise the empty ID
+     */
+    static EntityId find(const std::string& value) {
+        if (value.empty()) {
+            return EntityId();
+        }
+        size_t hash = std::hash<std::string>()(value);
+        InternedString existing = InternedString::existing(value, hash);
+        if (!existing.get()) {
+            return EntityId();
+        }
+        return EntityId(std::move(existing), hash);
+    }
+
+    /**
+     * @brief Get the identifier as a string
+     *
+     * @return Const reference to the pooled string, valid while this EntityId (or a copy) lives
+     */
+    const std::string& str() const {
+        const std::string* value = value_.get();
+        return value ? *value : emptyString();
+    }
+
+    operator const std::string&() const {
+        return str();
+    }
+
+    bool empty() const noexcept {
+        return value_.get() == nullptr;
+    }
+
+    size_t hash() const noexcept {
+        return hash_;
+    }
+
+    friend bool operator==(const EntityId& a, const EntityId& b) noexcept {
+        return a.value_.get() == b.value_.get();
+    }
+
+    friend bool operator!=(const EntityId& a, const EntityId& b) noexcept {
+        return a.value_.get() != b.value_.get();
+    }
+
+    friend bool operator==(const EntityId& a, const std::string& b) {
+        return a.str() == b;
+    }
+
+    friend bool operator!=(const EntityId& a, const std::string& b) {
+        return a.str() != b;
+    }
+
+    friend bool operator==(const std::string& a, const EntityId& b) {
+        return a == b.str();
+    }
+
+    friend bool operator!=(const std::string& a, const EntityId& b) {
+        return a != b.str();
+    }
+
+    friend bool operator==(const EntityId& a, const char* b) {
+        return a.str() == b;
+    }
+
+    friend bool operator!=(const EntityId& a, const char* b) {
+        return a.str() != b;
+    }
+
+    /**
+     * @brief Order by the identifier text, so sorted IDs read the same as sorted strings
+     */
+    friend bool operator<(const EntityId& a, const EntityId& b) {
+        return a.value_.get() != b.value_.get() && a.str() < b.str();
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const EntityId& id) {
+        return out << id.str();
+    }
+};
+
+static_assert(sizeof(EntityId) <= 16, "EntityId must fit in 16 bytes");
+
+namespace std {
+template<>
+struct hash<EntityId> {
+    size_t operator()(const EntityId& id) const noexcept {
+        return id.hash();
+    }
+};
+} // namespace std
+
+#endif // ENTITY_ID_H
@@ -0,0 +1,69 @@
+#ifndef FIELD_MASK_H
+#define FIELD_MASK_H
+
+#include <cstdint>
+
+/**
+ * @brief Persisted fields of the entities, one bit each
+ *
+ * Not every entity has every field: Path and Content belong to notes,
+ * ParentProject to folders, Children to folders and projects.
+ */
+enum class EntityField : uint32_t {
+    Name = 1u << 0,
+    Description = 1u << 1,
+    Path = 1u << 2,
+    Content = 1u << 3,
+    ParentFolder = 1u << 4,
+    ParentProject = 1u << 5,
+    Children = 1u << 6,
+    Attributes = 1u << 7
+};
+
+/**
+ * @brief Set of EntityField values
+ */
+class FieldMask {
+private:
+    uint32_t bits_;
+
+public:
+    constexpr FieldMask() : bits_(0) {}
+    constexpr FieldMask(EntityField field) : bits_(static_cast<uint32_t>(field)) {}
+
+    /**
+     * @brief Mask holding every field
+     */
+    static constexpr FieldMask all() {
+        FieldMask mask;
+        mask.bits_ = ~0u;
+        return mask;
+    }
+
+    constexpr bool has(EntityField field) const {
+        return (bits_ & static_cast<uint32_t>(field)) != 0;
+    }
+
+    constexpr bool empty() const { return bits_ == 0; }
+    constexpr uint32_t bits() const { return bits_; }
+
+    FieldMask& operator|=(FieldMask other) {
+        bits_ |= other.bits_;
+        return *this;
+    }
+
+    constexpr FieldMask operator|(FieldMask other) const {
+        FieldMask mask;
+        mask.bits_ = bits_ | other.bits_;
+        return mask;
+    }
+
+    constexpr bool operator==(FieldMask other) const { return bits_ == other.bits_; }
+    constexpr bool operator!=(FieldMask other) const { return bits_ != other.bits_; }
+};
+
+constexpr FieldMask operator|(EntityField left, EntityField right) {
+    return FieldMask(left) | FieldMask(right);
+}
+
+#endif // FIELD_MASK_H
@@ -1,6 +1,8 @@
 #ifndef FILEITEM_H
 #define FILEITEM_H
 
+#include "EntityId.h"
+#include "FieldMask.h"
 #include <string>
 
 /**
@@ -8,12 +10,25 @@
  * 
  * FileItem provides common properties shared by all entities in the system:
  * a unique identifier, a human-readable name, and a type string.
+ * 
+ * It also records which persisted fields were changed through setters, so
+ * repositories can write back only those. A newly constructed item counts
+ * every field as changed; mappers clear the mask on items they load.
  */
 class FileItem {
 private:
-    std::string id;
+    std::string id;    // Not interned: unique per entity, so pooling it would only grow the pool
     std::string name;
     std::string type;
+    FieldMask dirtyFields;
+
+protected:
+    /**
+     * @brief Record that a persisted field was changed
+     * 
+     * @param field The field that changed
+     */
+    void markDirty(EntityField field);
 
 public:
     /**
@@ -23,7 +38,7 @@ public:
      * @param name Human-readable name
      * @param type Type string (e.g., "note", "folder", "project")
      */
-    FileItem(const std::string& id, const std::string& name, const std::string& type);
+    FileItem(std::string id, std::string name, std::string type);
 
     /**
      * @brief Virtual destructor for proper cleanup in derived classes
@@ -37,6 +52,16 @@ public:
      */
     const std::string& getId() const;
 
+    /**
+     * @brief Get the unique identifier in its interned form
+     * 
+     * Interns the ID on each call; use it where the ID is about to be stored
+     * as a reference (a child list, an index), not for plain lookups.
+     * 
+     * @return The item's ID as an EntityId
+     */
+    EntityId getEntityId() const;
+
     /**
      * @brief Get the name
      * 
@@ -64,6 +89,28 @@ public:
      * @param type The new type string for the item
      */
     void setType(const std::string& type);
+
+    /**
+     * @brief Get the fields changed since the item was loaded
+     * 
+     * @return Mask of changed fields (all fields for a new item)
+     */
+    FieldMask getDirtyFields() const;
+
+    /**
+     * @brief Check whether a field was changed since the item was loaded
+     * 
+     * @param field The field to check
+     * @return True if the field was changed
+     */
+    bool isDirty(EntityField field) const;
+
+    /**
+     * @brief Mark every field as unchanged
+     * 
+     * Called once the item matches what is stored, e.g. after loading or saving.
+     */
+    void clearDirtyFields();
 };
 
 #endif // FILEITEM_H
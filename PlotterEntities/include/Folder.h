@@ -2,6 +2,7 @@
 #define FOLDER_H
 
 #include "FileItem.h"
+#include "IndexedIdSet.h"
 #include <string>
 #include <vector>
 
@@ -15,10 +16,10 @@
 class Folder : public FileItem {
 private:
     std::string description;
-    std::string parentProjectId; // ID of parent project (empty if top-level in project)
-    std::string parentFolderId;  // ID of parent folder (empty if top-level)
-    std::vector<std::string> noteIds; // IDs of notes in this folder
-    std::vector<std::string> subfolderIds; // IDs of subfolders
+    EntityId parentProjectId; // ID of parent project (empty if top-level in project)
+    EntityId parentFolderId;  // ID of parent folder (empty if top-level)
+    IndexedIdSet noteIds; // IDs of notes in this folder
+    IndexedIdSet subfolderIds; // IDs of subfolders
 
 public:
     /**
@@ -30,8 +31,8 @@ public:
      * @param parentProjectId ID of the parent project (empty string if none)
      * @param parentFolderId ID of the parent folder (empty string if top-level)
      */
-    Folder(const std::string& id, const std::string& name, const std::string& description,
-           const std::string& parentProjectId, const std::string& parentFolderId);
+    Folder(std::string id, std::string name, std::string description,
+           const EntityId& parentProjectId, const EntityId& parentFolderId);
 
     /**
      * @brief Get the description
@@ -59,7 +60,7 @@ public:
      * 
      * @param parentProjectId The ID of the parent project
      */
-    void setParentProjectId(const std::string& parentProjectId);
+    void setParentProjectId(const EntityId& parentProjectId);
 
     /**
      * @brief Get the parent folder ID
@@ -73,21 +74,30 @@ public:
      * 
      * @param parentFolderId The ID of the parent folder
      */
-    void setParentFolderId(const std::string& parentFolderId);
+    void setParentFolderId(const EntityId& parentFolderId);
 
     /**
      * @brief Get all note IDs
      * 
      * @return Const reference to the vector of note IDs
      */
-    const std::vector<std::string>& getNoteIds() const;
+    const std::vector<EntityId>& getNoteIds() const;
 
     /**
      * @brief Add a note ID to this folder
      * 
      * @param noteId The ID of the note to add
+     * @return True if the note ID was added, false if it was already present
      */
-    void addNoteId(const std::string& noteId);
+    bool addNoteId(const EntityId& noteId);
+
+    /**
+     * @brief Check whether a note belongs to this folder
+     * 
+     * @param noteId The ID of the note
+     * @return True if the note ID is in this folder
+     */
+    bool hasNoteId(const std::string& noteId) const;
 
     /**
      * @brief Remove a note ID from this folder
@@ -102,14 +112,23 @@ public:
      * 
      * @return Const reference to the vector of subfolder IDs
      */
-    const std::vector<std::string>& getSubfolderIds() const;
+    const std::vector<EntityId>& getSubfolderIds() const;
 
     /**
      * @brief Add a subfolder ID to this folder
      * 
      * @param subfolderId The ID of the subfolder to add
+     * @return True if the subfolder ID was added, false if it was already present
+     */
+    bool addSubfolderId(const EntityId& subfolderId);
+
+    /**
+     * @brief Check whether a folder is a direct subfolder of this folder
+     * 
+     * @param subfolderId The ID of the subfolder
+     * @return True if the subfolder ID is in this folder
      */
-    void addSubfolderId(const std::string& subfolderId);
+    bool hasSubfolderId(const std::string& subfolderId) const;
 
     /**
      * @brief Remove a subfolder ID from this folder
@@ -118,6 +137,9 @@ public:
      * @return True if the subfolder ID was found and removed, false otherwise
      */
     bool removeSubfolderId(const std::string& subfolderId);
+
+private:
+    bool markChildrenDirty(bool changed);
 };
 
 #endif // FOLDER_H
@@ -0,0 +1,67 @@
+#ifndef INDEXED_ID_SET_H
+#define INDEXED_ID_SET_H
+
+#include "EntityId.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Insertion-ordered set of entity IDs with constant-time updates
+ *
+ * The IDs live in a vector, in insertion order, next to a hash index from ID
+ * to position. Membership and insertion are one hash lookup. Removal
+ * overwrites the slot with a tombstone (the empty ID) instead of shifting the
+ * tail, so removing k children of a large folder costs O(k), not O(k * n).
+ *
+ * Tombstones are squeezed out lazily: the first items() call after a removal
+ * compacts the vector in one pass, as does an insertion once tombstones
+ * outnumber live entries. Like the entities that own it, an IndexedIdSet is
+ * not safe for concurrent use, including concurrent calls to items().
+ */
+class IndexedIdSet {
+private:
+    mutable std::vector<EntityId> items_;
+    mutable std::unordered_map<EntityId, size_t> index_;
+    mutable size_t tombstones_ = 0;
+
+    void compact() const;
+
+public:
+    /**
+     * @brief Append an ID unless it is already present
+     *
+     * @param id The ID to add; the empty ID is ignored
+     * @return True if the ID was added, false if it was empty or already present
+     */
+    bool insert(const EntityId& id);
+
+    /**
+     * @brief Remove an ID
+     *
+     * @param id The ID to remove
+     * @return True if the ID was found and removed, false otherwise
+     */
+    bool erase(const EntityId& id);
+
+    /**
+     * @brief Check whether an ID is present
+     *
+     * @param id The ID to look up
+     * @return True if the ID is in the set
+     */
+    bool contains(const EntityId& id) const;
+
+    /**
+     * @brief Get the IDs in insertion order
+     *
+     * @return Const reference to the compacted vector of IDs
+     */
+    const std::vector<EntityId>& items() const;
+
+    size_t size() const;
+    bool empty() const;
+    void clear();
+};
+
+#endif // INDEXED_ID_SET_H
@@ -0,0 +1,72 @@
+#ifndef LAZY_CONTENT_H
+#define LAZY_CONTENT_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Note content that is either already in memory or loaded on first use
+ *
+ * A handle holds an immutable shared buffer, or a loader that produces one
+ * the first time get() is called. Copies of a handle share the pending load,
+ * so a note copied out of a repository loads its content at most once, and
+ * concurrent first reads run the loader only once. If the loader throws,
+ * nothing is cached and the next get() tries again.
+ */
+class LazyContent {
+public:
+    /**
+     * @brief Callback that fetches the content from storage
+     */
+    using Loader = std::function<std::string()>;
+
+    /**
+     * @brief Construct a handle holding empty content
+     */
+    LazyContent();
+
+    /**
+     * @brief Construct a handle holding an existing buffer
+     *
+     * @param buffer The content; null means empty content
+     */
+    explicit LazyContent(std::shared_ptr<const std::string> buffer);
+
+    /**
+     * @brief Construct a handle that loads its content on first access
+     *
+     * @param loader Called at most once, unless it throws
+     */
+    explicit LazyContent(Loader loader);
+
+    /**
+     * @brief Get the content, loading it first if needed
+     *
+     * @return The content buffer (never null)
+     * @throws Whatever the loader throws, typically std::runtime_error
+     */
+    const std::shared_ptr<const std::string>& get() const;
+
+    /**
+     * @brief Check whether the content is in memory
+     *
+     * @return False while a loader is still pending
+     */
+    bool isLoaded() const;
+
+private:
+    struct Pending {
+        std::once_flag once;
+        std::atomic<bool> loaded{false};
+        Loader loader;
+        std::shared_ptr<const std::string> buffer;
+    };
+
+    std::shared_ptr<const std::string> buffer_;
+    std::shared_ptr<Pending> pending_;     // Set only for content not yet known at construction
+};
+
+#endif // LAZY_CONTENT_H
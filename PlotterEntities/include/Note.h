@@ -2,10 +2,14 @@
 #define NOTE_H
 
 #include "FileItem.h"
+#include "AttributeStore.h"
+#include "LazyContent.h"
+#include "NoteStorage.h"
 #include <string>
-#include <unordered_map>
 #include <chrono>
-#include <any>
+#include <functional>
+#include <memory>
+#include <stdexcept>
 
 /**
  * @brief Represents a note entity with content and metadata
@@ -17,13 +21,35 @@
 class Note : public FileItem {
 private:
     std::string path; // Path to note content in storage (metadata only)
-    std::string content; // The actual content of the note
-    std::string parentFolderId; // ID of parent folder (relationship)
+    // The actual content of the note. Buffers are immutable and shared between
+    // copies of a note; setContent swaps in a new buffer instead of writing
+    // into one, so copying a note never copies its content. Content bound to
+    // storage is only fetched when first read.
+    LazyContent content;
+    EntityId parentFolderId; // ID of parent folder (relationship)
     std::chrono::system_clock::time_point createdAt;
     std::chrono::system_clock::time_point updatedAt;
-    std::unordered_map<std::string, std::any> attributes;
+    AttributeStore attributes;
+
+    // Open edit() scopes on this note. Not carried over to copies: a copy
+    // made inside a batch is not part of it.
+    struct BatchState {
+        int depth = 0;
+        bool changed = false;   // A setter ran since the outermost scope opened
+
+        BatchState() = default;
+        BatchState(const BatchState&) {}
+        BatchState& operator=(const BatchState&) { return *this; }
+    };
+    BatchState batch;
 
 public:
+    class Edit;
+
+    /**
+     * @brief Called when an edit scope commits, typically to persist the note
+     */
+    using CommitHandler = std::function<void(const Note&)>;
     /**
      * @brief Constructor for Note entity
      * 
@@ -32,8 +58,8 @@ public:
      * @param path The path where the note content is stored (for reference)
      * @param parentFolderId The ID of the parent folder (empty string if none)
      */
-    Note(const std::string& id, const std::string& name, const std::string& path,
-         const std::string& parentFolderId);
+    Note(std::string id, std::string name, std::string path,
+         const EntityId& parentFolderId);
 
     /**
      * @brief Get the storage path
@@ -61,22 +87,80 @@ public:
      * 
      * @param parentFolderId The ID of the parent folder
      */
-    void setParentFolderId(const std::string& parentFolderId);
+    void setParentFolderId(const EntityId& parentFolderId);
     
     /**
      * @brief Get the note content
      * 
+     * Content bound with bindContentStorage or setContentLoader is loaded
+     * here on first access and kept for later calls.
+     * 
      * @return Const reference to the note's content
+     * @throws std::runtime_error if bound content cannot be loaded
      */
     const std::string& getContent() const;
 
     /**
      * @brief Set the note content
      * 
+     * Other copies of this note keep the content they had.
+     * 
      * @param content The new content for the note
      */
     void setContent(const std::string& content);
 
+    /**
+     * @brief Set the note content, taking over the string without copying it
+     * 
+     * @param content The new content for the note
+     */
+    void setContent(std::string&& content);
+
+    /**
+     * @brief Get the shared content buffer, loading it first if needed
+     * 
+     * The buffer is never modified after it is set, so it can be held past
+     * later changes to the note.
+     * 
+     * @return The note's content buffer (never null)
+     * @throws std::runtime_error if bound content cannot be loaded
+     */
+    std::shared_ptr<const std::string> getContentBuffer() const;
+
+    /**
+     * @brief Share an existing content buffer with this note
+     * 
+     * @param content The buffer to use; null sets empty content
+     */
+    void setContentBuffer(std::shared_ptr<const std::string> content);
+
+    /**
+     * @brief Load the content from storage, at the note's path, when first read
+     * 
+     * Binding is not a modification: the update timestamp is left alone.
+     * 
+     * @param storage The storage holding the note content
+     * @throws std::runtime_error if storage is null
+     */
+    void bindContentStorage(std::shared_ptr<NoteStorage> storage);
+
+    /**
+     * @brief Load the content through a callback when first read
+     * 
+     * Meant for repositories whose listings leave the content out. Like
+     * bindContentStorage, this does not touch the update timestamp.
+     * 
+     * @param loader Returns the content; may throw std::runtime_error
+     */
+    void setContentLoader(LazyContent::Loader loader);
+
+    /**
+     * @brief Check whether the content is in memory
+     * 
+     * @return False if bound content has not been read yet
+     */
+    bool isContentLoaded() const;
+
     /**
      * @brief Get the creation timestamp
      * 
@@ -99,10 +183,22 @@ public:
      */
     const std::chrono::system_clock::time_point& getUpdatedAt() const;
 
+    /**
+     * @brief Restore stored timestamps, e.g. when decoding a note
+     * 
+     * Not a modification: marks nothing dirty.
+     * 
+     * @param createdAt The creation time
+     * @param updatedAt The last modification time
+     */
+    void setTimestamps(std::chrono::system_clock::time_point createdAt,
+                       std::chrono::system_clock::time_point updatedAt);
+
     /**
      * @brief Set an attribute with a specific type
      * 
-     * @tparam T The type of the attribute value
+     * @tparam T The type of the attribute value: a string, integer, floating-point,
+     *           bool, AttributeTimestamp or std::vector<std::string>
      * @param key The attribute key
      * @param value The attribute value
      */
@@ -147,43 +243,108 @@ public:
      */
     bool removeAttribute(const std::string& key);
 
+    /**
+     * @brief Get all attributes
+     * 
+     * @return Const reference to the note's attribute store
+     */
+    const AttributeStore& getAttributes() const;
+
+    /**
+     * @brief Open a scope that applies several changes as one modification
+     * 
+     * Setters called while the scope is open mark their fields dirty as
+     * usual, but the update timestamp is only set once, when the outermost
+     * scope ends. Example:
+     * 
+     *     Note::Edit edit = note.edit([&](const Note& n) { repository.update(n); });
+     *     note.setContent(text);
+     *     note.setAttribute("status", std::string("imported"));
+     *     edit.commit();
+     * 
+     * @param onCommit Called by commit() if the note has dirty fields; may be empty
+     * @return The scope; it must not outlive the note
+     */
+    Edit edit(CommitHandler onCommit = nullptr);
+
 private:
     void updateTimestamp();
 };
 
+/**
+ * @brief Batch of changes to a Note, see Note::edit()
+ * 
+ * commit() stamps the update time and, if the note has dirty fields, hands
+ * it to the commit handler and then clears them, since the handler has
+ * stored them. A scope that ends without commit() (e.g. because an exception
+ * is unwinding) still stamps the update time, as the changes stay applied,
+ * but does not call the handler. Only the outermost of nested scopes stamps
+ * the time and calls its handler.
+ */
+class Note::Edit {
+public:
+    Edit(Edit&& other) noexcept;
+    Edit(const Edit&) = delete;
+    Edit& operator=(const Edit&) = delete;
+    Edit& operator=(Edit&&) = delete;
+    ~Edit();
+
+    /**
+     * @brief End the scope and pass the changes on
+     * 
+     * If the handler throws, the note keeps its dirty fields and the scope
+     * stays ended.
+     * 
+     * @throws std::runtime_error if the scope has already ended, or whatever
+     *         the handler throws
+     */
+    void commit();
+
+    Note* operator->() { return note_; }
+    Note& operator*() { return *note_; }
+
+private:
+    friend class Note;
+    Edit(Note& note, CommitHandler onCommit);
+
+    // Close the scope; returns true if it was the outermost one
+    bool finish();
+
+    Note* note_;
+    CommitHandler onCommit_;
+};
+
 // Template implementations
 template<typename T>
 void Note::setAttribute(const std::string& key, const T& value) {
-    attributes[key] = value;
+    attributes.set(key, AttributeStore::toValue(value));
+    markDirty(EntityField::Attributes);
     updateTimestamp();
 }
 
 template<typename T>
 T Note::getAttribute(const std::string& key) const {
-    auto it = attributes.find(key);
-    if (it == attributes.end()) {
+    const AttributeValue* value = attributes.find(key);
+    if (!value) {
         throw std::runtime_error("Attribute not found: " + key);
     }
     
-    try {
-        return std::any_cast<T>(it->second);
-    } catch (const std::bad_any_cast&) {
+    std::optional<T> result = AttributeStore::fromValue<T>(*value);
+    if (!result) {
         throw std::runtime_error("Type mismatch for attribute: " + key);
     }
+    return std::move(*result);
 }
 
 template<typename T>
 T Note::getAttribute(const std::string& key, const T& defaultValue) const {
-    auto it = attributes.find(key);
-    if (it == attributes.end()) {
+    const AttributeValue* value = attributes.find(key);
+    if (!value) {
         return defaultValue;
     }
     
-    try {
-        return std::any_cast<T>(it->second);
-    } catch (const std::bad_any_cast&) {
-        return defaultValue;
-    }
+    std::optional<T> result = AttributeStore::fromValue<T>(*value);
+    return result ? std::move(*result) : defaultValue;
 }
 
 #endif // NOTE_H
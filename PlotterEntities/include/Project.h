@@ -2,6 +2,7 @@
 #define PROJECT_H
 
 #include "FileItem.h"
+#include "IndexedIdSet.h"
 #include <string>
 #include <vector>
 
@@ -15,7 +16,7 @@
 class Project : public FileItem {
 private:
     std::string description;
-    std::vector<std::string> folderIds; // IDs of top-level folders in this project
+    IndexedIdSet folderIds; // IDs of top-level folders in this project
 
 public:
     /**
@@ -25,7 +26,7 @@ public:
      * @param name The name of the project
      * @param description Description of the project's purpose
      */
-    Project(const std::string& id, const std::string& name, const std::string& description);
+    Project(std::string id, std::string name, std::string description);
 
     /**
      * @brief Get the description
@@ -46,14 +47,23 @@ public:
      * 
      * @return Const reference to the vector of folder IDs
      */
-    const std::vector<std::string>& getFolderIds() const;
+    const std::vector<EntityId>& getFolderIds() const;
 
     /**
      * @brief Add a folder ID to this project
      * 
      * @param folderId The ID of the folder to add
+     * @return True if the folder ID was added, false if it was already present
      */
-    void addFolderId(const std::string& folderId);
+    bool addFolderId(const EntityId& folderId);
+
+    /**
+     * @brief Check whether a folder is a top-level folder of this project
+     * 
+     * @param folderId The ID of the folder
+     * @return True if the folder ID is in this project
+     */
+    bool hasFolderId(const std::string& folderId) const;
 
     /**
      * @brief Remove a folder ID from this project
@@ -0,0 +1,155 @@
+#ifndef PROJECT_SNAPSHOT_H
+#define PROJECT_SNAPSHOT_H
+
+#include "EntityId.h"
+#include "Project.h"
+#include "Folder.h"
+#include "Note.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Read-only copy of a project hierarchy laid out for fast traversal
+ *
+ * Every node (the project, its folders and their notes) gets an index, and
+ * each property lives in its own array indexed by it. Nodes are numbered in
+ * depth-first pre-order, with the project at index 0, so:
+ *
+ * - iterating 0..size() is a depth-first walk;
+ * - the descendants of a node are the contiguous range (node, subtreeEnd(node));
+ * - ancestor checks are two comparisons, with no parent chasing.
+ *
+ * Names are stored back to back in one string, children of a node in one
+ * contiguous run of a shared index array. A snapshot does not change when
+ * the entities it was built from do.
+ */
+class ProjectSnapshot {
+public:
+    using Index = uint32_t;
+
+    /**
+     * @brief Index returned for a missing node, and the parent of the root
+     */
+    static constexpr Index NONE = UINT32_MAX;
+
+    enum class Kind : uint8_t {
+        Project,
+        Folder,
+        Note
+    };
+
+    /**
+     * @brief Contiguous run of node indices
+     */
+    struct IndexRange {
+        const Index* first;
+        const Index* last;
+
+        const Index* begin() const { return first; }
+        const Index* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    /**
+     * @brief Build a snapshot from a project and the entities below it
+     *
+     * The structure follows the child ID lists of the project and folders;
+     * subfolders come before notes, each in their stored order. IDs with no
+     * matching entity in the given lists are left out, as are other entities
+     * that are not reachable from the project. A folder reachable twice
+     * (corrupt data) is only included the first time.
+     *
+     * @param project The root of the snapshot
+     * @param folders Folders of the project, in any order
+     * @param notes Notes in those folders, in any order
+     */
+    ProjectSnapshot(const Project& project, const std::vector<Folder>& folders,
+                    const std::vector<Note>& notes);
+
+    /**
+     * @brief Get the number of nodes, the project included
+     */
+    size_t size() const { return kinds_.size(); }
+
+    size_t folderCount() const { return folderCount_; }
+    size_t noteCount() const { return noteCount_; }
+
+    /**
+     * @brief Find a node by entity ID
+     *
+     * @param id The entity ID
+     * @return The node index, or NONE if the ID is not in the snapshot
+     */
+    Index indexOf(const EntityId& id) const;
+
+    Kind kind(Index node) const { return kinds_[node]; }
+    const EntityId& id(Index node) const { return ids_[node]; }
+    Index parent(Index node) const { return parents_[node]; }
+    uint32_t depth(Index node) const { return depths_[node]; }
+
+    /**
+     * @brief Get the name of a node
+     *
+     * @return View into the snapshot's name storage, valid as long as the snapshot
+     */
+    std::string_view name(Index node) const {
+        return std::string_view(names_).substr(nameOffsets_[node], nameOffsets_[node + 1] - nameOffsets_[node]);
+    }
+
+    /**
+     * @brief Get the direct children of a node, subfolders first
+     */
+    IndexRange children(Index node) const {
+        return {children_.data() + childOffsets_[node], children_.data() + childOffsets_[node + 1]};
+    }
+
+    /**
+     * @brief Get the end of a node's subtree
+     *
+     * @return One past the last descendant; descendants are (node, subtreeEnd(node))
+     */
+    Index subtreeEnd(Index node) const { return subtreeEnds_[node]; }
+
+    /**
+     * @brief Check whether one node lies below another
+     *
+     * @param ancestor The possible ancestor
+     * @param node The possible descendant
+     * @return True if node is in ancestor's subtree and is not ancestor itself
+     */
+    bool isAncestor(Index ancestor, Index node) const {
+        return ancestor < node && node < subtreeEnds_[ancestor];
+    }
+
+    /**
+     * @brief Get the ancestors of a node, nearest first
+     */
+    std::vector<Index> ancestors(Index node) const;
+
+    /**
+     * @brief Get the nodes of a subtree in breadth-first order
+     *
+     * @param root The subtree root, which comes first
+     */
+    std::vector<Index> breadthFirst(Index root = 0) const;
+
+private:
+    std::vector<Kind> kinds_;
+    std::vector<EntityId> ids_;
+    std::vector<Index> parents_;
+    std::vector<uint32_t> depths_;
+    std::vector<Index> subtreeEnds_;
+    std::vector<uint32_t> childOffsets_;  // size() + 1 entries into children_
+    std::vector<Index> children_;
+    std::vector<uint32_t> nameOffsets_;   // size() + 1 entries into names_
+    std::string names_;
+    std::unordered_map<EntityId, Index> index_;
+    size_t folderCount_ = 0;
+    size_t noteCount_ = 0;
+};
+
+#endif // PROJECT_SNAPSHOT_H
@@ -0,0 +1,177 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Vector that keeps its first N elements inside the object
+ *
+ * Up to N elements need no heap allocation; beyond that the elements move to
+ * a single heap block that grows by half its size each time, which wastes
+ * less of the block than doubling for collections that stop growing after a
+ * few dozen elements. Meant for short per-entity collections.
+ *
+ * @tparam T Element type; must be nothrow move constructible
+ * @tparam N Number of elements stored inline
+ */
+template<typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs inline capacity");
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "SmallVector relocates elements by move and cannot roll back");
+
+private:
+    T* data_;
+    size_t size_;
+    size_t capacity_;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type inline_[N];
+
+    T* inlineData() {
+        return reinterpret_cast<T*>(inline_);
+    }
+
+    bool isInline() const {
+        return data_ == reinterpret_cast<const T*>(inline_);
+    }
+
+    void grow(size_t minimum) {
+        size_t capacity = capacity_ + capacity_ / 2 > minimum ? capacity_ + capacity_ / 2 : minimum;
+        T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        for (size_t i = 0; i < size_; i++) {
+            new (data + i) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        if (!isInline()) {
+            ::operator delete(data_);
+        }
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    void release() {
+        clear();
+        if (!isInline()) {
+            ::operator delete(data_);
+        }
+        data_ = inlineData();
+        capacity_ = N;
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() noexcept : data_(inlineData()), size_(0), capacity_(N) {}
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        reserve(other.size_);
+        for (const auto& item : other) {
+            push_back(item);
+        }
+    }
+
+    SmallVector(SmallVector&& other) noexcept : SmallVector() {
+        *this = std::move(other);
+    }
+
+    ~SmallVector() {
+        release();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            SmallVector copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+        release();
+        if (other.isInline()) {
+            for (size_t i = 0; i < other.size_; i++) {
+                new (data_ + i) T(std::move(other.data_[i]));
+            }
+            size_ = other.size_;
+            other.clear();
+        } else {
+            // Steal the heap block
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inlineData();
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+        return *this;
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            grow(capacity);
+        }
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            // Build first: args may refer to an element that grow() moves
+            T item(std::forward<Args>(args)...);
+            grow(size_ + 1);
+            new (data_ + size_) T(std::move(item));
+        } else {
+            new (data_ + size_) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void push_back(const T& item) {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item) {
+        emplace_back(std::move(item));
+    }
+
+    /**
+     * @brief Remove the element at index, keeping the order of the rest
+     */
+    void erase(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("SmallVector::erase index out of range");
+        }
+        for (size_t i = index + 1; i < size_; i++) {
+            data_[i - 1] = std::move(data_[i]);
+        }
+        data_[--size_].~T();
+    }
+
+    void clear() {
+        for (size_t i = 0; i < size_; i++) {
+            data_[i].~T();
+        }
+        size_ = 0;
+    }
+
+    T& operator[](size_t index) { return data_[index]; }
+    const T& operator[](size_t index) const { return data_[index]; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+};
+
+#endif // SMALL_VECTOR_H
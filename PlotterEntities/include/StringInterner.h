@@ -0,0 +1,182 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Process-wide pool that stores each distinct string once
+ *
+ * acquire() returns the pooled copy of a string, so two equal strings always
+ * yield the same entry and can be compared by address. Entries are reference
+ * counted and leave the pool when their last reference is released, so a
+ * long-running process only keeps the strings it still uses. Hold them
+ * through InternedString rather than calling acquire() and release() by hand.
+ *
+ * Only strings that are referenced over and over belong here: parent and
+ * child IDs, attribute keys. An entity's own ID is unique to it and stays a
+ * plain string.
+ *
+ * The pool is split into shards by hash, each behind its own reader/writer
+ * lock; looking up a string that is already pooled takes only a shared lock,
+ * and dropping a reference that is not the last one takes no lock at all.
+ */
+class StringInterner {
+public:
+    /**
+     * @brief One pooled string
+     */
+    struct Entry {
+        std::string value;
+        size_t hash;
+        mutable std::atomic<size_t> references;
+    };
+
+    /**
+     * @brief Get the process-wide interner
+     *
+     * @return Reference to the singleton instance
+     */
+    static StringInterner& instance();
+
+    /**
+     * @brief Get the pooled copy of a string, adding it if needed
+     *
+     * @param value The string to intern
+     * @param hash std::hash<std::string> of value
+     * @return The pooled entry, with one reference taken for the caller
+     */
+    const Entry* acquire(const std::string& value, size_t hash);
+
+    /**
+     * @brief Get the pooled copy of a string only if it is already pooled
+     *
+     * For lookups: a string nobody holds cannot match anything, so there is
+     * no point adding it.
+     *
+     * @param value The string to look up
+     * @param hash std::hash<std::string> of value
+     * @return The pooled entry with one reference taken, or nullptr
+     */
+    const Entry* acquireExisting(const std::string& value, size_t hash);
+
+    /**
+     * @brief Take another reference to an entry the caller already holds
+     */
+    static void retain(const Entry* entry) noexcept {
+        entry->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Drop a reference, removing the entry from the pool with the last one
+     */
+    void release(const Entry* entry) noexcept;
+
+    /**
+     * @brief Get the number of distinct strings pooled
+     *
+     * @return Number of pooled strings
+     */
+    size_t size() const;
+
+private:
+    StringInterner() = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        // Keys view the value of the entry they map to; entries never move
+        std::unordered_map<std::string_view, std::unique_ptr<Entry>> strings;
+    };
+
+    Shard shards_[SHARD_COUNT];
+};
+
+/**
+ * @brief Owning handle to a string in the StringInterner
+ *
+ * Copying takes another reference and destroying gives it back. Two handles
+ * to equal strings point at the same pooled copy, so they compare by address.
+ * A default-constructed handle refers to nothing.
+ */
+class InternedString {
+public:
+    InternedString() noexcept = default;
+
+    /**
+     * @brief Intern a string
+     *
+     * @param value The string to intern
+     * @param hash std::hash<std::string> of value
+     */
+    InternedString(const std::string& value, size_t hash)
+        : entry_(StringInterner::instance().acquire(value, hash)) {}
+
+    /**
+     * @brief Handle to a string only if it is already pooled
+     *
+     * @return The handle, or an empty one if no other handle holds the string
+     */
+    static InternedString existing(const std::string& value, size_t hash) {
+        return InternedString(StringInterner::instance().acquireExisting(value, hash));
+    }
+
+    InternedString(const InternedString& other) noexcept : entry_(other.entry_) {
+        if (entry_) {
+            StringInterner::retain(entry_);
+        }
+    }
+
+    InternedString(InternedString&& other) noexcept : entry_(other.entry_) {
+        other.entry_ = nullptr;
+    }
+
+    InternedString& operator=(InternedString other) noexcept {
+        std::swap(entry_, other.entry_);
+        return *this;
+    }
+
+    ~InternedString() {
+        if (entry_) {
+            StringInterner::instance().release(entry_);
+        }
+    }
+
+    /**
+     * @brief Get the pooled string
+     *
+     * @return Pointer to the pooled string, valid while this handle (or a copy) lives;
+     *         nullptr for an empty handle
+     */
+    const std::string* get() const noexcept {
+        return entry_ ? &entry_->value : nullptr;
+    }
+
+    const std::string& operator*() const noexcept {
+        return entry_->value;
+    }
+
+    friend bool operator==(const InternedString& a, const InternedString& b) noexcept {
+        return a.entry_ == b.entry_;
+    }
+
+    friend bool operator!=(const InternedString& a, const InternedString& b) noexcept {
+        return a.entry_ != b.entry_;
+    }
+
+private:
+    explicit InternedString(const StringInterner::Entry* entry) noexcept : entry_(entry) {}
+
+    const StringInterner::Entry* entry_ = nullptr;
+};
+
+#endif // STRING_INTERNER_H
@@ -0,0 +1,37 @@
+#include "AttributeStore.h"
+#include <functional>
+
+const AttributeStore::Entry* AttributeStore::findEntry(const std::string& key) const {
+    for (const auto& entry : entries_) {
+        if (*entry.key == key) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void AttributeStore::set(const std::string& key, AttributeValue value) {
+    if (const Entry* existing = findEntry(key)) {
+        const_cast<Entry*>(existing)->value = std::move(value);
+        return;
+    }
+    entries_.push_back(Entry{InternedString(key, std::hash<std::string>()(key)), std::move(value)});
+}
+
+const AttributeValue* AttributeStore::find(const std::string& key) const {
+    const Entry* entry = findEntry(key);
+    return entry ? &entry->value : nullptr;
+}
+
+bool AttributeStore::contains(const std::string& key) const {
+    return find(key) != nullptr;
+}
+
+bool AttributeStore::remove(const std::string& key) {
+    const Entry* entry = findEntry(key);
+    if (!entry) {
+        return false;
+    }
+    entries_.erase(static_cast<size_t>(entry - entries_.begin()));
+    return true;
+}
@@ -0,0 +1,423 @@
+#include "EntityCodec.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// ---- Encoding -------------------------------------------------------------
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putSigned(std::string& out, int64_t value) {
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void putString(std::string& out, std::string_view value) {
+    putVarint(out, value.size());
+    out.append(value.data(), value.size());
+}
+
+template<typename List>
+void putList(std::string& out, const List& values) {
+    putVarint(out, values.size());
+    for (const auto& value : values) {
+        putString(out, static_cast<const std::string&>(value));
+    }
+}
+
+void putReal(std::string& out, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int shift = 0; shift < 64; shift += 8) {
+        out.push_back(static_cast<char>(bits >> shift));
+    }
+}
+
+int64_t toNanoseconds(const AttributeTimestamp& time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+AttributeTimestamp fromNanoseconds(int64_t nanoseconds) {
+    return AttributeTimestamp(std::chrono::duration_cast<AttributeTimestamp::duration>(
+        std::chrono::nanoseconds(nanoseconds)));
+}
+
+// Writes the header with a placeholder length, to be patched by endRecord
+size_t beginRecord(std::string& out, EntityCodec::Kind kind) {
+    out.push_back(static_cast<char>(EntityCodec::VERSION));
+    out.push_back(static_cast<char>(kind));
+    out.append(4, '\0');
+    return out.size();
+}
+
+void endRecord(std::string& out, size_t payloadStart) {
+    size_t length = out.size() - payloadStart;
+    if (length > UINT32_MAX) {
+        throw std::runtime_error("Entity too large to encode: " + std::to_string(length) + " bytes");
+    }
+    for (int i = 0; i < 4; i++) {
+        out[payloadStart - 4 + i] = static_cast<char>(length >> (8 * i));
+    }
+}
+
+// ---- Decoding -------------------------------------------------------------
+
+// Reads the payload format. Bounds are checked while a record is validated;
+// views re-read validated bytes without an end (end_ == nullptr).
+class Reader {
+public:
+    Reader(const char* data, size_t size) : position_(data), end_(data + size) {}
+    explicit Reader(const char* data) : position_(data), end_(nullptr) {}
+
+    const char* position() const { return position_; }
+
+    uint8_t byte() {
+        require(1);
+        return static_cast<uint8_t>(*position_++);
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t next = byte();
+            if (shift == 63 && next > 1) {
+                break;
+            }
+            value |= static_cast<uint64_t>(next & 0x7f) << shift;
+            if (!(next & 0x80)) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Malformed entity record: varint overflow");
+    }
+
+    int64_t signedVarint() {
+        uint64_t value = varint();
+        return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    double real() {
+        require(8);
+        uint64_t bits = 0;
+        for (int shift = 0; shift < 64; shift += 8) {
+            bits |= static_cast<uint64_t>(static_cast<uint8_t>(*position_++)) << shift;
+        }
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string_view string() {
+        uint64_t size = varint();
+        require(size);
+        std::string_view value(position_, static_cast<size_t>(size));
+        position_ += size;
+        return value;
+    }
+
+    // Element count; every element takes at least one byte, which bounds it
+    size_t count() {
+        uint64_t count = varint();
+        require(count);
+        return static_cast<size_t>(count);
+    }
+
+    EntityCodec::StringListView stringList() {
+        size_t size = count();
+        const char* start = position_;
+        for (size_t i = 0; i < size; i++) {
+            string();
+        }
+        return EntityCodec::StringListView(start, size);
+    }
+
+    EntityCodec::AttributeView attribute() {
+        EntityCodec::AttributeView attribute;
+        attribute.key = string();
+        uint8_t kind = byte();
+        attribute.kind = static_cast<AttributeStore::Kind>(kind);
+        switch (attribute.kind) {
+            case AttributeStore::Kind::String:
+                attribute.text = string();
+                break;
+            case AttributeStore::Kind::Integer:
+            case AttributeStore::Kind::Timestamp:
+                attribute.integer = signedVarint();
+                break;
+            case AttributeStore::Kind::Real:
+                attribute.real = real();
+                break;
+            case AttributeStore::Kind::Boolean: {
+                uint8_t value = byte();
+                if (value > 1) {
+                    throw std::runtime_error("Malformed entity record: invalid boolean");
+                }
+                attribute.boolean = value == 1;
+                break;
+            }
+            case AttributeStore::Kind::StringList:
+                attribute.list = stringList();
+                break;
+            default:
+                throw std::runtime_error("Malformed entity record: unknown attribute kind " +
+                                         std::to_string(kind));
+        }
+        return attribute;
+    }
+
+private:
+    void require(uint64_t bytes) {
+        if (end_ && bytes > static_cast<uint64_t>(end_ - position_)) {
+            throw std::runtime_error("Malformed entity record: truncated payload");
+        }
+    }
+
+    const char* position_;
+    const char* end_;
+};
+
+std::string copy(std::string_view value) {
+    return std::string(value);
+}
+
+Reader payloadReader(const EntityCodec::Record& record, EntityCodec::Kind expected) {
+    if (record.kind != expected) {
+        throw std::runtime_error("Entity record holds another kind of entity");
+    }
+    return Reader(record.payload.data(), record.payload.size());
+}
+
+} // namespace
+
+// ---- Views ----------------------------------------------------------------
+
+std::string_view EntityCodec::StringListView::iterator::operator*() const {
+    return Reader(position_).string();
+}
+
+EntityCodec::StringListView::iterator& EntityCodec::StringListView::iterator::operator++() {
+    Reader reader(position_);
+    reader.string();
+    position_ = reader.position();
+    remaining_--;
+    return *this;
+}
+
+EntityCodec::AttributeView EntityCodec::AttributeListView::iterator::operator*() const {
+    return Reader(position_).attribute();
+}
+
+EntityCodec::AttributeListView::iterator& EntityCodec::AttributeListView::iterator::operator++() {
+    Reader reader(position_);
+    reader.attribute();
+    position_ = reader.position();
+    remaining_--;
+    return *this;
+}
+
+AttributeValue EntityCodec::AttributeView::toValue() const {
+    switch (kind) {
+        case AttributeStore::Kind::String:
+            return AttributeValue(std::in_place_type<std::string>, text);
+        case AttributeStore::Kind::Integer:
+            return AttributeValue(std::in_place_type<int64_t>, integer);
+        case AttributeStore::Kind::Real:
+            return AttributeValue(std::in_place_type<double>, real);
+        case AttributeStore::Kind::Boolean:
+            return AttributeValue(std::in_place_type<bool>, boolean);
+        case AttributeStore::Kind::Timestamp:
+            return AttributeValue(std::in_place_type<AttributeTimestamp>, fromNanoseconds(integer));
+        case AttributeStore::Kind::StringList: {
+            std::vector<std::string> values;
+            values.reserve(list.size());
+            for (std::string_view value : list) {
+                values.emplace_back(value);
+            }
+            return AttributeValue(std::in_place_type<std::vector<std::string>>, std::move(values));
+        }
+    }
+    throw std::runtime_error("Unknown attribute kind");
+}
+
+Project EntityCodec::ProjectView::toEntity() const {
+    Project project(copy(id), copy(name), copy(description));
+    for (std::string_view folderId : folderIds) {
+        project.addFolderId(EntityId(copy(folderId)));
+    }
+    return project;
+}
+
+Folder EntityCodec::FolderView::toEntity() const {
+    Folder folder(copy(id), copy(name), copy(description),
+                  copy(parentProjectId), copy(parentFolderId));
+    for (std::string_view noteId : noteIds) {
+        folder.addNoteId(EntityId(copy(noteId)));
+    }
+    for (std::string_view subfolderId : subfolderIds) {
+        folder.addSubfolderId(EntityId(copy(subfolderId)));
+    }
+    return folder;
+}
+
+Note EntityCodec::NoteView::toEntity() const {
+    Note note(copy(id), copy(name), copy(path), copy(parentFolderId));
+    note.setContent(copy(content));
+    for (const AttributeView& attribute : attributes) {
+        std::string key(attribute.key);
+        std::visit([&note, &key](const auto& value) { note.setAttribute(key, value); }, attribute.toValue());
+    }
+    // Last, since the setters above stamp the update time
+    note.setTimestamps(createdAt, updatedAt);
+    return note;
+}
+
+// ---- Encoding -------------------------------------------------------------
+
+void EntityCodec::encode(const Project& project, std::string& out) {
+    size_t payload = beginRecord(out, Kind::Project);
+    putString(out, project.getId());
+    putString(out, project.getName());
+    putString(out, project.getDescription());
+    putList(out, project.getFolderIds());
+    endRecord(out, payload);
+}
+
+void EntityCodec::encode(const Folder& folder, std::string& out) {
+    size_t payload = beginRecord(out, Kind::Folder);
+    putString(out, folder.getId());
+    putString(out, folder.getName());
+    putString(out, folder.getDescription());
+    putString(out, folder.getParentProjectId());
+    putString(out, folder.getParentFolderId());
+    putList(out, folder.getNoteIds());
+    putList(out, folder.getSubfolderIds());
+    endRecord(out, payload);
+}
+
+void EntityCodec::encode(const Note& note, std::string& out) {
+    const std::string& content = note.getContent();
+    out.reserve(out.size() + HEADER_SIZE + content.size() + 128);
+
+    size_t payload = beginRecord(out, Kind::Note);
+    putString(out, note.getId());
+    putString(out, note.getName());
+    putString(out, note.getPath());
+    putString(out, note.getParentFolderId());
+    putSigned(out, toNanoseconds(note.getCreatedAt()));
+    putSigned(out, toNanoseconds(note.getUpdatedAt()));
+    putString(out, content);
+
+    const AttributeStore& attributes = note.getAttributes();
+    putVarint(out, attributes.size());
+    for (const AttributeStore::Entry& entry : attributes) {
+        putString(out, *entry.key);
+        out.push_back(static_cast<char>(AttributeStore::kindOf(entry.value)));
+        std::visit([&out](const auto& value) {
+            using Type = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same<Type, std::string>::value) {
+                putString(out, value);
+            } else if constexpr (std::is_same<Type, bool>::value) {
+                out.push_back(value ? 1 : 0);
+            } else if constexpr (std::is_same<Type, int64_t>::value) {
+                putSigned(out, value);
+            } else if constexpr (std::is_same<Type, double>::value) {
+                putReal(out, value);
+            } else if constexpr (std::is_same<Type, AttributeTimestamp>::value) {
+                putSigned(out, toNanoseconds(value));
+            } else {
+                putList(out, value);
+            }
+        }, entry.value);
+    }
+    endRecord(out, payload);
+}
+
+// ---- Decoding -------------------------------------------------------------
+
+EntityCodec::Record EntityCodec::readRecord(std::string_view& input) {
+    if (input.size() < HEADER_SIZE) {
+        throw std::runtime_error("Malformed entity record: truncated header");
+    }
+    Record record;
+    record.version = static_cast<uint8_t>(input[0]);
+    if (record.version == 0 || record.version > VERSION) {
+        throw std::runtime_error("Unsupported entity record version " + std::to_string(record.version));
+    }
+    uint8_t kind = static_cast<uint8_t>(input[1]);
+    if (kind < static_cast<uint8_t>(Kind::Project) || kind > static_cast<uint8_t>(Kind::Note)) {
+        throw std::runtime_error("Malformed entity record: unknown kind " + std::to_string(kind));
+    }
+    record.kind = static_cast<Kind>(kind);
+
+    uint32_t length = 0;
+    for (int i = 0; i < 4; i++) {
+        length |= static_cast<uint32_t>(static_cast<uint8_t>(input[2 + i])) << (8 * i);
+    }
+    if (length > input.size() - HEADER_SIZE) {
+        throw std::runtime_error("Malformed entity record: truncated payload");
+    }
+    record.payload = input.substr(HEADER_SIZE, length);
+    input.remove_prefix(HEADER_SIZE + length);
+    return record;
+}
+
+EntityCodec::ProjectView EntityCodec::decodeProject(std::string_view record) {
+    return decodeProject(readRecord(record));
+}
+
+EntityCodec::ProjectView EntityCodec::decodeProject(const Record& record) {
+    Reader reader = payloadReader(record, Kind::Project);
+    ProjectView view;
+    view.id = reader.string();
+    view.name = reader.string();
+    view.description = reader.string();
+    view.folderIds = reader.stringList();
+    return view;
+}
+
+EntityCodec::FolderView EntityCodec::decodeFolder(std::string_view record) {
+    return decodeFolder(readRecord(record));
+}
+
+EntityCodec::FolderView EntityCodec::decodeFolder(const Record& record) {
+    Reader reader = payloadReader(record, Kind::Folder);
+    FolderView view;
+    view.id = reader.string();
+    view.name = reader.string();
+    view.description = reader.string();
+    view.parentProjectId = reader.string();
+    view.parentFolderId = reader.string();
+    view.noteIds = reader.stringList();
+    view.subfolderIds = reader.stringList();
+    return view;
+}
+
+EntityCodec::NoteView EntityCodec::decodeNote(std::string_view record) {
+    return decodeNote(readRecord(record));
+}
+
+EntityCodec::NoteView EntityCodec::decodeNote(const Record& record) {
+    Reader reader = payloadReader(record, Kind::Note);
+    NoteView view;
+    view.id = reader.string();
+    view.name = reader.string();
+    view.path = reader.string();
+    view.parentFolderId = reader.string();
+    view.createdAt = fromNanoseconds(reader.signedVarint());
+    view.updatedAt = fromNanoseconds(reader.signedVarint());
+    view.content = reader.string();
+
+    size_t count = reader.count();
+    const char* start = reader.position();
+    for (size_t i = 0; i < count; i++) {
+        reader.attribute();
+    }
+    view.attributes = AttributeListView(start, count);
+    return view;
+}
@@ -1,14 +1,19 @@
 #include "FileItem.h"
+#include <utility>
 
 // Constructor
-FileItem::FileItem(const std::string& id, const std::string& name, const std::string& type)
-    : id(id), name(name), type(type) {}
+FileItem::FileItem(std::string id, std::string name, std::string type)
+    : id(std::move(id)), name(std::move(name)), type(std::move(type)), dirtyFields(FieldMask::all()) {}
 
 // Getters
 const std::string& FileItem::getId() const {
     return id;
 }
 
+EntityId FileItem::getEntityId() const {
+    return EntityId(id);
+}
+
 const std::string& FileItem::getName() const {
     return name;
 }
@@ -20,8 +25,26 @@ const std::string& FileItem::getType() const {
 // Setters
 void FileItem::setName(const std::string& name) {
     this->name = name;
+    markDirty(EntityField::Name);
 }
 
 void FileItem::setType(const std::string& type) {
     this->type = type;
 }
+
+// Change tracking
+FieldMask FileItem::getDirtyFields() const {
+    return dirtyFields;
+}
+
+bool FileItem::isDirty(EntityField field) const {
+    return dirtyFields.has(field);
+}
+
+void FileItem::clearDirtyFields() {
+    dirtyFields = FieldMask();
+}
+
+void FileItem::markDirty(EntityField field) {
+    dirtyFields |= field;
+}
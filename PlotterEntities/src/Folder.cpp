@@ -1,11 +1,11 @@
 #include "Folder.h"
-#include <algorithm>
+#include <utility>
 
 // Constructor
-Folder::Folder(const std::string& id, const std::string& name, const std::string& description,
-               const std::string& parentProjectId, const std::string& parentFolderId)
-    : FileItem(id, name, "folder"),
-      description(description),
+Folder::Folder(std::string id, std::string name, std::string description,
+               const EntityId& parentProjectId, const EntityId& parentFolderId)
+    : FileItem(std::move(id), std::move(name), "folder"),
+      description(std::move(description)),
       parentProjectId(parentProjectId),
       parentFolderId(parentFolderId) {}
 
@@ -15,58 +15,68 @@ const std::string& Folder::getDescription() const {
 }
 
 const std::string& Folder::getParentProjectId() const {
-    return parentProjectId;
+    return parentProjectId.str();
 }
 
 const std::string& Folder::getParentFolderId() const {
-    return parentFolderId;
+    return parentFolderId.str();
 }
 
-const std::vector<std::string>& Folder::getNoteIds() const {
-    return noteIds;
+const std::vector<EntityId>& Folder::getNoteIds() const {
+    return noteIds.items();
 }
 
-const std::vector<std::string>& Folder::getSubfolderIds() const {
-    return subfolderIds;
+const std::vector<EntityId>& Folder::getSubfolderIds() const {
+    return subfolderIds.items();
 }
 
 // Setters
 void Folder::setDescription(const std::string& description) {
     this->description = description;
+    markDirty(EntityField::Description);
 }
 
-void Folder::setParentProjectId(const std::string& parentProjectId) {
+void Folder::setParentProjectId(const EntityId& parentProjectId) {
     this->parentProjectId = parentProjectId;
+    markDirty(EntityField::ParentProject);
 }
 
-void Folder::setParentFolderId(const std::string& parentFolderId) {
+void Folder::setParentFolderId(const EntityId& parentFolderId) {
     this->parentFolderId = parentFolderId;
+    markDirty(EntityField::ParentFolder);
 }
 
 // Note ID management
-void Folder::addNoteId(const std::string& noteId) {
-    noteIds.push_back(noteId);
+bool Folder::addNoteId(const EntityId& noteId) {
+    return markChildrenDirty(noteIds.insert(noteId));
 }
 
+// Queries look the ID up without interning it: an ID nobody holds is in no set
 bool Folder::removeNoteId(const std::string& noteId) {
-    auto it = std::find(noteIds.begin(), noteIds.end(), noteId);
-    if (it != noteIds.end()) {
-        noteIds.erase(it);
-        return true;
-    }
-    return false;
+    return markChildrenDirty(noteIds.erase(EntityId::find(noteId)));
+}
+
+bool Folder::hasNoteId(const std::string& noteId) const {
+    return noteIds.contains(EntityId::find(noteId));
 }
 
 // Subfolder ID management
-void Folder::addSubfolderId(const std::string& subfolderId) {
-    subfolderIds.push_back(subfolderId);
+bool Folder::addSubfolderId(const EntityId& subfolderId) {
+    return markChildrenDirty(subfolderIds.insert(subfolderId));
 }
 
 bool Folder::removeSubfolderId(const std::string& subfolderId) {
-    auto it = std::find(subfolderIds.begin(), subfolderIds.end(), subfolderId);
-    if (it != subfolderIds.end()) {
-        subfolderIds.erase(it);
-        return true;
+    return markChildrenDirty(subfolderIds.erase(EntityId::find(subfolderId)));
+}
+
+bool Folder::hasSubfolderId(const std::string& subfolderId) const {
+    return subfolderIds.contains(EntityId::find(subfolderId));
+}
+
+// Private methods
+bool Folder::markChildrenDirty(bool changed) {
+    if (changed) {
+        markDirty(EntityField::Children);
     }
-    return false;
+    return changed;
 }
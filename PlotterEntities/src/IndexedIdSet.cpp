@@ -0,0 +1,69 @@
+#include "IndexedIdSet.h"
+
+bool IndexedIdSet::insert(const EntityId& id) {
+    if (id.empty() || index_.count(id) > 0) {
+        return false;
+    }
+
+    // Keep the vector from filling up with tombstones when nobody reads it
+    if (tombstones_ > index_.size()) {
+        compact();
+    }
+
+    index_.emplace(id, items_.size());
+    items_.push_back(id);
+    return true;
+}
+
+bool IndexedIdSet::erase(const EntityId& id) {
+    auto it = index_.find(id);
+    if (it == index_.end()) {
+        return false;
+    }
+
+    items_[it->second] = EntityId();
+    index_.erase(it);
+    tombstones_++;
+    return true;
+}
+
+bool IndexedIdSet::contains(const EntityId& id) const {
+    return index_.count(id) > 0;
+}
+
+const std::vector<EntityId>& IndexedIdSet::items() const {
+    if (tombstones_ > 0) {
+        compact();
+    }
+    return items_;
+}
+
+size_t IndexedIdSet::size() const {
+    return index_.size();
+}
+
+bool IndexedIdSet::empty() const {
+    return index_.empty();
+}
+
+void IndexedIdSet::clear() {
+    items_.clear();
+    index_.clear();
+    tombstones_ = 0;
+}
+
+void IndexedIdSet::compact() const {
+    size_t live = 0;
+    for (size_t i = 0; i < items_.size(); i++) {
+        if (items_[i].empty()) {
+            continue;
+        }
+        if (live != i) {
+            items_[live] = items_[i];
+            index_[items_[live]] = live;
+        }
+        live++;
+    }
+    items_.resize(live);
+    tombstones_ = 0;
+}
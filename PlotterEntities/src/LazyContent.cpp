@@ -0,0 +1,40 @@
+#include "LazyContent.h"
+
+namespace {
+
+// Shared by every handle without content, so empty content allocates nothing
+const std::shared_ptr<const std::string>& emptyContent() {
+    static const std::shared_ptr<const std::string> empty = std::make_shared<const std::string>();
+    return empty;
+}
+
+} // namespace
+
+LazyContent::LazyContent() : buffer_(emptyContent()) {}
+
+LazyContent::LazyContent(std::shared_ptr<const std::string> buffer)
+    : buffer_(buffer && !buffer->empty() ? std::move(buffer) : emptyContent()) {}
+
+LazyContent::LazyContent(Loader loader) : pending_(std::make_shared<Pending>()) {
+    pending_->loader = std::move(loader);
+}
+
+const std::shared_ptr<const std::string>& LazyContent::get() const {
+    if (!pending_) {
+        return buffer_;
+    }
+
+    Pending& pending = *pending_;
+    std::call_once(pending.once, [&pending]() {
+        std::string content = pending.loader ? pending.loader() : std::string();
+        pending.buffer = content.empty() ? emptyContent()
+                                         : std::make_shared<const std::string>(std::move(content));
+        pending.loader = nullptr;   // Release whatever the loader captured
+        pending.loaded.store(true, std::memory_order_release);
+    });
+    return pending.buffer;
+}
+
+bool LazyContent::isLoaded() const {
+    return !pending_ || pending_->loaded.load(std::memory_order_acquire);
+}
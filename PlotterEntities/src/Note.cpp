@@ -1,14 +1,14 @@
 #include "Note.h"
 #include <algorithm>
 #include <iomanip>
+#include <utility>
 #include <vector>
 
 // Constructor
-Note::Note(const std::string& id, const std::string& name, const std::string& path,
-           const std::string& parentFolderId)
-    : FileItem(id, name, "note"),
-      path(path),
-      content(""),
+Note::Note(std::string id, std::string name, std::string path,
+           const EntityId& parentFolderId)
+    : FileItem(std::move(id), std::move(name), "note"),
+      path(std::move(path)),
       parentFolderId(parentFolderId),
       createdAt(std::chrono::system_clock::now()), 
       updatedAt(std::chrono::system_clock::now()) {}
@@ -19,11 +19,19 @@ const std::string& Note::getPath() const {
 }
 
 const std::string& Note::getParentFolderId() const {
-    return parentFolderId;
+    return parentFolderId.str();
 }
 
 const std::string& Note::getContent() const {
-    return content;
+    return *content.get();
+}
+
+std::shared_ptr<const std::string> Note::getContentBuffer() const {
+    return content.get();
+}
+
+bool Note::isContentLoaded() const {
+    return content.isLoaded();
 }
 
 const std::chrono::system_clock::time_point& Note::getCreatedAt() const {
@@ -35,37 +43,123 @@ const std::chrono::system_clock::time_point& Note::getUpdatedAt() const {
 }
 
 // Setters
+void Note::setTimestamps(std::chrono::system_clock::time_point createdAt,
+                         std::chrono::system_clock::time_point updatedAt) {
+    this->createdAt = createdAt;
+    this->updatedAt = updatedAt;
+}
+
 void Note::setPath(const std::string& path) {
     this->path = path;
+    markDirty(EntityField::Path);
     updateTimestamp();
 }
 
-void Note::setParentFolderId(const std::string& parentFolderId) {
+void Note::setParentFolderId(const EntityId& parentFolderId) {
     this->parentFolderId = parentFolderId;
+    markDirty(EntityField::ParentFolder);
     updateTimestamp();
 }
 
 void Note::setContent(const std::string& content) {
-    this->content = content;
+    this->content = content.empty() ? LazyContent() : LazyContent(std::make_shared<const std::string>(content));
+    markDirty(EntityField::Content);
     updateTimestamp();
 }
 
+void Note::setContent(std::string&& content) {
+    this->content = content.empty() ? LazyContent()
+                                    : LazyContent(std::make_shared<const std::string>(std::move(content)));
+    markDirty(EntityField::Content);
+    updateTimestamp();
+}
+
+void Note::setContentBuffer(std::shared_ptr<const std::string> content) {
+    this->content = LazyContent(std::move(content));
+    markDirty(EntityField::Content);
+    updateTimestamp();
+}
+
+void Note::bindContentStorage(std::shared_ptr<NoteStorage> storage) {
+    if (!storage) {
+        throw std::runtime_error("Cannot bind note content to null storage");
+    }
+    std::string path = this->path;
+    content = LazyContent([storage, path]() { return storage->loadNote(path); });
+}
+
+void Note::setContentLoader(LazyContent::Loader loader) {
+    content = LazyContent(std::move(loader));
+}
+
 // Attribute management
 bool Note::hasAttribute(const std::string& key) const {
-    return attributes.find(key) != attributes.end();
+    return attributes.contains(key);
 }
 
 bool Note::removeAttribute(const std::string& key) {
-    auto it = attributes.find(key);
-    if (it != attributes.end()) {
-        attributes.erase(it);
+    if (attributes.remove(key)) {
+        markDirty(EntityField::Attributes);
         updateTimestamp();
         return true;
     }
     return false;
 }
 
+const AttributeStore& Note::getAttributes() const {
+    return attributes;
+}
+
+// Batched edits
+Note::Edit Note::edit(CommitHandler onCommit) {
+    return Edit(*this, std::move(onCommit));
+}
+
+Note::Edit::Edit(Note& note, CommitHandler onCommit)
+    : note_(&note), onCommit_(std::move(onCommit)) {
+    note_->batch.depth++;
+}
+
+Note::Edit::Edit(Edit&& other) noexcept
+    : note_(other.note_), onCommit_(std::move(other.onCommit_)) {
+    other.note_ = nullptr;
+}
+
+Note::Edit::~Edit() {
+    if (note_) {
+        finish();
+    }
+}
+
+void Note::Edit::commit() {
+    if (!note_) {
+        throw std::runtime_error("Note edit has already been committed");
+    }
+    Note& note = *note_;
+    if (finish() && onCommit_ && !note.getDirtyFields().empty()) {
+        onCommit_(note);
+        note.clearDirtyFields();
+    }
+}
+
+bool Note::Edit::finish() {
+    Note& note = *note_;
+    note_ = nullptr;
+    if (--note.batch.depth > 0) {
+        return false;
+    }
+    if (note.batch.changed) {
+        note.batch.changed = false;
+        note.updatedAt = std::chrono::system_clock::now();
+    }
+    return true;
+}
+
 // Private methods
 void Note::updateTimestamp() {
+    if (batch.depth > 0) {
+        batch.changed = true;
+        return;
+    }
     updatedAt = std::chrono::system_clock::now();
 }
@@ -1,35 +1,43 @@
 #include "Project.h"
-#include <algorithm>
+#include <utility>
 
 // Constructor
-Project::Project(const std::string& id, const std::string& name, const std::string& description)
-    : FileItem(id, name, "project"),
-      description(description) {}
+Project::Project(std::string id, std::string name, std::string description)
+    : FileItem(std::move(id), std::move(name), "project"),
+      description(std::move(description)) {}
 
 // Getters
 const std::string& Project::getDescription() const {
     return description;
 }
 
-const std::vector<std::string>& Project::getFolderIds() const {
-    return folderIds;
+const std::vector<EntityId>& Project::getFolderIds() const {
+    return folderIds.items();
 }
 
 // Setters
 void Project::setDescription(const std::string& description) {
     this->description = description;
+    markDirty(EntityField::Description);
 }
 
 // Folder ID management
-void Project::addFolderId(const std::string& folderId) {
-    folderIds.push_back(folderId);
+bool Project::addFolderId(const EntityId& folderId) {
+    if (!folderIds.insert(folderId)) {
+        return false;
+    }
+    markDirty(EntityField::Children);
+    return true;
 }
 
 bool Project::removeFolderId(const std::string& folderId) {
-    auto it = std::find(folderIds.begin(), folderIds.end(), folderId);
-    if (it != folderIds.end()) {
-        folderIds.erase(it);
-        return true;
+    if (!folderIds.erase(EntityId::find(folderId))) {
+        return false;
     }
-    return false;
+    markDirty(EntityField::Children);
+    return true;
+}
+
+bool Project::hasFolderId(const std::string& folderId) const {
+    return folderIds.contains(EntityId::find(folderId));
 }
@@ -0,0 +1,147 @@
+#include "ProjectSnapshot.h"
+#include <algorithm>
+
+ProjectSnapshot::ProjectSnapshot(const Project& project, const std::vector<Folder>& folders,
+                                 const std::vector<Note>& notes) {
+    // Entities are taken out of these maps as they are placed, so an ID
+    // listed twice (or a folder cycle) is only visited once
+    std::unordered_map<EntityId, const Folder*> pendingFolders;
+    std::unordered_map<EntityId, const Note*> pendingNotes;
+    pendingFolders.reserve(folders.size());
+    pendingNotes.reserve(notes.size());
+    for (const Folder& folder : folders) {
+        pendingFolders.emplace(folder.getEntityId(), &folder);
+    }
+    for (const Note& note : notes) {
+        pendingNotes.emplace(note.getEntityId(), &note);
+    }
+
+    size_t expected = 1 + folders.size() + notes.size();
+    kinds_.reserve(expected);
+    ids_.reserve(expected);
+    parents_.reserve(expected);
+    depths_.reserve(expected);
+    nameOffsets_.reserve(expected + 1);
+    nameOffsets_.push_back(0);
+
+    struct Visit {
+        const FileItem* item;
+        Kind kind;
+        Index parent;
+        uint32_t depth;
+    };
+    std::vector<Visit> stack;
+    stack.push_back({&project, Kind::Project, NONE, 0});
+
+    auto takeFolder = [&pendingFolders](const EntityId& id) -> const Folder* {
+        auto it = pendingFolders.find(id);
+        if (it == pendingFolders.end()) {
+            return nullptr;
+        }
+        const Folder* folder = it->second;
+        pendingFolders.erase(it);
+        return folder;
+    };
+    auto takeNote = [&pendingNotes](const EntityId& id) -> const Note* {
+        auto it = pendingNotes.find(id);
+        if (it == pendingNotes.end()) {
+            return nullptr;
+        }
+        const Note* note = it->second;
+        pendingNotes.erase(it);
+        return note;
+    };
+
+    // Iterative pre-order walk; children are pushed last-first so they are
+    // numbered in their stored order
+    std::vector<Visit> batch;
+    while (!stack.empty()) {
+        Visit visit = stack.back();
+        stack.pop_back();
+
+        Index node = static_cast<Index>(kinds_.size());
+        kinds_.push_back(visit.kind);
+        EntityId id = visit.item->getEntityId();
+        ids_.push_back(id);
+        parents_.push_back(visit.parent);
+        depths_.push_back(visit.depth);
+        names_ += visit.item->getName();
+        nameOffsets_.push_back(static_cast<uint32_t>(names_.size()));
+        index_.emplace(id, node);
+
+        batch.clear();
+        if (visit.kind == Kind::Project) {
+            for (const EntityId& folderId : static_cast<const Project*>(visit.item)->getFolderIds()) {
+                if (const Folder* folder = takeFolder(folderId)) {
+                    batch.push_back({folder, Kind::Folder, node, visit.depth + 1});
+                }
+            }
+        } else if (visit.kind == Kind::Folder) {
+            const Folder* folder = static_cast<const Folder*>(visit.item);
+            for (const EntityId& subfolderId : folder->getSubfolderIds()) {
+                if (const Folder* subfolder = takeFolder(subfolderId)) {
+                    batch.push_back({subfolder, Kind::Folder, node, visit.depth + 1});
+                }
+            }
+            for (const EntityId& noteId : folder->getNoteIds()) {
+                if (const Note* note = takeNote(noteId)) {
+                    batch.push_back({note, Kind::Note, node, visit.depth + 1});
+                }
+            }
+            folderCount_++;
+        } else {
+            noteCount_++;
+        }
+        stack.insert(stack.end(), batch.rbegin(), batch.rend());
+    }
+
+    // In pre-order a subtree ends where its last descendant's subtree ends;
+    // walking backwards settles every child before its parent
+    Index count = static_cast<Index>(kinds_.size());
+    subtreeEnds_.resize(count);
+    for (Index node = count; node-- > 0;) {
+        subtreeEnds_[node] = std::max(subtreeEnds_[node], node + 1);
+        if (parents_[node] != NONE) {
+            subtreeEnds_[parents_[node]] = std::max(subtreeEnds_[parents_[node]], subtreeEnds_[node]);
+        }
+    }
+
+    // Children of a node, in pre-order, are exactly its children in stored order
+    childOffsets_.assign(count + 1, 0);
+    for (Index node = 1; node < count; node++) {
+        childOffsets_[parents_[node] + 1]++;
+    }
+    for (Index node = 0; node < count; node++) {
+        childOffsets_[node + 1] += childOffsets_[node];
+    }
+    children_.resize(count > 0 ? count - 1 : 0);
+    std::vector<uint32_t> cursor(childOffsets_.begin(), childOffsets_.end() - 1);
+    for (Index node = 1; node < count; node++) {
+        children_[cursor[parents_[node]]++] = node;
+    }
+}
+
+ProjectSnapshot::Index ProjectSnapshot::indexOf(const EntityId& id) const {
+    auto it = index_.find(id);
+    return it != index_.end() ? it->second : NONE;
+}
+
+std::vector<ProjectSnapshot::Index> ProjectSnapshot::ancestors(Index node) const {
+    std::vector<Index> result;
+    result.reserve(depths_[node]);
+    for (Index current = parents_[node]; current != NONE; current = parents_[current]) {
+        result.push_back(current);
+    }
+    return result;
+}
+
+std::vector<ProjectSnapshot::Index> ProjectSnapshot::breadthFirst(Index root) const {
+    std::vector<Index> order;
+    order.reserve(subtreeEnds_[root] - root);
+    order.push_back(root);
+    for (size_t next = 0; next < order.size(); next++) {
+        IndexRange range = children(order[next]);
+        order.insert(order.end(), range.begin(), range.end());
+    }
+    return order;
+}
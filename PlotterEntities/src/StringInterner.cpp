@@ -0,0 +1,69 @@
+#include "StringInterner.h"
+#include <mutex>
+
+StringInterner& StringInterner::instance() {
+    // Leaked on purpose so static handles can still release into it at exit
+    static StringInterner* interner = new StringInterner();
+    return *interner;
+}
+
+const StringInterner::Entry* StringInterner::acquireExisting(const std::string& value, size_t hash) {
+    Shard& shard = shards_[hash % SHARD_COUNT];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.strings.find(std::string_view(value));
+    if (it == shard.strings.end()) {
+        return nullptr;
+    }
+    // Entries in the map always hold a reference: the last one is dropped under the unique lock
+    retain(it->second.get());
+    return it->second.get();
+}
+
+const StringInterner::Entry* StringInterner::acquire(const std::string& value, size_t hash) {
+    if (const Entry* existing = acquireExisting(value, hash)) {
+        return existing;
+    }
+
+    Shard& shard = shards_[hash % SHARD_COUNT];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.strings.find(std::string_view(value));
+    if (it != shard.strings.end()) {
+        retain(it->second.get());
+        return it->second.get();
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->value = value;
+    entry->hash = hash;
+    entry->references.store(1, std::memory_order_relaxed);
+    const Entry* pooled = entry.get();
+    shard.strings.emplace(std::string_view(pooled->value), std::move(entry));
+    return pooled;
+}
+
+void StringInterner::release(const Entry* entry) noexcept {
+    size_t references = entry->references.load(std::memory_order_relaxed);
+    while (references > 1) {
+        if (entry->references.compare_exchange_weak(references, references - 1, std::memory_order_acq_rel,
+                                                    std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    // Possibly the last reference. Drop it under the unique lock, where no
+    // lookup can find the entry and take a new one in the meantime.
+    Shard& shard = shards_[entry->hash % SHARD_COUNT];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (entry->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        shard.strings.erase(shard.strings.find(std::string_view(entry->value)));
+    }
+}
+
+size_t StringInterner::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.strings.size();
+    }
+    return total;
+}
@@ -4,6 +4,18 @@
 #include "Project.h"
 #include "Folder.h"
 #include "Note.h"
+#include "IdGenerator.h"
+#include "EntityId.h"
+#include "IndexedIdSet.h"
+#include "ProjectSnapshot.h"
+#include "EntityCodec.h"
+#include <type_traits>
+#include <unordered_set>
+#include <cmath>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
 
 // Simple test framework
 int tests_run = 0;
@@ -174,6 +186,86 @@ TEST(test_note_set_content) {
     assert(note.getContent() == "Updated content");
 }
 
+TEST(test_note_content_copy_on_write) {
+    Note note("note-1", "My Note", "/notes/test.md", "folder-1");
+    note.setContent(std::string(1 << 20, 'x'));
+
+    // Copies share the buffer
+    Note copy = note;
+    assert(&copy.getContent() == &note.getContent());
+    auto held = note.getContentBuffer();
+    assert(held.use_count() == 3);
+
+    // Writing gives the writer a new buffer and leaves the others untouched
+    copy.setContent("changed");
+    assert(copy.getContent() == "changed");
+    assert(note.getContent().size() == (1u << 20));
+    note.setContent("");
+    assert(note.getContent().empty());
+    assert(held->size() == (1u << 20));
+
+    // Buffers can be handed between notes without copying
+    note.setContentBuffer(held);
+    assert(&note.getContent() == held.get());
+    note.setContentBuffer(nullptr);
+    assert(note.getContent().empty());
+}
+
+TEST(test_note_lazy_content) {
+    // Minimal storage that counts how often it is read
+    class CountingStorage : public NoteStorage {
+    public:
+        int loads = 0;
+        std::string loadNote(const std::string& path) override {
+            loads++;
+            if (path == "/missing.md") {
+                throw std::runtime_error("No note at " + path);
+            }
+            return "content of " + path;
+        }
+        void saveNote(const std::string&, const std::string&) override {}
+        bool noteExists(const std::string&) override { return true; }
+    };
+
+    auto storage = std::make_shared<CountingStorage>();
+    Note note("note-1", "My Note", "/notes/test.md", "folder-1");
+    auto updated = note.getUpdatedAt();
+    note.bindContentStorage(storage);
+    assert(!note.isContentLoaded());
+    assert(note.getUpdatedAt() == updated);
+
+    // Copies share the pending load, so storage is read once
+    Note copy = note;
+    assert(storage->loads == 0);
+    assert(copy.getContent() == "content of /notes/test.md");
+    assert(note.isContentLoaded());
+    assert(note.getContent() == "content of /notes/test.md");
+    assert(storage->loads == 1);
+
+    // A failed load is not cached
+    Note missing("note-2", "Missing", "/missing.md", "folder-1");
+    missing.bindContentStorage(storage);
+    bool threw = false;
+    try {
+        missing.getContent();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw && !missing.isContentLoaded());
+
+    // Setting content replaces the pending load
+    missing.setContent("written");
+    assert(missing.isContentLoaded() && missing.getContent() == "written");
+    assert(storage->loads == 2);
+
+    int calls = 0;
+    Note viaCallback("note-3", "Callback", "/notes/cb.md", "folder-1");
+    viaCallback.setContentLoader([&calls]() { calls++; return std::string("from callback"); });
+    assert(viaCallback.getContent() == "from callback");
+    assert(viaCallback.getContent() == "from callback");
+    assert(calls == 1);
+}
+
 TEST(test_note_set_path) {
     Note note("note-1", "My Note", "/notes/test.md", "folder-1");
     
@@ -234,6 +326,28 @@ TEST(test_note_attribute_type_mismatch) {
     }
 }
 
+TEST(test_note_attribute_out_of_range) {
+    Note note("note-1", "My Note", "/notes/test.md", "folder-1");
+    note.setAttribute("big", int64_t(1) << 40);
+    note.setAttribute("negative", -1);
+
+    assert(note.getAttribute<int64_t>("big") == int64_t(1) << 40);
+    assert(!AttributeStore::fromValue<int>(*note.getAttributes().find("big")));
+    assert(note.getAttribute<int>("big", 7) == 7);
+    assert(note.getAttribute<int>("negative") == -1);
+    assert(!AttributeStore::fromValue<unsigned>(*note.getAttributes().find("negative")));
+    assert(!AttributeStore::fromValue<uint8_t>(AttributeStore::toValue(256)));
+    assert(AttributeStore::fromValue<uint8_t>(AttributeStore::toValue(255)) == uint8_t(255));
+
+    bool threw = false;
+    try {
+        note.getAttribute<int>("big");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
 TEST(test_note_missing_attribute) {
     Note note("note-1", "My Note", "/notes/test.md", "folder-1");
     
@@ -262,6 +376,530 @@ TEST(test_note_timestamps) {
     assert(newUpdated >= updated);
 }
 
+TEST(test_note_attribute_kinds) {
+    Note note("note-1", "My Note", "/notes/test.md", "folder-1");
+    auto now = std::chrono::system_clock::now();
+    note.setAttribute("rating", 4.5);
+    note.setAttribute("seen", now);
+    note.setAttribute("tags", std::vector<std::string>{"a", "b"});
+    note.setAttribute("title", "literal");
+    note.setAttribute<long long>("big", 1LL << 40);
+
+    assert(note.getAttribute<double>("rating") == 4.5);
+    assert(note.getAttribute<AttributeTimestamp>("seen") == now);
+    assert(note.getAttribute<std::vector<std::string>>("tags").size() == 2);
+    assert(note.getAttribute<std::string>("title") == "literal");
+    assert(note.getAttribute<int64_t>("big") == (1LL << 40));
+
+    // Integers and floating point stay distinct kinds
+    assert(note.getAttribute<double>("big", -1.0) == -1.0);
+    assert(note.getAttribute<int>("rating", -1) == -1);
+
+    // Overwriting replaces the value and kind in place
+    note.setAttribute("rating", std::string("high"));
+    assert(note.getAttribute<std::string>("rating") == "high");
+    assert(note.getAttributes().size() == 5);
+
+    // Spilling past the inline capacity and removing from the middle keeps the rest
+    for (int i = 0; i < 20; i++) {
+        note.setAttribute("extra-" + std::to_string(i), i);
+    }
+    assert(note.removeAttribute("extra-7"));
+    assert(note.getAttributes().size() == 24);
+    for (int i = 0; i < 20; i++) {
+        assert(note.hasAttribute("extra-" + std::to_string(i)) == (i != 7));
+    }
+    assert(note.getAttribute<int>("extra-19") == 19);
+
+    Note copy = note;
+    assert(copy.getAttribute<int>("extra-3") == 3);
+    assert(copy.getAttributes().begin()->key == note.getAttributes().begin()->key);   // Interned
+}
+
+// ============================================================================
+// Change Tracking Tests
+// ============================================================================
+
+TEST(test_new_entities_are_fully_dirty) {
+    Note note("note-1", "My Note", "/notes/test.md", "folder-1");
+    Folder folder("folder-1", "Folder", "", "proj-1", "");
+    Project project("proj-1", "Project", "");
+    assert(note.getDirtyFields() == FieldMask::all());
+    assert(folder.getDirtyFields() == FieldMask::all());
+    assert(project.getDirtyFields() == FieldMask::all());
+}
+
+TEST(test_setters_mark_only_their_field) {
+    Note note("note-1", "My Note", "/notes/test.md", "folder-1");
+    note.clearDirtyFields();
+    assert(note.getDirtyFields().empty());
+
+    note.setName("Renamed");
+    assert(note.getDirtyFields() == FieldMask(EntityField::Name));
+    assert(!note.isDirty(EntityField::Content));
+
+    note.setParentFolderId("folder-2");
+    note.setAttribute("priority", 3);
+    assert(note.getDirtyFields() == (EntityField::Name | EntityField::ParentFolder | EntityField::Attributes));
+
+    // Binding lazy content is not a change
+    note.clearDirtyFields();
+    note.setContentLoader([]() { return std::string("loaded"); });
+    assert(note.getContent() == "loaded");
+    assert(note.getDirtyFields().empty());
+    note.setContent("edited");
+    assert(note.isDirty(EntityField::Content));
+
+    Folder folder("folder-1", "Folder", "", "proj-1", "");
+    folder.clearDirtyFields();
+    assert(!folder.removeNoteId("missing"));
+    assert(folder.getDirtyFields().empty());
+    assert(folder.addNoteId("note-1"));
+    assert(folder.getDirtyFields() == FieldMask(EntityField::Children));
+
+    Project project("proj-1", "Project", "");
+    project.clearDirtyFields();
+    project.setDescription("Described");
+    assert(project.getDirtyFields() == FieldMask(EntityField::Description));
+}
+
+TEST(test_note_edit_batches_timestamp) {
+    Note note("note-1", "My Note", "/notes/test.md", "folder-1");
+    note.clearDirtyFields();
+    auto before = note.getUpdatedAt();
+
+    int commits = 0;
+    FieldMask persisted;
+    {
+        Note::Edit edit = note.edit([&](const Note& n) {
+            commits++;
+            persisted = n.getDirtyFields();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        note.setContent("Imported");
+        edit->setAttribute("status", std::string("imported"));
+        note.setPath("/notes/imported.md");
+        assert(note.getUpdatedAt() == before);
+
+        // Nested scopes neither stamp nor call their handler
+        Note::Edit inner = note.edit([&](const Note&) { commits += 100; });
+        note.setAttribute("priority", 1);
+        inner.commit();
+        assert(note.getUpdatedAt() == before);
+
+        edit.commit();
+        assert(note.getUpdatedAt() > before);
+        assert(commits == 1);
+        assert(persisted == (EntityField::Content | EntityField::Path | EntityField::Attributes));
+        assert(note.getDirtyFields().empty());
+
+        bool threw = false;
+        try {
+            edit.commit();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Nothing dirty: nothing to hand on
+    note.edit([&](const Note&) { commits++; }).commit();
+    assert(commits == 1);
+
+    // A scope that is never committed still stamps, but skips the handler
+    auto committed = note.getUpdatedAt();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    {
+        Note::Edit edit = note.edit([&](const Note&) { commits++; });
+        note.setContent("Abandoned");
+    }
+    assert(commits == 1);
+    assert(note.getUpdatedAt() > committed);
+    assert(note.isDirty(EntityField::Content));
+
+    // Copies made inside a batch are not part of it
+    auto edit = note.edit();
+    Note copy = note;
+    auto copyBefore = copy.getUpdatedAt();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    copy.setContent("Copy");
+    assert(copy.getUpdatedAt() > copyBefore);
+    edit.commit();
+}
+
+// ============================================================================
+// ProjectSnapshot Tests
+// ============================================================================
+
+TEST(test_project_snapshot_layout) {
+    // proj-1
+    //   folder-a
+    //     folder-c
+    //       note-2
+    //     note-1
+    //   folder-b
+    Project project("proj-1", "Project", "");
+    project.addFolderId("folder-a");
+    project.addFolderId("folder-b");
+    project.addFolderId("folder-missing");
+
+    Folder folderA("folder-a", "A", "", "proj-1", "");
+    folderA.addSubfolderId("folder-c");
+    folderA.addNoteId("note-1");
+    Folder folderB("folder-b", "B", "", "proj-1", "");
+    Folder folderC("folder-c", "C", "", "", "folder-a");
+    folderC.addNoteId("note-2");
+    folderC.addSubfolderId("folder-a");   // Cycle: must not loop
+
+    std::vector<Folder> folders = {folderC, folderB, folderA};
+    std::vector<Note> notes = {Note("note-2", "Two", "", "folder-c"), Note("note-1", "One", "", "folder-a"),
+                               Note("note-stray", "Stray", "", "folder-x")};
+    ProjectSnapshot snapshot(project, folders, notes);
+
+    assert(snapshot.size() == 6);
+    assert(snapshot.folderCount() == 3);
+    assert(snapshot.noteCount() == 2);
+
+    // Depth-first pre-order, subfolders before notes
+    const char* expected[] = {"Project", "A", "C", "Two", "One", "B"};
+    for (ProjectSnapshot::Index node = 0; node < snapshot.size(); node++) {
+        assert(snapshot.name(node) == expected[node]);
+    }
+    assert(snapshot.kind(0) == ProjectSnapshot::Kind::Project);
+    assert(snapshot.kind(3) == ProjectSnapshot::Kind::Note);
+    assert(snapshot.parent(0) == ProjectSnapshot::NONE);
+    assert(snapshot.depth(3) == 3);
+    assert(snapshot.indexOf("note-stray") == ProjectSnapshot::NONE);
+
+    ProjectSnapshot::Index a = snapshot.indexOf("folder-a");
+    ProjectSnapshot::Index note2 = snapshot.indexOf("note-2");
+    ProjectSnapshot::Index b = snapshot.indexOf("folder-b");
+    assert(snapshot.id(a) == EntityId("folder-a"));
+    assert(snapshot.subtreeEnd(a) == b);
+    assert(snapshot.isAncestor(a, note2));
+    assert(snapshot.isAncestor(0, b));
+    assert(!snapshot.isAncestor(b, note2));
+    assert(!snapshot.isAncestor(a, a));
+    assert((snapshot.ancestors(note2) == std::vector<ProjectSnapshot::Index>{2, a, 0}));
+
+    auto children = snapshot.children(a);
+    assert(children.size() == 2);
+    assert(snapshot.name(*children.begin()) == "C");
+    assert(snapshot.children(b).empty());
+
+    std::vector<std::string> breadthFirst;
+    for (ProjectSnapshot::Index node : snapshot.breadthFirst()) {
+        breadthFirst.emplace_back(snapshot.name(node));
+    }
+    assert((breadthFirst == std::vector<std::string>{"Project", "A", "B", "C", "One", "Two"}));
+    assert(snapshot.breadthFirst(b).size() == 1);
+}
+
+// ============================================================================
+// EntityCodec Tests
+// ============================================================================
+
+TEST(test_entity_codec_round_trip) {
+    Project project("proj-1", "Project", "Described");
+    project.addFolderId("folder-1");
+    project.addFolderId("folder-2");
+    Folder folder("folder-1", "Folder", "", "proj-1", "");
+    folder.addNoteId("note-1");
+    folder.addSubfolderId("folder-3");
+    Note note("note-1", "Note", "/notes/note.md", "folder-1");
+    note.setContent(std::string("line one\n\0binary", 16));
+    note.setAttribute("rating", -42);
+    note.setAttribute("score", 0.25);
+    note.setAttribute("archived", true);
+    note.setAttribute("author", std::string("Jane"));
+    note.setAttribute("tags", std::vector<std::string>{"a", "", "c"});
+    note.setAttribute("due", std::chrono::system_clock::time_point(std::chrono::seconds(-5)));
+
+    // Records concatenate and are read back in order
+    std::string buffer;
+    EntityCodec::encode(project, buffer);
+    EntityCodec::encode(folder, buffer);
+    EntityCodec::encode(note, buffer);
+
+    std::string_view input = buffer;
+    EntityCodec::Record record = EntityCodec::readRecord(input);
+    assert(record.version == EntityCodec::VERSION);
+    assert(record.kind == EntityCodec::Kind::Project);
+    Project decodedProject = EntityCodec::decodeProject(record).toEntity();
+    assert(decodedProject.getName() == "Project");
+    assert(decodedProject.getDescription() == "Described");
+    assert(decodedProject.getFolderIds() == project.getFolderIds());
+
+    Folder decodedFolder = EntityCodec::decodeFolder(EntityCodec::readRecord(input)).toEntity();
+    assert(decodedFolder.getParentProjectId() == "proj-1");
+    assert(decodedFolder.getParentFolderId().empty());
+    assert(decodedFolder.getNoteIds() == folder.getNoteIds());
+    assert(decodedFolder.getSubfolderIds() == folder.getSubfolderIds());
+
+    // Views point into the buffer
+    EntityCodec::NoteView view = EntityCodec::decodeNote(EntityCodec::readRecord(input));
+    assert(input.empty());
+    assert(view.content.data() >= buffer.data() && view.content.data() < buffer.data() + buffer.size());
+    assert(view.content == note.getContent());
+    assert(view.attributes.size() == 6);
+
+    Note decodedNote = view.toEntity();
+    assert(decodedNote.getContent() == note.getContent());
+    assert(decodedNote.getPath() == "/notes/note.md");
+    assert(decodedNote.getCreatedAt() == note.getCreatedAt());
+    assert(decodedNote.getUpdatedAt() == note.getUpdatedAt());
+    assert(decodedNote.getAttributes().size() == 6);
+    for (const AttributeStore::Entry& entry : note.getAttributes()) {
+        assert(*decodedNote.getAttributes().find(*entry.key) == entry.value);
+    }
+
+    // Wrong kind, newer version and truncation are rejected
+    std::string projectRecord = EntityCodec::encode(project);
+    bool threw = false;
+    try { EntityCodec::decodeNote(projectRecord); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    std::string newer = projectRecord;
+    newer[0] = static_cast<char>(EntityCodec::VERSION + 1);
+    threw = false;
+    try { EntityCodec::decodeProject(newer); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { EntityCodec::decodeProject(std::string_view(projectRecord).substr(0, projectRecord.size() - 1)); }
+    catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+TEST(test_entity_codec_fuzz) {
+    std::mt19937 random(20261018);
+    auto text = [&random](size_t maxLength) {
+        std::string value(random() % (maxLength + 1), '\0');
+        for (char& c : value) {
+            c = static_cast<char>(random());
+        }
+        return value;
+    };
+
+    for (int round = 0; round < 300; round++) {
+        // Random note through encode and decode
+        Note note(text(40), text(40), text(40), text(40));
+        note.setContent(text(round % 10 == 0 ? 5000 : 200));
+        int attributes = random() % 12;
+        for (int i = 0; i < attributes; i++) {
+            std::string key = "k" + std::to_string(random() % 8);
+            switch (random() % 6) {
+                case 0: note.setAttribute(key, text(30)); break;
+                case 1: note.setAttribute(key, static_cast<int64_t>(random()) * (random() % 2 ? 1 : -977)); break;
+                case 2: note.setAttribute(key, std::ldexp(static_cast<double>(random()), int(random() % 200) - 100)); break;
+                case 3: note.setAttribute(key, random() % 2 == 0); break;
+                case 4: note.setAttribute(key, std::chrono::system_clock::time_point(
+                            std::chrono::seconds(static_cast<int64_t>(random()) - INT32_MAX))); break;
+                default: note.setAttribute(key, std::vector<std::string>{text(5), text(5)}); break;
+            }
+        }
+
+        std::string encoded = EntityCodec::encode(note);
+        Note decoded = EntityCodec::decodeNote(encoded).toEntity();
+        assert(decoded.getId() == note.getId());
+        assert(decoded.getName() == note.getName());
+        assert(decoded.getParentFolderId() == note.getParentFolderId());
+        assert(decoded.getContent() == note.getContent());
+        assert(decoded.getUpdatedAt() == note.getUpdatedAt());
+        assert(decoded.getAttributes().size() == note.getAttributes().size());
+        for (const AttributeStore::Entry& entry : note.getAttributes()) {
+            const AttributeValue* value = decoded.getAttributes().find(*entry.key);
+            assert(value && *value == entry.value);
+        }
+
+        // Corrupted bytes must decode or throw, never read out of bounds
+        for (int mutation = 0; mutation < 20; mutation++) {
+            std::string corrupt = encoded;
+            int flips = 1 + random() % 4;
+            for (int i = 0; i < flips; i++) {
+                corrupt[random() % corrupt.size()] = static_cast<char>(random());
+            }
+            if (random() % 3 == 0) {
+                corrupt.resize(random() % corrupt.size());
+            }
+            try {
+                EntityCodec::decodeNote(corrupt).toEntity();
+            } catch (const std::runtime_error&) {
+            }
+        }
+    }
+}
+
+// ============================================================================
+// IdGenerator Tests
+// ============================================================================
+
+TEST(test_id_generator_format) {
+    long long before = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::string id = IdGenerator::next();
+    assert(id.size() == 36);
+    assert(id[8] == '-' && id[13] == '-' && id[18] == '-' && id[23] == '-');
+    assert(id[14] == '7');
+    assert(std::string("89ab").find(id[19]) != std::string::npos);
+    assert(IdGenerator::timestampOf(id) >= before);
+    assert(IdGenerator::timestampOf("not-an-id") == -1);
+}
+
+TEST(test_id_generator_monotonic) {
+    // Far more IDs than fit in one millisecond's sequence
+    std::string previous = IdGenerator::next();
+    for (int i = 0; i < 100000; i++) {
+        std::string id = IdGenerator::next();
+        assert(id > previous);
+        previous = id;
+    }
+}
+
+TEST(test_id_generator_unique_across_threads) {
+    const int THREADS = 8;
+    const int PER_THREAD = 20000;
+    std::vector<std::vector<std::string>> generated(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&generated, t]() {
+            for (int i = 0; i < PER_THREAD; i++) {
+                generated[t].push_back(IdGenerator::next());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<std::string> unique;
+    for (const auto& ids : generated) {
+        unique.insert(ids.begin(), ids.end());
+    }
+    assert(unique.size() == static_cast<size_t>(THREADS * PER_THREAD));
+}
+
+TEST(test_folder_children_are_a_set) {
+    Folder folder("folder-1", "Documents", "Test", "proj-1", "");
+    assert(folder.addNoteId("note-1"));
+    assert(!folder.addNoteId("note-1"));
+    assert(folder.getNoteIds().size() == 1);
+    assert(folder.hasNoteId("note-1") && !folder.hasNoteId("note-2"));
+
+    assert(folder.addSubfolderId("sub-1"));
+    assert(!folder.addSubfolderId("sub-1"));
+    assert(folder.hasSubfolderId("sub-1"));
+    assert(folder.removeSubfolderId("sub-1") && !folder.hasSubfolderId("sub-1"));
+
+    Project project("proj-1", "P", "");
+    assert(project.addFolderId("folder-1") && !project.addFolderId("folder-1"));
+    assert(project.hasFolderId("folder-1"));
+}
+
+TEST(test_indexed_id_set_bulk_removal) {
+    const int COUNT = 100000;
+    IndexedIdSet set;
+    std::vector<EntityId> ids;
+    for (int i = 0; i < COUNT; i++) {
+        ids.push_back(EntityId("bulk-" + std::to_string(i)));
+        assert(set.insert(ids.back()));
+    }
+
+    // Remove every odd ID; each removal is O(1), the single compaction O(n)
+    for (int i = 1; i < COUNT; i += 2) {
+        assert(set.erase(ids[i]));
+    }
+    assert(!set.erase(ids[1]));
+    assert(set.size() == COUNT / 2);
+
+    const auto& items = set.items();
+    assert(items.size() == COUNT / 2);
+    for (size_t i = 0; i < items.size(); i++) {
+        assert(items[i] == ids[i * 2]);   // Insertion order survives compaction
+    }
+
+    // Positions are still right after compaction
+    assert(set.erase(ids[2]));
+    assert(set.insert(ids[1]));
+    assert(set.items().size() == COUNT / 2);
+    assert(set.items().back() == ids[1]);
+    assert(set.items()[1] == ids[4]);
+    assert(!set.insert(EntityId()));
+}
+
+// ============================================================================
+// EntityId Tests
+// ============================================================================
+
+TEST(test_entity_id_interning) {
+    static_assert(sizeof(EntityId) == 16, "EntityId is two words");
+
+    std::string text = "folder-" + std::to_string(42);
+    EntityId a(text);
+    EntityId b("folder-42");
+    EntityId c("folder-43");
+    assert(a == b);
+    assert(&a.str() == &b.str());   // One pooled copy
+    assert(a.hash() == b.hash());
+    assert(std::hash<EntityId>()(a) == std::hash<std::string>()(text));
+    assert(a != c);
+    assert(a < c && !(c < a) && !(a < b));
+    assert(a == text && text == a && a == "folder-42" && a != "folder-43");
+
+    EntityId empty;
+    assert(empty.empty() && empty == EntityId("") && empty.str().empty());
+
+    std::unordered_set<EntityId> set = {a, b, c};
+    assert(set.size() == 2);
+}
+
+TEST(test_entity_id_shared_parent) {
+    Note first("note-a", "A", "a.txt", "shared-parent");
+    Note second("note-b", "B", "b.txt", std::string("shared-") + "parent");
+    assert(&first.getParentFolderId() == &second.getParentFolderId());
+
+    Folder folder("folder-1", "F", "", "proj-1", "");
+    folder.addNoteId(first.getEntityId());
+    folder.addNoteId("note-b");
+    assert(folder.getNoteIds()[0] == first.getEntityId());
+    assert(folder.getNoteIds()[1] == second.getId());
+    assert(folder.removeNoteId(std::string("note-a")));
+    assert(folder.getNoteIds().size() == 1);
+
+    // Entities' own IDs are not pooled, only the IDs they reference
+    size_t pooled = StringInterner::instance().size();
+    for (int i = 0; i < 100; i++) {
+        Note note("unpooled-note-" + std::to_string(i), "N", "n.txt", "shared-parent");
+    }
+    assert(StringInterner::instance().size() == pooled);
+    // Queries never add to the pool
+    assert(!folder.hasNoteId("never-pooled") && !folder.removeNoteId("never-pooled"));
+    assert(!folder.hasSubfolderId("never-pooled") && !folder.removeSubfolderId("never-pooled"));
+    assert(StringInterner::instance().size() == pooled);
+}
+
+TEST(test_entity_id_pool_reclaimed) {
+    size_t pooled = StringInterner::instance().size();
+    {
+        EntityId id("short-lived-id");
+        EntityId copy = id;
+        assert(StringInterner::instance().size() == pooled + 1);
+        assert(EntityId::find("short-lived-id") == id);
+        assert(EntityId::find("not-held-anywhere").empty());
+
+        Folder folder("folder-r", "R", "", "proj-r", "");
+        for (int i = 0; i < 100; i++) {
+            folder.addNoteId("reclaimed-note-" + std::to_string(i));
+        }
+        assert(StringInterner::instance().size() == pooled + 102);
+
+        // Removing a child drops its ID from the pool once nothing else holds it
+        assert(folder.removeNoteId("reclaimed-note-0"));
+        assert(StringInterner::instance().size() == pooled + 101);
+    }
+    // The last reference takes the pooled copy with it
+    assert(StringInterner::instance().size() == pooled);
+    assert(EntityId::find("short-lived-id").empty());
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -284,17 +922,50 @@ int main() {
     run_test_folder_add_subfolder();
     run_test_folder_remove_subfolder();
     run_test_folder_set_parent();
+    run_test_folder_children_are_a_set();
+    run_test_indexed_id_set_bulk_removal();
     
     // Note tests
     std::cout << "\n--- Note Tests ---" << std::endl;
     run_test_note_constructor();
     run_test_note_set_content();
+    run_test_note_content_copy_on_write();
+    run_test_note_lazy_content();
     run_test_note_set_path();
     run_test_note_set_parent_folder();
     run_test_note_attributes();
     run_test_note_attribute_type_mismatch();
+    run_test_note_attribute_kinds();
+    run_test_note_attribute_out_of_range();
     run_test_note_missing_attribute();
     run_test_note_timestamps();
+
+    // Change tracking tests
+    std::cout << "\n--- Change Tracking Tests ---" << std::endl;
+    run_test_new_entities_are_fully_dirty();
+    run_test_setters_mark_only_their_field();
+    run_test_note_edit_batches_timestamp();
+
+    // ProjectSnapshot tests
+    std::cout << "\n--- ProjectSnapshot Tests ---" << std::endl;
+    run_test_project_snapshot_layout();
+
+    // EntityCodec tests
+    std::cout << "\n--- EntityCodec Tests ---" << std::endl;
+    run_test_entity_codec_round_trip();
+    run_test_entity_codec_fuzz();
+
+    // IdGenerator tests
+    std::cout << "\n--- IdGenerator Tests ---" << std::endl;
+    run_test_id_generator_format();
+    run_test_id_generator_monotonic();
+    run_test_id_generator_unique_across_threads();
+
+    // EntityId tests
+    std::cout << "\n--- EntityId Tests ---" << std::endl;
+    run_test_entity_id_interning();
+    run_test_entity_id_shared_parent();
+    run_test_entity_id_pool_reclaimed();
     
     // Summary
     std::cout << "\n=== Test Summary ===" << std::endl;
@@ -0,0 +1,117 @@
+#ifndef PLOTTER_ATOMIC_FILE_WRITER_H
+#define PLOTTER_ATOMIC_FILE_WRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace plotter {
+namespace filesystem_dtos {
+
+/**
+ * @brief Batches the durability work of concurrent atomic writes
+ *
+ * Writers hand over a fully written temp file and the path it should replace.
+ * The first waiter to arrive while no flush is running becomes the leader: it
+ * takes every pending entry, makes their data durable, renames each temp file
+ * into place and then fsyncs every affected directory exactly once. Writers
+ * that arrive during a flush queue up for the next batch, so under load a
+ * single round of syncs covers many notes instead of one fsync per file.
+ */
+class GroupCommitCoordinator {
+public:
+    struct Stats {
+        uint64_t commits = 0;          // Entries committed (successfully or not)
+        uint64_t batches = 0;          // Flushes performed
+        uint64_t directorySyncs = 0;   // Directory fsyncs issued
+    };
+
+    static GroupCommitCoordinator& instance();
+
+    /**
+     * @brief Rename tempPath over finalPath once both are durable
+     *
+     * Blocks until the batch containing this entry has been flushed.
+     * @throws std::runtime_error if syncing or renaming failed; the temp file is removed
+     */
+    void commit(const std::string& tempPath, const std::string& finalPath);
+
+    /**
+     * @brief Make in-place changes to a file (e.g. appends) durable with the next batch
+     * @param path File that was modified
+     * @param syncDirectory Also fsync the parent directory (needed when the file was just created)
+     * @throws std::runtime_error if the sync failed
+     */
+    void syncFile(const std::string& path, bool syncDirectory);
+
+    Stats getStats() const;
+
+private:
+    struct Entry {
+        std::string tempPath;   // Empty for in-place syncs
+        std::string finalPath;
+        bool syncDirectory;
+        std::string error;
+    };
+
+    struct Batch {
+        std::vector<Entry> entries;
+        bool done = false;
+    };
+
+    GroupCommitCoordinator();
+
+    void enqueueAndWait(Entry entry);
+    void flush(Batch& batch);
+
+    mutable std::mutex mutex_;
+    std::condition_variable flushed_;
+    std::shared_ptr<Batch> pending_;
+    bool flushing_;
+    Stats stats_;
+};
+
+/**
+ * @brief Crash-safe replacement of whole files
+ *
+ * Content is written to a hidden temp file next to the target and renamed over
+ * it through the GroupCommitCoordinator, so readers and crashes only ever see
+ * the old or the new file, never a truncated one.
+ */
+class AtomicFileWriter {
+public:
+    /**
+     * @brief Atomically replace (or create) a file with the given content
+     * @param path Destination path; its parent directory must exist
+     * @param content Bytes to write
+     * @throws std::runtime_error on any I/O failure
+     */
+    static void writeFile(const std::string& path, const std::string& content);
+
+    /**
+     * @brief Append to (or create) a file and wait until the append is durable
+     *
+     * Appends are not atomic across crashes: a torn final record may survive,
+     * so formats written this way must tolerate a truncated tail.
+     * @throws std::runtime_error on any I/O failure
+     */
+    static void appendFile(const std::string& path, const std::string& content);
+
+    /**
+     * @brief Cut an append-only file back to its last newline
+     *
+     * Call before appending, with the file locked against other writers, so a
+     * record torn by a crash is dropped instead of swallowing the next one.
+     * A missing file is left alone.
+     * @throws std::runtime_error on any I/O failure
+     */
+    static void truncateTornTail(const std::string& path);
+};
+
+} // namespace filesystem_dtos
+} // namespace plotter
+
+#endif // PLOTTER_ATOMIC_FILE_WRITER_H
@@ -2,6 +2,8 @@
 #define PLOTTER_FILESYSTEM_DTOS_H
 
 #include "BaseDTOs.h"
+#include "ChangeMask.h"
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -23,6 +25,7 @@ struct FilesystemProjectDTO : public plotter::dto::ProjectDTO {
     long long createdAt;            // Unix timestamp in milliseconds
     long long updatedAt;            // Unix timestamp in milliseconds
     std::vector<std::string> folderIds;  // IDs of folders in this project
+    plotter::dto::ChangeMask changes;  // Fields an update has to write
 
     FilesystemProjectDTO() : createdAt(0), updatedAt(0) {}
 };
@@ -45,6 +48,7 @@ struct FilesystemFolderDTO : public plotter::dto::FolderDTO {
     long long updatedAt;
     std::vector<std::string> noteIds;       // IDs of notes in this folder
     std::vector<std::string> subfolderIds;  // IDs of subfolders
+    plotter::dto::ChangeMask changes;  // Fields an update has to write
 
     FilesystemFolderDTO() : createdAt(0), updatedAt(0) {}
 };
@@ -55,6 +59,8 @@ struct FilesystemFolderDTO : public plotter::dto::FolderDTO {
  * Inherits from base NoteDTO and defines filesystem-specific fields.
  * Notes are represented as regular text files with a companion hidden file
  * (e.g., note.md and .plotter_note.md.meta) containing note metadata.
+ * Folder listings do not read the note files: their DTOs have contentLoaded
+ * unset and a contentLoader that reads the file when the note is opened.
  */
 struct FilesystemNoteDTO : public plotter::dto::NoteDTO {
     std::string id;
@@ -64,8 +70,11 @@ struct FilesystemNoteDTO : public plotter::dto::NoteDTO {
     std::string parentFolderId;
     long long createdAt;
     long long updatedAt;
+    bool contentLoaded;             // False when the note file has not been read
+    std::function<std::string()> contentLoader;  // Reads the note file when contentLoaded is false
+    plotter::dto::ChangeMask changes;  // Fields an update has to write
 
-    FilesystemNoteDTO() : createdAt(0), updatedAt(0) {}
+    FilesystemNoteDTO() : createdAt(0), updatedAt(0), contentLoaded(true) {}
 };
 
 /**
@@ -81,7 +90,7 @@ public:
 
     /**
      * @brief Generate a unique ID for filesystem entities
-     * @return A unique string ID (UUID format)
+     * @return A unique, time-ordered UUIDv7 string (see IdGenerator)
      */
     static std::string generateId();
 
@@ -94,6 +103,9 @@ public:
 
     /**
      * @brief Write metadata to a dotfile
+     *
+     * The dotfile is replaced atomically (temp file + rename) and is durable
+     * when this returns; see AtomicFileWriter.
      * @param dotfilePath Path to the dotfile
      * @param content JSON string containing metadata
      */
@@ -119,6 +131,17 @@ public:
      * @return True if there's a corresponding .plotter_note.*.meta file
      */
     static bool isNoteFile(const std::string& path);
+
+    /**
+     * @brief Check if a path is a directory Plotter keeps for itself
+     *
+     * Internal directories (trash, object and pack stores, ...) are named
+     * .plotter_* and are never part of the project/folder/note tree, so
+     * tree walks must not descend into them.
+     * @param path Path to check
+     * @return True if the last path component starts with .plotter_
+     */
+    static bool isInternalDirectory(const std::string& path);
 };
 
 } // namespace filesystem_dtos
@@ -0,0 +1,299 @@
+#include "plotter_filesystem_dtos/AtomicFileWriter.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace plotter {
+namespace filesystem_dtos {
+
+namespace {
+
+std::string errnoMessage(const std::string& what, const std::string& path) {
+    return what + " " + path + ": " + std::strerror(errno);
+}
+
+std::string parentDirectory(const std::string& path) {
+    auto slash = path.find_last_of('/');
+    if (slash == std::string::npos) {
+        return ".";
+    }
+    if (slash == 0) {
+        return "/";
+    }
+    return path.substr(0, slash);
+}
+
+bool syncPath(const std::string& path, int flags) {
+    int fd = ::open(path.c_str(), flags | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+
+#ifdef __linux__
+// One syncfs() flushes every dirty page on the filesystem, which is far cheaper
+// than an fsync per temp file when a batch holds many small notes.
+bool syncFilesystemOf(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = ::syncfs(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+#endif
+
+} // namespace
+
+GroupCommitCoordinator::GroupCommitCoordinator()
+    : pending_(std::make_shared<Batch>()), flushing_(false) {
+}
+
+GroupCommitCoordinator& GroupCommitCoordinator::instance() {
+    static GroupCommitCoordinator coordinator;
+    return coordinator;
+}
+
+void GroupCommitCoordinator::commit(const std::string& tempPath, const std::string& finalPath) {
+    enqueueAndWait({tempPath, finalPath, true, ""});
+}
+
+void GroupCommitCoordinator::syncFile(const std::string& path, bool syncDirectory) {
+    enqueueAndWait({"", path, syncDirectory, ""});
+}
+
+void GroupCommitCoordinator::enqueueAndWait(Entry entry) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    std::shared_ptr<Batch> batch = pending_;
+    size_t index = batch->entries.size();
+    batch->entries.push_back(std::move(entry));
+
+    while (!batch->done) {
+        if (flushing_) {
+            flushed_.wait(lock);
+            continue;
+        }
+
+        // Become the leader for whatever has queued up so far
+        flushing_ = true;
+        std::shared_ptr<Batch> current = pending_;
+        pending_ = std::make_shared<Batch>();
+
+        lock.unlock();
+        flush(*current);
+        lock.lock();
+
+        current->done = true;
+        flushing_ = false;
+        stats_.batches++;
+        stats_.commits += current->entries.size();
+        flushed_.notify_all();
+    }
+
+    const std::string& error = batch->entries[index].error;
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+}
+
+void GroupCommitCoordinator::flush(Batch& batch) {
+    // Phase 1: make the temp file contents durable before they become visible
+#ifdef __linux__
+    std::set<dev_t> devices;
+    for (auto& entry : batch.entries) {
+        const std::string& path = entry.tempPath.empty() ? entry.finalPath : entry.tempPath;
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0) {
+            entry.error = errnoMessage("Failed to stat", path);
+            continue;
+        }
+        if (devices.insert(st.st_dev).second && !syncFilesystemOf(path)) {
+            entry.error = errnoMessage("Failed to sync filesystem for", path);
+        }
+    }
+#else
+    for (auto& entry : batch.entries) {
+        const std::string& path = entry.tempPath.empty() ? entry.finalPath : entry.tempPath;
+        if (!syncPath(path, O_RDONLY)) {
+            entry.error = errnoMessage("Failed to sync", path);
+        }
+    }
+#endif
+
+    // Phase 2: publish each file with an atomic rename
+    std::set<std::string> directories;
+    for (auto& entry : batch.entries) {
+        bool inPlace = entry.tempPath.empty();
+        if (!inPlace && entry.error.empty() &&
+            ::rename(entry.tempPath.c_str(), entry.finalPath.c_str()) != 0) {
+            entry.error = errnoMessage("Failed to rename temp file over", entry.finalPath);
+        }
+        if (!entry.error.empty()) {
+            if (!inPlace) {
+                ::unlink(entry.tempPath.c_str());
+            }
+            continue;
+        }
+        if (entry.syncDirectory) {
+            directories.insert(parentDirectory(entry.finalPath));
+        }
+    }
+
+    // Phase 3: persist the renames, once per directory
+    uint64_t syncs = 0;
+    for (const auto& dir : directories) {
+        syncs++;
+        if (!syncPath(dir, O_RDONLY | O_DIRECTORY)) {
+            std::string error = errnoMessage("Failed to sync directory", dir);
+            for (auto& entry : batch.entries) {
+                if (entry.error.empty() && entry.syncDirectory && parentDirectory(entry.finalPath) == dir) {
+                    entry.error = error;
+                }
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.directorySyncs += syncs;
+}
+
+GroupCommitCoordinator::Stats GroupCommitCoordinator::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+namespace {
+
+bool writeAll(int fd, const std::string& content) {
+    const char* data = content.data();
+    size_t remaining = content.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+void AtomicFileWriter::writeFile(const std::string& path, const std::string& content) {
+    static std::atomic<uint64_t> counter{0};
+
+    std::string dir = parentDirectory(path);
+    std::string base = path.substr(path.find_last_of('/') + 1);
+    std::string tempPath = dir + "/." + base + ".tmp." + std::to_string(::getpid()) + "." +
+                           std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        throw std::runtime_error(errnoMessage("Failed to create temp file for", path));
+    }
+
+    if (!writeAll(fd, content)) {
+        std::string error = errnoMessage("Failed to write", path);
+        ::close(fd);
+        ::unlink(tempPath.c_str());
+        throw std::runtime_error(error);
+    }
+
+    if (::close(fd) != 0) {
+        std::string error = errnoMessage("Failed to close temp file for", path);
+        ::unlink(tempPath.c_str());
+        throw std::runtime_error(error);
+    }
+
+    GroupCommitCoordinator::instance().commit(tempPath, path);
+}
+
+void AtomicFileWriter::appendFile(const std::string& path, const std::string& content) {
+    struct stat st;
+    bool created = ::stat(path.c_str(), &st) != 0;
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        throw std::runtime_error(errnoMessage("Failed to open for append", path));
+    }
+
+    if (!writeAll(fd, content)) {
+        std::string error = errnoMessage("Failed to append to", path);
+        ::close(fd);
+        throw std::runtime_error(error);
+    }
+
+    if (::close(fd) != 0) {
+        throw std::runtime_error(errnoMessage("Failed to close", path));
+    }
+
+    GroupCommitCoordinator::instance().syncFile(path, created);
+}
+
+void AtomicFileWriter::truncateTornTail(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            return;
+        }
+        throw std::runtime_error(errnoMessage("Failed to open", path));
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        std::string error = errnoMessage("Failed to stat", path);
+        ::close(fd);
+        throw std::runtime_error(error);
+    }
+
+    off_t keep = st.st_size;
+    char buffer[4096];
+    bool torn = false;
+    while (keep > 0) {
+        off_t start = std::max<off_t>(0, keep - static_cast<off_t>(sizeof(buffer)));
+        size_t length = static_cast<size_t>(keep - start);
+        if (::pread(fd, buffer, length, start) != static_cast<ssize_t>(length)) {
+            std::string error = errnoMessage("Failed to read", path);
+            ::close(fd);
+            throw std::runtime_error(error);
+        }
+        size_t end = length;
+        while (end > 0 && buffer[end - 1] != '\n') {
+            end--;
+        }
+        if (end == length && !torn) {
+            break;  // Ends in a complete line
+        }
+        torn = true;
+        keep = start + static_cast<off_t>(end);
+        if (end > 0) {
+            break;
+        }
+    }
+
+    // The following append syncs the file, which also makes the cut durable
+    if (torn && ::ftruncate(fd, keep) != 0) {
+        std::string error = errnoMessage("Failed to truncate", path);
+        ::close(fd);
+        throw std::runtime_error(error);
+    }
+    ::close(fd);
+}
+
+} // namespace filesystem_dtos
+} // namespace plotter
@@ -1,9 +1,9 @@
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
+#include "plotter_filesystem_dtos/AtomicFileWriter.h"
+#include "IdGenerator.h"
 #include <chrono>
 #include <fstream>
 #include <sstream>
-#include <random>
-#include <iomanip>
 #include <sys/stat.h>
 
 namespace plotter {
@@ -16,24 +16,7 @@ long long FilesystemDTOUtils::getCurrentTimestamp() {
 }
 
 std::string FilesystemDTOUtils::generateId() {
-    // Generate a simple UUID-like string
-    std::random_device rd;
-    std::mt19937_64 gen(rd());
-    std::uniform_int_distribution<uint64_t> dis;
-
-    std::ostringstream oss;
-    oss << std::hex << std::setfill('0');
-
-    uint64_t part1 = dis(gen);
-    uint64_t part2 = dis(gen);
-
-    oss << std::setw(8) << (part1 >> 32) << "-"
-        << std::setw(4) << ((part1 >> 16) & 0xFFFF) << "-"
-        << std::setw(4) << (part1 & 0xFFFF) << "-"
-        << std::setw(4) << (part2 >> 48) << "-"
-        << std::setw(12) << (part2 & 0xFFFFFFFFFFFF);
-
-    return oss.str();
+    return IdGenerator::next();
 }
 
 std::string FilesystemDTOUtils::readDotfile(const std::string& dotfilePath) {
@@ -48,13 +31,11 @@ std::string FilesystemDTOUtils::readDotfile(const std::string& dotfilePath) {
 }
 
 void FilesystemDTOUtils::writeDotfile(const std::string& dotfilePath, const std::string& content) {
-    std::ofstream file(dotfilePath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to write dotfile: " + dotfilePath);
+    try {
+        AtomicFileWriter::writeFile(dotfilePath, content);
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Failed to write dotfile: " + dotfilePath + " (" + e.what() + ")");
     }
-
-    file << content;
-    file.close();
 }
 
 bool FilesystemDTOUtils::isProjectDirectory(const std::string& path) {
@@ -75,6 +56,12 @@ bool FilesystemDTOUtils::isNoteFile(const std::string& path) {
     return (stat(metafile.c_str(), &st) == 0);
 }
 
+bool FilesystemDTOUtils::isInternalDirectory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    return name.compare(0, 9, ".plotter_") == 0;
+}
+
 } // namespace filesystem_dtos
 } // namespace plotter
 
@@ -1,8 +1,11 @@
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
+#include "plotter_filesystem_dtos/AtomicFileWriter.h"
 #include <iostream>
 #include <cassert>
 #include <filesystem>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 using namespace plotter::filesystem_dtos;
 namespace fs = std::filesystem;
@@ -24,6 +27,8 @@ void testGenerateId() {
     assert(!id2.empty());
     assert(id1 != id2);
     assert(id1.length() >= 32); // UUID-like format
+    assert(id1 < id2);          // Time-ordered
+    assert(id1[14] == '7');     // UUIDv7
     std::cout << "✓ Generate ID test passed (sample: " << id1 << ")\n";
 }
 
@@ -39,6 +44,79 @@ void testDotfileReadWrite() {
     std::cout << "✓ Dotfile read/write test passed\n";
 }
 
+void testAtomicWriteReplacesFile() {
+    fs::path tempDir = fs::temp_directory_path() / "test_plotter_atomic";
+    fs::remove_all(tempDir);
+    fs::create_directory(tempDir);
+    std::string target = (tempDir / "note.md").string();
+
+    AtomicFileWriter::writeFile(target, "first version");
+    AtomicFileWriter::writeFile(target, "second");
+    assert(FilesystemDTOUtils::readDotfile(target) == "second");
+
+    // No temp files may be left behind
+    size_t entries = 0;
+    for (const auto& entry : fs::directory_iterator(tempDir)) {
+        (void)entry;
+        entries++;
+    }
+    assert(entries == 1);
+
+    fs::remove_all(tempDir);
+    std::cout << "✓ Atomic write test passed\n";
+}
+
+void testGroupCommitBatchesConcurrentWrites() {
+    fs::path tempDir = fs::temp_directory_path() / "test_plotter_group_commit";
+    fs::remove_all(tempDir);
+    fs::create_directory(tempDir);
+
+    auto before = GroupCommitCoordinator::instance().getStats();
+
+    const int threadCount = 8;
+    const int writesPerThread = 25;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < writesPerThread; i++) {
+                std::string name = "note_" + std::to_string(t) + "_" + std::to_string(i) + ".md";
+                AtomicFileWriter::writeFile((tempDir / name).string(), "content " + name);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto after = GroupCommitCoordinator::instance().getStats();
+    uint64_t commits = after.commits - before.commits;
+    uint64_t batches = after.batches - before.batches;
+    assert(commits == threadCount * writesPerThread);
+    assert(batches >= 1 && batches <= commits);
+    assert(after.directorySyncs - before.directorySyncs == batches);
+
+    for (int t = 0; t < threadCount; t++) {
+        for (int i = 0; i < writesPerThread; i++) {
+            std::string name = "note_" + std::to_string(t) + "_" + std::to_string(i) + ".md";
+            assert(FilesystemDTOUtils::readDotfile((tempDir / name).string()) == "content " + name);
+        }
+    }
+
+    fs::remove_all(tempDir);
+    std::cout << "✓ Group commit test passed (" << commits << " writes in " << batches << " batches)\n";
+}
+
+void testAtomicWriteMissingDirectoryThrows() {
+    bool threw = false;
+    try {
+        AtomicFileWriter::writeFile("/tmp/test_plotter_no_such_dir/x/note.md", "data");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ Atomic write error test passed\n";
+}
+
 void testIsProjectDirectory() {
     fs::path tempDir = fs::temp_directory_path() / "test_plotter_project";
     fs::create_directory(tempDir);
@@ -112,6 +190,9 @@ int main() {
         testTimestamp();
         testGenerateId();
         testDotfileReadWrite();
+        testAtomicWriteReplacesFile();
+        testGroupCommitBatchesConcurrentWrites();
+        testAtomicWriteMissingDirectoryThrows();
         testIsProjectDirectory();
         testFilesystemProjectDTO();
         testFilesystemFolderDTO();
@@ -124,19 +205,3 @@ int main() {
         return 1;
     }
 }
-cmake_minimum_required(VERSION 3.20)
-
-# Add test executable
-add_executable(test_filesystem_dtos
-    test_filesystem_dtos.cpp
-)
-
-# Link against the library
-target_link_libraries(test_filesystem_dtos
-    PRIVATE
-        PlotterFilesystemDTOs
-)
-
-# Add test
-add_test(NAME FilesystemDTOsTest COMMAND test_filesystem_dtos)
-
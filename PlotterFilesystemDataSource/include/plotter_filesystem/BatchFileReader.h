@@ -0,0 +1,83 @@
+#ifndef PLOTTER_FILESYSTEM_BATCH_FILE_READER_H
+#define PLOTTER_FILESYSTEM_BATCH_FILE_READER_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace plotter {
+namespace filesystem {
+
+/**
+ * @brief Outcome of reading one file in a batch
+ */
+struct BatchReadResult {
+    std::string content;
+    int error = 0;           // errno of the failing step, 0 on success
+
+    bool ok() const { return error == 0; }
+};
+
+/**
+ * @brief Reads many whole files at once
+ *
+ * On Linux (when built with PLOTTER_HAVE_IO_URING) the opens and reads of a
+ * whole window of files are submitted to an io_uring in two rounds, and each
+ * read lands directly in a buffer pre-sized from fstat(). Where io_uring is
+ * unavailable at build or run time (old kernels, kernels without the OPENAT
+ * and READ opcodes, seccomp-restricted containers, other platforms) a fixed
+ * thread pool issues the blocking calls in parallel instead. Files whose open
+ * or read the ring rejects with EINVAL or EOPNOTSUPP are retried on the pool.
+ *
+ * readAll() may be called from several threads; calls are serialised.
+ */
+class BatchFileReader {
+public:
+    enum class Backend {
+        IoUring,
+        ThreadPool
+    };
+
+    /**
+     * @param queueDepth Files in flight per io_uring window
+     * @param threads Thread pool size for the fallback (0 = hardware concurrency)
+     */
+    explicit BatchFileReader(size_t queueDepth = 64, size_t threads = 0);
+    ~BatchFileReader();
+
+    BatchFileReader(const BatchFileReader&) = delete;
+    BatchFileReader& operator=(const BatchFileReader&) = delete;
+
+    /**
+     * @brief Read every file completely
+     * @return One result per path, in the same order
+     */
+    std::vector<BatchReadResult> readAll(const std::vector<std::string>& paths);
+
+    Backend getBackend() const;
+
+    /**
+     * @brief Force the portable thread-pool path (mainly for tests)
+     */
+    void disableIoUring();
+
+private:
+    class Ring;
+    class ThreadPool;
+
+    void readWithRing(const std::vector<std::string>& paths, std::vector<BatchReadResult>& results);
+    void readWithThreadPool(const std::vector<std::string>& paths, std::vector<BatchReadResult>& results);
+
+    std::mutex mutex_;
+    size_t queueDepth_;
+    size_t threads_;
+    std::unique_ptr<Ring> ring_;
+    std::unique_ptr<ThreadPool> pool_;
+};
+
+} // namespace filesystem
+} // namespace plotter
+
+#endif // PLOTTER_FILESYSTEM_BATCH_FILE_READER_H
@@ -0,0 +1,108 @@
+#ifndef PLOTTER_FILESYSTEM_CONTENT_ADDRESSED_NOTE_STORAGE_H
+#define PLOTTER_FILESYSTEM_CONTENT_ADDRESSED_NOTE_STORAGE_H
+
+#include "NoteStorage.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace plotter {
+namespace filesystem {
+
+/**
+ * @brief Deduplicating NoteStorage that keeps each distinct body once
+ *
+ * Note bodies are stored as immutable blobs under <root>/.plotter_objects,
+ * named by a fast 64-bit content hash plus the body length. Note paths only
+ * reference blobs; the path -> blob mapping lives in an append-only refs log
+ * next to the objects and is compacted like the folder manifests. Identical
+ * bodies (templates, copied notes) therefore cost one file on disk and one
+ * copy in the page cache.
+ *
+ * Blobs are reference counted in memory. Overwriting or removing a note only
+ * drops a reference; unreferenced blobs are deleted by collectGarbage().
+ * Writers and the collector hold a FolderLock on the object store, and the
+ * refs log is replayed again whenever another process has changed it, so a
+ * collector never deletes a blob that someone else still references.
+ * Hash collisions are detected by comparing contents when a blob already
+ * exists, and resolved with a numeric suffix.
+ */
+class ContentAddressedNoteStorage : public NoteStorage {
+public:
+    static constexpr const char* OBJECTS_DIRECTORY = ".plotter_objects";
+
+    struct Stats {
+        size_t notes = 0;          // Paths with content
+        size_t blobs = 0;          // Referenced blobs
+        uint64_t dedupHits = 0;    // Saves that reused an existing blob
+    };
+
+    /**
+     * @param rootDir Workspace root; the object store is created inside it
+     */
+    explicit ContentAddressedNoteStorage(const std::string& rootDir);
+
+    std::string loadNote(const std::string& path) override;
+    void saveNote(const std::string& path, const std::string& content) override;
+    bool noteExists(const std::string& path) override;
+
+    /**
+     * @brief Drop the note at path
+     * @return False if no note was stored there
+     */
+    bool removeNote(const std::string& path);
+
+    /**
+     * @brief Delete every blob that no note references any more
+     *
+     * Counts references from the refs log on disk, not from this instance's
+     * view, so blobs saved by other processes sharing the root are kept.
+     * @return Number of blobs deleted
+     */
+    size_t collectGarbage();
+
+    /**
+     * @brief Hash key of the blob a note references, empty if none
+     */
+    std::string blobKeyFor(const std::string& path);
+
+    Stats getStats();
+
+    static uint64_t hashContent(const std::string& content);
+
+private:
+    struct LogStamp {
+        uint64_t inode = 0;
+        int64_t size = -1;       // -1 while the log does not exist
+        int64_t mtimeNs = 0;
+
+        bool operator==(const LogStamp& other) const {
+            return inode == other.inode && size == other.size && mtimeNs == other.mtimeNs;
+        }
+    };
+
+    std::string blobPath(const std::string& key) const;
+    std::string storeBlob(const std::string& content);
+    LogStamp stampRefs() const;
+    void loadRefs();
+    void syncRefs();
+    void appendRef(const std::string& line);
+    void compactRefs();
+    void release(const std::string& key);
+
+    std::mutex mutex_;
+    std::string objectsPath_;
+    std::string refsPath_;
+    std::unordered_map<std::string, std::string> refs_;     // note path -> blob key
+    std::unordered_map<std::string, size_t> refCounts_;     // blob key -> references
+    LogStamp refsStamp_;                                    // Refs log as last replayed or written
+    size_t refRecords_;
+    uint64_t dedupHits_;
+};
+
+} // namespace filesystem
+} // namespace plotter
+
+#endif // PLOTTER_FILESYSTEM_CONTENT_ADDRESSED_NOTE_STORAGE_H
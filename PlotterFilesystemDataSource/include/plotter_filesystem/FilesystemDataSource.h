@@ -5,6 +5,9 @@
 #include "plotter_repositories/FolderDataSource.h"
 #include "plotter_repositories/NoteDataSource.h"
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
+#include "plotter_filesystem/FolderManifest.h"
+#include "plotter_filesystem/FolderLock.h"
+#include "plotter_filesystem/BatchFileReader.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -26,6 +29,8 @@ private:
 
     std::string getProjectPath(const std::string& projectId) const;
     std::string getProjectMetadataPath(const std::string& projectId) const;
+    std::string lockProject(const std::string& projectId, std::unique_ptr<FolderLockSet>& lock,
+                            bool includeRoot) const;
     void ensureRootDirectoryExists();
 
 public:
@@ -40,10 +45,17 @@ public:
 
     // CRUD operations
     std::string create(dto::ProjectDTO* dto) override;
-    dto::ProjectDTO* read(const std::string& id) override;
+    dto::DTOPtr<dto::ProjectDTO> read(const std::string& id) override;
     bool update(const std::string& id, dto::ProjectDTO* dto) override;
     bool remove(const std::string& id) override;
-    std::vector<dto::ProjectDTO*> list() override;
+    dto::DTOList<dto::ProjectDTO> list() override;
+
+    /**
+     * @brief Bring back a project removed earlier, unless the trash was purged
+     * @return False if the trash holds nothing with this id
+     * @throws std::runtime_error if the original location is taken or gone
+     */
+    bool restore(const std::string& id);
 };
 
 /**
@@ -59,10 +71,14 @@ private:
 
     std::string getFolderPath(const std::string& folderId) const;
     std::string getFolderMetadataPath(const std::string& folderId) const;
+    std::string lockFolder(const std::string& folderId, std::unique_ptr<FolderLockSet>& lock,
+                           bool includeParent, const std::string& otherFolder = "") const;
     std::string resolveParentPath(const std::string& parentProjectId,
                                    const std::string& parentFolderId) const;
+    std::string lockParent(const std::string& parentProjectId, const std::string& parentFolderId,
+                           std::unique_ptr<FolderLock>& lock) const;
     void ensureRootDirectoryExists();
-    std::vector<dto::FolderDTO*> scanFoldersInDirectory(const std::string& dirPath) const;
+    dto::DTOList<dto::FolderDTO> scanFoldersInDirectory(const std::string& dirPath) const;
 
 public:
     FilesystemFolderDataSource(const std::string& name, const std::string& rootPath);
@@ -76,35 +92,80 @@ public:
 
     // CRUD operations
     std::string create(dto::FolderDTO* dto) override;
-    dto::FolderDTO* read(const std::string& id) override;
+    dto::DTOPtr<dto::FolderDTO> read(const std::string& id) override;
     bool update(const std::string& id, dto::FolderDTO* dto) override;
     bool remove(const std::string& id) override;
-    std::vector<dto::FolderDTO*> listByProject(const std::string& projectId) override;
-    std::vector<dto::FolderDTO*> listByParentFolder(const std::string& folderId) override;
+    dto::DTOList<dto::FolderDTO> listByProject(const std::string& projectId) override;
+    dto::DTOList<dto::FolderDTO> listByParentFolder(const std::string& folderId) override;
+
+    /**
+     * @brief Move a folder, with everything below it, under a new parent
+     *
+     * The directory is relocated with a single rename(), so the cost does not
+     * depend on the size of the subtree. Only the moved folder's metadata and
+     * the child lists of its old and new parent are rewritten; descendants
+     * keep their parentFolderId links, which stay valid.
+     * @param newParentProjectId Project to move to when newParentFolderId is empty
+     * @param newParentFolderId Folder to move into, or empty for a top-level folder
+     * @return False if the folder does not exist
+     */
+    bool move(const std::string& id, const std::string& newParentProjectId,
+              const std::string& newParentFolderId);
+
+    /**
+     * @brief Bring back a removed folder and its contents, unless the trash was purged
+     * @return False if the trash holds nothing with this id
+     * @throws std::runtime_error if the original location is taken or gone
+     */
+    bool restore(const std::string& id);
+};
+
+/**
+ * @brief Where note metadata is kept on disk
+ */
+enum class NoteMetadataLayout {
+    Sidecar,    // One .plotter_meta file next to each note
+    Manifest    // One append-only .plotter_manifest per folder
 };
 
 /**
  * @brief Filesystem-based data source for Notes
  *
- * Stores notes as regular files (e.g., .md, .txt) with companion
- * .plotter_meta files containing metadata.
+ * Stores notes as regular files (e.g., .md, .txt) with their metadata either
+ * in companion .plotter_meta files or in a per-folder manifest. Folders that
+ * already hold a manifest are always read from it, whatever the layout; the
+ * layout decides how folders without one are written.
  */
 class FilesystemNoteDataSource : public repositories::NoteDataSource {
 private:
+    struct NoteLocation {
+        std::string folderPath;
+        std::string notePath;
+        bool inManifest = false;
+        ManifestEntry entry;     // Only valid when inManifest
+    };
+
     std::string name_;
     std::string rootPath_;  // Root directory where projects are stored
     bool connected_;
     std::string defaultExtension_;  // Default file extension for notes (e.g., ".md")
+    NoteMetadataLayout layout_;
+    std::unique_ptr<BatchFileReader> batchReader_;  // Bulk content loads for loadContents
 
+    bool locateNote(const std::string& noteId, NoteLocation& location) const;
+    bool lockNote(const std::string& noteId, NoteLocation& location,
+                  std::unique_ptr<FolderLockSet>& lock, const std::string& otherFolder = "") const;
     std::string getNotePath(const std::string& noteId) const;
     std::string getNoteMetadataPath(const std::string& notePath) const;
     std::string resolveFolderPath(const std::string& folderId) const;
+    std::string lockFolder(const std::string& folderId, std::unique_ptr<FolderLock>& lock) const;
     void ensureRootDirectoryExists();
-    std::vector<dto::NoteDTO*> scanNotesInDirectory(const std::string& dirPath) const;
+    dto::DTOList<dto::NoteDTO> scanNotesInDirectory(const std::string& dirPath) const;
 
 public:
     FilesystemNoteDataSource(const std::string& name, const std::string& rootPath,
-                            const std::string& defaultExtension = ".md");
+                            const std::string& defaultExtension = ".md",
+                            NoteMetadataLayout layout = NoteMetadataLayout::Sidecar);
     virtual ~FilesystemNoteDataSource();
 
     // Connection management
@@ -115,14 +176,53 @@ public:
 
     // CRUD operations
     std::string create(dto::NoteDTO* dto) override;
-    dto::NoteDTO* read(const std::string& id) override;
+    dto::DTOPtr<dto::NoteDTO> read(const std::string& id) override;
     bool update(const std::string& id, dto::NoteDTO* dto) override;
     bool remove(const std::string& id) override;
-    std::vector<dto::NoteDTO*> listByFolder(const std::string& folderId) override;
+    dto::DTOList<dto::NoteDTO> listByFolder(const std::string& folderId) override;
 
     // Note-specific operations
     std::string getContent(const std::string& id) override;
     bool updateContent(const std::string& id, const std::string& content) override;
+
+    /**
+     * @brief Read the content of listed notes in one batch
+     *
+     * listByFolder leaves note files unread; a caller about to read many of
+     * the listed notes can fill them in here, through the BatchFileReader,
+     * instead of one file at a time. Notes that already have their content,
+     * and notes whose file cannot be read, are left as they are.
+     */
+    void loadContents(const dto::DTOList<dto::NoteDTO>& notes) const;
+
+    /**
+     * @brief Move a note into another folder
+     *
+     * The note file (and its sidecar, if any) is renamed into place rather
+     * than copied, and only the affected metadata records are patched. The
+     * destination's layout is honoured: a folder with a manifest receives a
+     * manifest entry, otherwise the note keeps a sidecar.
+     * @return False if the note does not exist
+     */
+    bool move(const std::string& id, const std::string& newFolderId);
+
+    /**
+     * @brief Bring back a note removed earlier, unless the trash was purged
+     * @return False if the trash holds nothing with this id
+     * @throws std::runtime_error if the original location is taken or gone
+     */
+    bool restore(const std::string& id);
+
+    NoteMetadataLayout getMetadataLayout() const { return layout_; }
+
+    /**
+     * @brief Convert every folder under the root from sidecars to manifests
+     *
+     * Also switches this data source to the manifest layout. Safe to re-run
+     * after an interruption.
+     * @return Number of notes migrated
+     */
+    size_t migrateToManifestLayout();
 };
 
 } // namespace filesystem
@@ -0,0 +1,102 @@
+#ifndef PLOTTER_FILESYSTEM_NOTE_STORAGE_H
+#define PLOTTER_FILESYSTEM_NOTE_STORAGE_H
+
+#include "NoteStorage.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <filesystem>
+#include <cstddef>
+
+namespace plotter {
+namespace filesystem {
+
+/**
+ * @brief How FilesystemNoteStorage maps note paths to files.
+ */
+enum class NoteStorageLayout {
+    Flat,       // <base>/<path>, exactly as given
+    Sharded     // <base>/.plotter_shards/ab/cd/<escaped path>, fanned out by hash
+};
+
+/**
+ * @brief Filesystem-based implementation of NoteStorage.
+ *
+ * Stores notes as text files on disk, allowing notes to be loaded
+ * lazily only when accessed. This prevents loading all notes into memory.
+ *
+ * In the sharded layout each note is placed in one of 65536 directories
+ * chosen by a hash of its path, so no directory grows past a few entries
+ * per thousand notes and lookups stay fast as the store grows. Lookups are
+ * transparent: a note is found in either layout, and saving in the sharded
+ * layout moves a flat note to its shard.
+ *
+ * This is an INFRASTRUCTURE component and should NOT be in the domain layer.
+ */
+class FilesystemNoteStorage : public NoteStorage {
+private:
+    std::string baseDirectory;
+    NoteStorageLayout layout;
+
+    std::string flatPath(const std::string& path) const;
+    std::string shardedPath(const std::string& path) const;
+    std::string resolvePath(const std::string& path) const;
+
+public:
+    static constexpr const char* SHARDS_DIRECTORY = ".plotter_shards";
+
+    /**
+     * @brief Construct a new FilesystemNoteStorage object.
+     *
+     * @param baseDir The base directory where notes will be stored
+     * @param layout Where newly saved notes are written; ignored once the
+     *        directory has been migrated to the sharded layout
+     */
+    explicit FilesystemNoteStorage(const std::string& baseDir,
+                                   NoteStorageLayout layout = NoteStorageLayout::Flat);
+
+    /**
+     * @brief Load note content from a file.
+     *
+     * @param path Relative path to the note file (relative to baseDirectory)
+     * @return The content of the note
+     * @throws std::runtime_error if the file cannot be read
+     */
+    std::string loadNote(const std::string& path) override;
+
+    /**
+     * @brief Save note content to a file.
+     *
+     * @param path Relative path to the note file (relative to baseDirectory)
+     * @param content The content to write
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void saveNote(const std::string& path, const std::string& content) override;
+
+    /**
+     * @brief Check if a note file exists.
+     *
+     * @param path Relative path to the note file
+     * @return true if the file exists, false otherwise
+     */
+    bool noteExists(const std::string& path) override;
+
+    NoteStorageLayout getLayout() const { return layout; }
+
+    /**
+     * @brief Move every flat note into its shard and switch to the sharded layout
+     *
+     * Notes are renamed, not copied. Safe to re-run after an interruption.
+     * The choice is recorded in the base directory, so every storage opened
+     * on it afterwards uses the sharded layout too. Dot directories are left
+     * alone.
+     * @return Number of notes moved
+     */
+    size_t migrateToShardedLayout();
+};
+
+} // namespace filesystem
+} // namespace plotter
+
+#endif // PLOTTER_FILESYSTEM_NOTE_STORAGE_H
+
@@ -0,0 +1,72 @@
+#ifndef PLOTTER_FILESYSTEM_FOLDER_LOCK_H
+#define PLOTTER_FILESYSTEM_FOLDER_LOCK_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace plotter {
+namespace filesystem {
+
+/**
+ * @brief Advisory lock on one directory, shared between processes
+ *
+ * Locks the hidden .plotter_lock file inside the directory with an open file
+ * description lock (fcntl F_OFD_SETLKW) where the platform has them, and with
+ * flock() otherwise. Both kinds belong to the open file rather than to the
+ * process, so the lock excludes other threads of this process as well as
+ * other processes, and it is released automatically if the holder dies.
+ *
+ * Locks are re-entrant per thread: taking a lock the calling thread already
+ * holds (e.g. a manifest update inside a locked note operation) is a no-op.
+ * A shared lock cannot be upgraded to an exclusive one.
+ */
+class FolderLock {
+public:
+    enum class Mode {
+        Shared,
+        Exclusive
+    };
+
+    static constexpr const char* FILENAME = ".plotter_lock";
+
+    /**
+     * @brief Block until the lock on folderPath is acquired
+     * @throws std::runtime_error if the lock file cannot be opened or locked
+     */
+    explicit FolderLock(const std::string& folderPath, Mode mode = Mode::Exclusive);
+    ~FolderLock();
+
+    FolderLock(const FolderLock&) = delete;
+    FolderLock& operator=(const FolderLock&) = delete;
+
+    /**
+     * @brief Whether the calling thread holds a lock on folderPath
+     */
+    static bool isHeld(const std::string& folderPath);
+
+private:
+    std::string folderPath_;
+    int fd_;                 // -1 for a re-entrant acquisition
+};
+
+/**
+ * @brief Locks several directories without risking deadlock
+ *
+ * The folders are locked in lexicographic path order, which every process
+ * uses, so two operations on overlapping sets cannot wait on each other.
+ * Take the set before any other folder lock, not inside one.
+ */
+class FolderLockSet {
+public:
+    explicit FolderLockSet(std::vector<std::string> folderPaths,
+                           FolderLock::Mode mode = FolderLock::Mode::Exclusive);
+
+private:
+    std::vector<std::unique_ptr<FolderLock>> locks_;
+};
+
+} // namespace filesystem
+} // namespace plotter
+
+#endif // PLOTTER_FILESYSTEM_FOLDER_LOCK_H
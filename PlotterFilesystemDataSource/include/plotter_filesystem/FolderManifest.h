@@ -0,0 +1,94 @@
+#ifndef PLOTTER_FILESYSTEM_FOLDER_MANIFEST_H
+#define PLOTTER_FILESYSTEM_FOLDER_MANIFEST_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace plotter {
+namespace filesystem {
+
+/**
+ * @brief Metadata of one note as recorded in a folder manifest
+ */
+struct ManifestEntry {
+    std::string id;
+    std::string name;
+    std::string file;            // Note filename relative to the folder
+    std::string parentFolderId;
+    long long createdAt = 0;
+    long long updatedAt = 0;
+};
+
+/**
+ * @brief Single-file metadata store for all notes of one folder
+ *
+ * Replaces the per-note .plotter_meta sidecars with one .plotter_manifest file
+ * holding one compact JSON record per line. Writes only ever append a "put" or
+ * "del" record; once dead records outweigh live ones the file is compacted by
+ * rewriting it atomically. Listing a folder therefore costs a single read.
+ *
+ * The replayed log is kept in memory per process, indexed by id, and each
+ * append is applied to it directly. The file is parsed again only when its
+ * size, mtime or inode shows that another process changed it, so a run of
+ * puts costs one append each instead of a re-read.
+ *
+ * A torn final line (crash mid-append) is ignored on load and cut off before
+ * the next append. Mutations hold the folder's FolderLock, so processes
+ * sharing a root never lose each other's records when one of them compacts.
+ */
+class FolderManifest {
+public:
+    static constexpr const char* FILENAME = ".plotter_manifest";
+
+    explicit FolderManifest(const std::string& folderPath);
+
+    static bool exists(const std::string& folderPath);
+
+    /**
+     * @brief Load the live entries, in the order notes were first added
+     */
+    std::vector<ManifestEntry> load() const;
+
+    /**
+     * @brief Find a single entry
+     * @return True and fills out if the id is present
+     */
+    bool find(const std::string& id, ManifestEntry& out) const;
+
+    /**
+     * @brief Insert or replace the entry with the same id
+     */
+    void put(const ManifestEntry& entry);
+
+    /**
+     * @brief Drop an entry
+     * @return False if the id was not present
+     */
+    bool remove(const std::string& id);
+
+    /**
+     * @brief Rewrite the manifest with live entries only
+     */
+    void compact();
+
+    /**
+     * @brief Fold the folder's .plotter_meta sidecars into its manifest
+     *
+     * The manifest is made durable before any sidecar is deleted, so an
+     * interrupted migration can simply be run again.
+     * @return Number of notes migrated
+     */
+    static size_t migrateFromSidecars(const std::string& folderPath);
+
+    const std::string& getPath() const { return manifestPath_; }
+
+private:
+    std::string folderPath_;
+    std::string manifestPath_;
+};
+
+} // namespace filesystem
+} // namespace plotter
+
+#endif // PLOTTER_FILESYSTEM_FOLDER_MANIFEST_H
@@ -0,0 +1,97 @@
+#ifndef PLOTTER_FILESYSTEM_METADATA_CACHE_H
+#define PLOTTER_FILESYSTEM_METADATA_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <json/json.h>
+
+namespace plotter {
+namespace filesystem {
+
+/**
+ * @brief Process-wide cache of parsed metadata files
+ *
+ * Entries are keyed by path and validated against the file's mtime, size and
+ * inode on every lookup, so a stat() replaces open + read + parse whenever the
+ * file is unchanged. Atomic rewrites (temp file + rename) always produce a new
+ * inode and therefore never serve stale data. Memory is bounded by an LRU
+ * budget based on an estimate of each parsed value's footprint.
+ */
+class MetadataCache {
+public:
+    /**
+     * @brief Turns raw file content into a Json::Value; returns false on malformed input
+     */
+    using Parser = bool (*)(const std::string& content, Json::Value& out);
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;         // Estimated footprint of cached values
+    };
+
+    static constexpr size_t DEFAULT_BUDGET = 8 * 1024 * 1024;
+
+    static MetadataCache& instance();
+
+    /**
+     * @brief Parsed content of a JSON metadata file
+     * @return nullptr if the file is missing or cannot be parsed
+     */
+    std::shared_ptr<const Json::Value> load(const std::string& path);
+
+    /**
+     * @brief Parsed content of a file in a non-JSON format
+     *
+     * A path must always be loaded with the same parser.
+     */
+    std::shared_ptr<const Json::Value> load(const std::string& path, Parser parser);
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+
+    void clear();
+    Stats getStats() const;
+
+private:
+    struct FileStamp {
+        uint64_t device = 0;
+        uint64_t inode = 0;
+        int64_t mtimeNs = 0;
+        int64_t size = 0;
+
+        bool operator==(const FileStamp& other) const {
+            return device == other.device && inode == other.inode &&
+                   mtimeNs == other.mtimeNs && size == other.size;
+        }
+    };
+
+    struct Entry {
+        FileStamp stamp;
+        std::shared_ptr<const Json::Value> value;
+        size_t cost;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    MetadataCache();
+
+    void evictToBudget();
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_;   // Most recently used at the front
+    size_t budget_;
+    Stats stats_;
+};
+
+} // namespace filesystem
+} // namespace plotter
+
+#endif // PLOTTER_FILESYSTEM_METADATA_CACHE_H
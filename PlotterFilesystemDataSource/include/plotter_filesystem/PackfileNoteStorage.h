@@ -0,0 +1,145 @@
+#ifndef PLOTTER_FILESYSTEM_PACKFILE_NOTE_STORAGE_H
+#define PLOTTER_FILESYSTEM_PACKFILE_NOTE_STORAGE_H
+
+#include "NoteStorage.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace plotter {
+namespace filesystem {
+
+/**
+ * @brief NoteStorage that packs many small notes into a few large files
+ *
+ * Every save appends a record (header, path, body) to the active pack under
+ * <root>/.plotter_packs; removals append a tombstone. Once the active pack
+ * reaches its size limit it is sealed: a sorted index of path hashes is
+ * written next to it and both files are memory-mapped, so a read from a
+ * sealed pack is a binary search in the index plus a copy out of the pack.
+ * The small packs.list file names the packs in age order, so opening the
+ * store reads that list, maps the sealed packs and replays only the active
+ * one - no directory walk.
+ *
+ * Overwritten records and tombstones are dead weight until repack() merges
+ * the sealed packs into one that holds only live notes. The merge runs
+ * without blocking readers or writers, and can be scheduled in the
+ * background with startBackgroundRepack().
+ */
+class PackfileNoteStorage : public NoteStorage {
+public:
+    static constexpr const char* PACKS_DIRECTORY = ".plotter_packs";
+    static constexpr uint64_t DEFAULT_PACK_SIZE = 64 * 1024 * 1024;
+
+    struct Stats {
+        size_t packs = 0;            // Sealed packs plus the active one
+        uint64_t totalBytes = 0;     // Bytes in all packs
+        uint64_t deadBytes = 0;      // Overwritten records and tombstones
+        uint64_t repacks = 0;        // Completed repack() runs
+    };
+
+    /**
+     * @param rootDir Workspace root; the packs are kept inside it
+     * @param maxPackSize Size at which the active pack is sealed
+     * @throws std::runtime_error if the store cannot be opened
+     */
+    explicit PackfileNoteStorage(const std::string& rootDir, uint64_t maxPackSize = DEFAULT_PACK_SIZE);
+    ~PackfileNoteStorage();
+
+    PackfileNoteStorage(const PackfileNoteStorage&) = delete;
+    PackfileNoteStorage& operator=(const PackfileNoteStorage&) = delete;
+
+    std::string loadNote(const std::string& path) override;
+    void saveNote(const std::string& path, const std::string& content) override;
+    bool noteExists(const std::string& path) override;
+
+    /**
+     * @brief Write a tombstone for the note at path
+     * @return False if no note was stored there
+     */
+    bool removeNote(const std::string& path);
+
+    /**
+     * @brief Seal the active pack now, even if it is below the size limit
+     */
+    void seal();
+
+    /**
+     * @brief Merge all sealed packs into one that holds only live notes
+     * @return Bytes reclaimed
+     */
+    uint64_t repack();
+
+    /**
+     * @brief Repack from a background thread whenever dead bytes exceed deadRatio of the store
+     */
+    void startBackgroundRepack(double deadRatio = 0.5,
+                               std::chrono::milliseconds interval = std::chrono::seconds(30));
+    void stopBackgroundRepack();
+
+    Stats getStats() const;
+
+private:
+    struct SealedPack;
+
+    struct ActiveEntry {
+        uint64_t offset;
+        uint32_t size;           // Whole record, header included
+        bool tombstone;
+    };
+
+    struct Found {
+        uint32_t size = 0;
+        bool tombstone = false;
+    };
+
+    struct FileHandle {
+        int fd;
+        explicit FileHandle(int descriptor) : fd(descriptor) {}
+        ~FileHandle();
+    };
+
+    bool findLocked(const std::string& path, Found& found, std::string* content) const;
+    void countDeadLocked(const std::string& path, uint64_t tombstoneSize);
+    void appendLocked(const std::string& path, const std::string* content);
+    void sealLocked();
+    void openActiveLocked(const std::string& name, bool replay);
+    void writeListLocked();
+    std::string nextPackNameLocked();
+    std::shared_ptr<const SealedPack> openSealed(const std::string& name) const;
+    void removeOrphansLocked() const;
+
+    std::string packsPath_;
+    uint64_t maxPackSize_;
+
+    mutable std::shared_mutex mutex_;
+    std::vector<std::shared_ptr<const SealedPack>> packs_;   // Oldest first
+    std::string activeName_;
+    std::shared_ptr<FileHandle> activeFile_;
+    uint64_t activeSize_;
+    std::unordered_map<std::string, ActiveEntry> activeIndex_;
+    uint64_t nextSequence_;
+    uint64_t sealedBytes_;
+    uint64_t deadBytes_;
+    uint64_t activeDeadBytes_;   // Part of deadBytes_ caused by records in the active pack
+    uint64_t repacks_;
+
+    std::mutex repackMutex_;                 // One repack at a time
+    std::thread repacker_;
+    std::mutex repackerMutex_;
+    std::condition_variable repackerWake_;
+    bool stopRepacker_;
+};
+
+} // namespace filesystem
+} // namespace plotter
+
+#endif // PLOTTER_FILESYSTEM_PACKFILE_NOTE_STORAGE_H
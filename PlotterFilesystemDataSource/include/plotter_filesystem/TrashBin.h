@@ -0,0 +1,116 @@
+#ifndef PLOTTER_FILESYSTEM_TRASH_BIN_H
+#define PLOTTER_FILESYSTEM_TRASH_BIN_H
+
+#include "plotter_filesystem/FolderManifest.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace plotter {
+namespace filesystem {
+
+/**
+ * @brief Rate limit for purging the trash: pause after every filesPerTick unlinks
+ */
+struct PurgeThrottle {
+    size_t filesPerTick = 256;
+    std::chrono::milliseconds pause{10};
+};
+
+/**
+ * @brief Soft-delete area of a filesystem root
+ *
+ * Deleting a project, folder or note moves its files into
+ * <root>/.plotter_trash/<deletedAt>-<id>/ with rename(), so the delete costs
+ * the same whatever the size of the subtree. A .plotter_trashinfo file next to
+ * the moved items records where they came from, so restore() can put them
+ * back until they are purged.
+ *
+ * Space is reclaimed by purgeExpired(), either on demand or from a background
+ * purger that unlinks a bounded number of files per tick so that purging a
+ * huge project never saturates the disk. Restoring and purging claim an
+ * entry by renaming it first, so they are safe to run from different
+ * processes at once.
+ */
+class TrashBin {
+public:
+    static constexpr const char* DIRECTORY = ".plotter_trash";
+
+    struct Entry {
+        std::string id;
+        std::string kind;           // "project", "folder" or "note"
+        long long deletedAt = 0;
+        std::vector<std::string> originalPaths;
+        std::string path;           // Entry directory inside the trash
+    };
+
+    using Throttle = PurgeThrottle;
+
+    explicit TrashBin(const std::string& rootPath);
+    ~TrashBin();
+
+    TrashBin(const TrashBin&) = delete;
+    TrashBin& operator=(const TrashBin&) = delete;
+
+    /**
+     * @brief Move paths into a new trash entry
+     *
+     * The caller holds the locks of the folders involved.
+     * @param manifestEntry Manifest record of a trashed note, restored with it
+     * @throws std::runtime_error if a path cannot be moved
+     */
+    void trash(const std::string& kind, const std::string& id,
+               const std::vector<std::string>& paths,
+               const ManifestEntry* manifestEntry = nullptr);
+
+    /**
+     * @brief Put the most recently trashed entity with this id back in place
+     * @return False if nothing with this id is in the trash
+     * @throws std::runtime_error if the original location is taken or gone, or
+     *         the entry cannot be claimed
+     */
+    bool restore(const std::string& id);
+
+    std::vector<Entry> list() const;
+
+    /**
+     * @brief Delete entries trashed more than retention ago
+     *
+     * First finishes any restore whose process died after claiming its entry.
+     * @return Number of entries purged
+     */
+    size_t purgeExpired(std::chrono::milliseconds retention, const Throttle& throttle = unthrottled());
+
+    /**
+     * @brief Purge expired entries from a background thread, throttled
+     */
+    void startPurger(std::chrono::milliseconds retention,
+                     std::chrono::milliseconds interval = std::chrono::minutes(1),
+                     const Throttle& throttle = Throttle());
+    void stopPurger();
+
+    static Throttle unthrottled();
+
+private:
+    bool readEntry(const std::string& entryPath, Entry& entry) const;
+    bool purgeEntry(const std::string& entryPath, const Throttle& throttle);
+    void finishRestore(const std::string& claimedPath, const Entry& entry);
+    void recoverRestores();
+
+    std::string rootPath_;
+    std::string trashPath_;
+
+    std::thread purger_;
+    std::mutex purgerMutex_;
+    std::condition_variable purgerWake_;
+    bool stopPurger_;
+};
+
+} // namespace filesystem
+} // namespace plotter
+
+#endif // PLOTTER_FILESYSTEM_TRASH_BIN_H
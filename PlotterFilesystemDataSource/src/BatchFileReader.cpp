@@ -0,0 +1,523 @@
+#include "plotter_filesystem/BatchFileReader.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef PLOTTER_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace plotter {
+namespace filesystem {
+
+namespace {
+
+// Size the buffer from the open descriptor so a concurrent atomic replace of
+// the path cannot pair one file's size with another file's contents.
+bool presize(int fd, BatchReadResult& result) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        result.error = errno;
+        return false;
+    }
+    result.content.resize(static_cast<size_t>(st.st_size));
+    return true;
+}
+
+void readOneFile(const std::string& path, BatchReadResult& result) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        result.error = errno;
+        return;
+    }
+
+    if (presize(fd, result)) {
+        size_t done = 0;
+        while (done < result.content.size()) {
+            ssize_t n = ::pread(fd, &result.content[done], result.content.size() - done,
+                                static_cast<off_t>(done));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                result.error = errno;
+                break;
+            }
+            if (n == 0) {
+                result.content.resize(done);  // File shrank underneath us
+                break;
+            }
+            done += static_cast<size_t>(n);
+        }
+    }
+
+    ::close(fd);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Thread pool fallback
+// ---------------------------------------------------------------------------
+
+class BatchFileReader::ThreadPool {
+public:
+    explicit ThreadPool(size_t threads) {
+        for (size_t i = 0; i < threads; i++) {
+            workers_.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // Runs task(0..count-1) across the pool; the calling thread helps out.
+    void run(size_t count, const std::function<void(size_t)>& task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            count_ = count;
+            next_.store(0);
+            active_ = workers_.size();
+            generation_++;
+        }
+        wake_.notify_all();
+
+        drain();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return active_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    void drain() {
+        for (size_t i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+            (*task_)(i);
+        }
+    }
+
+    void workerLoop() {
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+            }
+
+            drain();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ == 0) {
+                done_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t count_ = 0;
+    std::atomic<size_t> next_{0};
+    size_t active_ = 0;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+};
+
+// ---------------------------------------------------------------------------
+// io_uring backend (raw syscalls, no liburing dependency)
+// ---------------------------------------------------------------------------
+
+#ifdef PLOTTER_HAVE_IO_URING
+
+namespace {
+
+// The ring rejects an opcode it cannot run for this file (a filesystem
+// without async support, a seccomp filter); the blocking syscall may still work
+bool retryWithoutRing(int res) {
+    return res == -EINVAL || res == -EOPNOTSUPP;
+}
+
+} // namespace
+
+class BatchFileReader::Ring {
+public:
+    static std::unique_ptr<Ring> create(unsigned entries) {
+        std::unique_ptr<Ring> ring(new Ring());
+        if (!ring->setup(entries)) {
+            return nullptr;
+        }
+        return ring;
+    }
+
+    ~Ring() {
+        if (sqes_ != MAP_FAILED) {
+            ::munmap(sqes_, sqesSize_);
+        }
+        if (cqPtr_ != MAP_FAILED && cqPtr_ != sqPtr_) {
+            ::munmap(cqPtr_, cqSize_);
+        }
+        if (sqPtr_ != MAP_FAILED) {
+            ::munmap(sqPtr_, sqSize_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    unsigned capacity() const { return entries_; }
+
+    io_uring_sqe* nextSqe() {
+        unsigned head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+        if (localTail_ - head >= entries_) {
+            return nullptr;
+        }
+        unsigned index = localTail_ & *sqMask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray_[index] = index;
+        localTail_++;
+        return sqe;
+    }
+
+    // Submits everything queued and blocks until at least minComplete CQEs are available
+    bool submit(unsigned minComplete) {
+        __atomic_store_n(sqTail_, localTail_, __ATOMIC_RELEASE);
+        unsigned toSubmit = localTail_ - submitted_;
+        while (true) {
+            long ret = ::syscall(__NR_io_uring_enter, fd_, toSubmit, minComplete,
+                                 IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (ret < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            submitted_ += static_cast<unsigned>(ret);
+            toSubmit -= static_cast<unsigned>(ret);
+            if (toSubmit == 0) {
+                return true;
+            }
+            if (ret == 0) {
+                return false;
+            }
+            minComplete = 0;
+        }
+    }
+
+    bool popCompletion(uint64_t& userData, int& result) {
+        unsigned head = *cqHead_;
+        if (head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        const io_uring_cqe& cqe = cqes_[head & *cqMask_];
+        userData = cqe.user_data;
+        result = cqe.res;
+        __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Collects exactly `count` completions, waiting as needed
+    template <typename Handler>
+    bool complete(unsigned count, Handler&& handler) {
+        while (count > 0) {
+            uint64_t userData;
+            int result;
+            if (popCompletion(userData, result)) {
+                handler(userData, result);
+                count--;
+                continue;
+            }
+            if (!submit(1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    Ring() = default;
+
+    bool setup(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0) {
+            return false;
+        }
+        entries_ = params.sq_entries;
+
+        sqSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMmap) {
+            sqSize_ = cqSize_ = std::max(sqSize_, cqSize_);
+        }
+
+        sqPtr_ = ::mmap(nullptr, sqSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        fd_, IORING_OFF_SQ_RING);
+        if (sqPtr_ == MAP_FAILED) {
+            return false;
+        }
+        cqPtr_ = singleMmap ? sqPtr_
+                            : ::mmap(nullptr, cqSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                     fd_, IORING_OFF_CQ_RING);
+        if (cqPtr_ == MAP_FAILED) {
+            return false;
+        }
+
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return false;
+        }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        char* sq = static_cast<char*>(sqPtr_);
+        sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        localTail_ = submitted_ = *sqTail_;
+
+        char* cq = static_cast<char*>(cqPtr_);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return supports({IORING_OP_OPENAT, IORING_OP_READ});
+    }
+
+    // A ring can exist on kernels that predate the opcodes we rely on
+    bool supports(std::initializer_list<unsigned> opcodes) const {
+        constexpr unsigned PROBE_OPS = 256;
+        std::vector<unsigned char> buffer(sizeof(io_uring_probe) + PROBE_OPS * sizeof(io_uring_probe_op));
+        io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+        if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe, PROBE_OPS) < 0) {
+            return false;  // Probing arrived after OPENAT/READ, so those are missing too
+        }
+        for (unsigned opcode : opcodes) {
+            if (opcode > probe->last_op || opcode >= probe->ops_len ||
+                !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int fd_ = -1;
+    unsigned entries_ = 0;
+    void* sqPtr_ = MAP_FAILED;
+    void* cqPtr_ = MAP_FAILED;
+    io_uring_sqe* sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqSize_ = 0;
+    size_t cqSize_ = 0;
+    size_t sqesSize_ = 0;
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqMask_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned* cqMask_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned localTail_ = 0;
+    unsigned submitted_ = 0;
+};
+
+void BatchFileReader::readWithRing(const std::vector<std::string>& paths,
+                                   std::vector<BatchReadResult>& results) {
+    const size_t window = ring_->capacity();
+
+    for (size_t start = 0; start < paths.size(); start += window) {
+        const size_t count = std::min(window, paths.size() - start);
+        std::vector<int> fds(count, -1);
+        std::vector<size_t> done(count, 0);
+        std::vector<size_t> retry;
+
+        // Round 1: open the whole window at once
+        for (size_t i = 0; i < count; i++) {
+            io_uring_sqe* sqe = ring_->nextSqe();
+            sqe->opcode = IORING_OP_OPENAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = reinterpret_cast<uint64_t>(paths[start + i].c_str());
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+            sqe->user_data = i;
+        }
+        bool ringOk = ring_->submit(static_cast<unsigned>(count)) &&
+                      ring_->complete(static_cast<unsigned>(count), [&](uint64_t i, int res) {
+                          if (retryWithoutRing(res)) {
+                              retry.push_back(i);
+                          } else if (res < 0) {
+                              results[start + i].error = -res;
+                          } else {
+                              fds[i] = res;
+                          }
+                      });
+
+        // Round 2: read each file into its pre-sized buffer, resubmitting short reads
+        unsigned outstanding = 0;
+        auto queueRead = [&](size_t i) {
+            BatchReadResult& result = results[start + i];
+            io_uring_sqe* sqe = ring_->nextSqe();
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = fds[i];
+            sqe->addr = reinterpret_cast<uint64_t>(&result.content[done[i]]);
+            sqe->len = static_cast<uint32_t>(
+                std::min<size_t>(result.content.size() - done[i], UINT32_MAX));
+            sqe->off = done[i];
+            sqe->user_data = i;
+            outstanding++;
+        };
+
+        for (size_t i = 0; ringOk && i < count; i++) {
+            if (fds[i] >= 0 && presize(fds[i], results[start + i]) && !results[start + i].content.empty()) {
+                queueRead(i);
+            }
+        }
+        while (ringOk && outstanding > 0) {
+            unsigned batch = outstanding;
+            outstanding = 0;
+            ringOk = ring_->submit(batch) && ring_->complete(batch, [&](uint64_t i, int res) {
+                BatchReadResult& result = results[start + i];
+                if (res == -EINTR || res == -EAGAIN) {
+                    queueRead(i);
+                } else if (retryWithoutRing(res)) {
+                    retry.push_back(i);
+                } else if (res < 0) {
+                    result.error = -res;
+                } else if (res == 0) {
+                    result.content.resize(done[i]);  // File shrank underneath us
+                } else {
+                    done[i] += static_cast<size_t>(res);
+                    if (done[i] < result.content.size()) {
+                        queueRead(i);
+                    }
+                }
+            });
+        }
+
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+
+        if (!ringOk) {
+            // The ring itself failed; finish this window and the rest synchronously
+            ring_.reset();
+            for (size_t i = start; i < paths.size(); i++) {
+                results[i] = BatchReadResult();
+            }
+            std::vector<std::string> rest(paths.begin() + start, paths.end());
+            std::vector<BatchReadResult> restResults(rest.size());
+            readWithThreadPool(rest, restResults);
+            std::move(restResults.begin(), restResults.end(), results.begin() + start);
+            return;
+        }
+
+        if (!retry.empty()) {
+            std::vector<std::string> retryPaths;
+            for (size_t i : retry) {
+                retryPaths.push_back(paths[start + i]);
+            }
+            std::vector<BatchReadResult> retryResults(retry.size());
+            readWithThreadPool(retryPaths, retryResults);
+            for (size_t k = 0; k < retry.size(); k++) {
+                results[start + retry[k]] = std::move(retryResults[k]);
+            }
+        }
+    }
+}
+
+#else
+
+class BatchFileReader::Ring {};
+
+void BatchFileReader::readWithRing(const std::vector<std::string>& paths,
+                                   std::vector<BatchReadResult>& results) {
+    readWithThreadPool(paths, results);
+}
+
+#endif // PLOTTER_HAVE_IO_URING
+
+// ---------------------------------------------------------------------------
+
+BatchFileReader::BatchFileReader(size_t queueDepth, size_t threads)
+    : queueDepth_(std::max<size_t>(queueDepth, 1)),
+      threads_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+#ifdef PLOTTER_HAVE_IO_URING
+    ring_ = Ring::create(static_cast<unsigned>(queueDepth_));
+#endif
+}
+
+BatchFileReader::~BatchFileReader() = default;
+
+BatchFileReader::Backend BatchFileReader::getBackend() const {
+    return ring_ ? Backend::IoUring : Backend::ThreadPool;
+}
+
+void BatchFileReader::disableIoUring() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_.reset();
+}
+
+std::vector<BatchReadResult> BatchFileReader::readAll(const std::vector<std::string>& paths) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<BatchReadResult> results(paths.size());
+    if (paths.empty()) {
+        return results;
+    }
+
+    if (ring_) {
+        readWithRing(paths, results);
+    } else {
+        readWithThreadPool(paths, results);
+    }
+    return results;
+}
+
+void BatchFileReader::readWithThreadPool(const std::vector<std::string>& paths,
+                                         std::vector<BatchReadResult>& results) {
+    if (paths.size() == 1) {
+        readOneFile(paths[0], results[0]);
+        return;
+    }
+
+    if (!pool_) {
+        // The calling thread also works, so the pool needs one thread fewer
+        pool_.reset(new ThreadPool(threads_ > 1 ? threads_ - 1 : 0));
+    }
+    std::function<void(size_t)> task = [&](size_t i) { readOneFile(paths[i], results[i]); };
+    pool_->run(paths.size(), task);
+}
+
+} // namespace filesystem
+} // namespace plotter
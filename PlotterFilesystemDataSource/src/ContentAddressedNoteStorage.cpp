@@ -0,0 +1,315 @@
+#include "plotter_filesystem/ContentAddressedNoteStorage.h"
+#include "plotter_filesystem/FolderLock.h"
+#include "plotter_filesystem_dtos/AtomicFileWriter.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <sys/stat.h>
+
+namespace fs = std::filesystem;
+using plotter::filesystem_dtos::AtomicFileWriter;
+
+namespace plotter {
+namespace filesystem {
+
+namespace {
+
+constexpr const char* REFS_FILENAME = "refs";
+
+// Rewrite the refs log once it holds this many more records than live refs
+constexpr size_t COMPACTION_SLACK = 64;
+
+constexpr uint64_t PRIME_1 = 0xa0761d6478bd642fULL;
+constexpr uint64_t PRIME_2 = 0xe7037ed1a0b428dbULL;
+constexpr uint64_t PRIME_3 = 0x8ebc6af09c88c6e3ULL;
+
+inline uint64_t mix(uint64_t a, uint64_t b) {
+    __uint128_t product = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+}
+
+inline uint64_t read64(const char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open blob: " + path);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+void validatePath(const std::string& path) {
+    if (path.empty() || path.find_first_of("\t\n") != std::string::npos) {
+        throw std::runtime_error("Invalid note path for content-addressed storage: '" + path + "'");
+    }
+}
+
+} // namespace
+
+uint64_t ContentAddressedNoteStorage::hashContent(const std::string& content) {
+    // Multiply-fold hash over 16-byte stripes; fast and well mixed, not cryptographic
+    const char* p = content.data();
+    size_t remaining = content.size();
+    uint64_t h = PRIME_1 ^ mix(content.size(), PRIME_2);
+
+    while (remaining >= 16) {
+        h = mix(read64(p) ^ PRIME_2, read64(p + 8) ^ h);
+        p += 16;
+        remaining -= 16;
+    }
+    if (remaining >= 8) {
+        h = mix(read64(p) ^ PRIME_3, h ^ PRIME_1);
+        p += 8;
+        remaining -= 8;
+    }
+    if (remaining > 0) {
+        uint64_t tail = 0;
+        std::memcpy(&tail, p, remaining);
+        h = mix(tail ^ PRIME_1, h ^ PRIME_3);
+    }
+    return mix(h ^ PRIME_2, PRIME_1 ^ content.size());
+}
+
+ContentAddressedNoteStorage::ContentAddressedNoteStorage(const std::string& rootDir)
+    : objectsPath_(rootDir + "/" + OBJECTS_DIRECTORY),
+      refsPath_(objectsPath_ + "/" + REFS_FILENAME),
+      refRecords_(0),
+      dedupHits_(0) {
+    fs::create_directories(objectsPath_);
+    loadRefs();
+}
+
+std::string ContentAddressedNoteStorage::blobPath(const std::string& key) const {
+    return objectsPath_ + "/" + key.substr(0, 2) + "/" + key;
+}
+
+ContentAddressedNoteStorage::LogStamp ContentAddressedNoteStorage::stampRefs() const {
+    LogStamp stamp;
+    struct stat st;
+    if (::stat(refsPath_.c_str(), &st) != 0) {
+        return stamp;
+    }
+    stamp.inode = static_cast<uint64_t>(st.st_ino);
+    stamp.size = static_cast<int64_t>(st.st_size);
+#ifdef __APPLE__
+    stamp.mtimeNs = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    stamp.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    return stamp;
+}
+
+void ContentAddressedNoteStorage::loadRefs() {
+    refs_.clear();
+    refCounts_.clear();
+    refRecords_ = 0;
+    refsStamp_ = stampRefs();
+
+    std::ifstream file(refsPath_, std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string content = buffer.str();
+
+    // Only newline-terminated records count; anything after the last newline is a torn append
+    size_t start = 0;
+    for (size_t end = content.find('\n'); end != std::string::npos;
+         start = end + 1, end = content.find('\n', start)) {
+        std::string line = content.substr(start, end - start);
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos) {
+            continue;
+        }
+        refRecords_++;
+
+        if (line.compare(0, tab, "P") == 0) {
+            size_t keyTab = line.find('\t', tab + 1);
+            if (keyTab == std::string::npos) {
+                continue;
+            }
+            refs_[line.substr(tab + 1, keyTab - tab - 1)] = line.substr(keyTab + 1);
+        } else if (line.compare(0, tab, "D") == 0) {
+            refs_.erase(line.substr(tab + 1));
+        }
+    }
+
+    for (const auto& ref : refs_) {
+        refCounts_[ref.second]++;
+    }
+}
+
+// Called with the object store locked (shared is enough): replays the log again if another
+// process has appended to or compacted it since we last looked
+void ContentAddressedNoteStorage::syncRefs() {
+    if (!(stampRefs() == refsStamp_)) {
+        loadRefs();
+    }
+}
+
+// Called with the object store locked exclusively
+void ContentAddressedNoteStorage::appendRef(const std::string& line) {
+    AtomicFileWriter::truncateTornTail(refsPath_);
+    AtomicFileWriter::appendFile(refsPath_, line);
+    refRecords_++;
+    if (refRecords_ > 2 * refs_.size() + COMPACTION_SLACK) {
+        compactRefs();
+    }
+    refsStamp_ = stampRefs();
+}
+
+void ContentAddressedNoteStorage::compactRefs() {
+    std::string content;
+    for (const auto& ref : refs_) {
+        content += "P\t" + ref.first + "\t" + ref.second + "\n";
+    }
+    AtomicFileWriter::writeFile(refsPath_, content);
+    refRecords_ = refs_.size();
+}
+
+std::string ContentAddressedNoteStorage::storeBlob(const std::string& content) {
+    char base[40];
+    std::snprintf(base, sizeof(base), "%016llx-%llx",
+                  static_cast<unsigned long long>(hashContent(content)),
+                  static_cast<unsigned long long>(content.size()));
+
+    for (unsigned attempt = 0;; attempt++) {
+        std::string key = attempt == 0 ? std::string(base) : std::string(base) + "-" + std::to_string(attempt);
+        std::string path = blobPath(key);
+
+        if (!fs::exists(path)) {
+            fs::create_directories(fs::path(path).parent_path());
+            AtomicFileWriter::writeFile(path, content);
+            return key;
+        }
+        if (readFile(path) == content) {
+            dedupHits_++;
+            return key;
+        }
+        // Genuine hash collision: probe the next suffix
+    }
+}
+
+void ContentAddressedNoteStorage::release(const std::string& key) {
+    auto it = refCounts_.find(key);
+    if (it != refCounts_.end() && --it->second == 0) {
+        refCounts_.erase(it);
+    }
+}
+
+std::string ContentAddressedNoteStorage::loadNote(const std::string& path) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    FolderLock storeLock(objectsPath_, FolderLock::Mode::Shared);
+    syncRefs();
+    auto it = refs_.find(path);
+    if (it == refs_.end()) {
+        throw std::runtime_error("Failed to load note from: " + path);
+    }
+    std::string key = it->second;
+    lock.unlock();
+
+    // Blobs are immutable; the store lock only keeps collectGarbage() from deleting this one
+    return readFile(blobPath(key));
+}
+
+void ContentAddressedNoteStorage::saveNote(const std::string& path, const std::string& content) {
+    validatePath(path);
+    std::lock_guard<std::mutex> lock(mutex_);
+    FolderLock storeLock(objectsPath_);
+    syncRefs();
+
+    std::string key = storeBlob(content);
+    auto it = refs_.find(path);
+    if (it != refs_.end() && it->second == key) {
+        return;
+    }
+
+    // Update memory first so a compaction triggered by the append sees the new ref
+    refCounts_[key]++;
+    if (it != refs_.end()) {
+        release(it->second);
+        it->second = key;
+    } else {
+        refs_[path] = key;
+    }
+    appendRef("P\t" + path + "\t" + key + "\n");
+}
+
+bool ContentAddressedNoteStorage::noteExists(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FolderLock storeLock(objectsPath_, FolderLock::Mode::Shared);
+    syncRefs();
+    return refs_.count(path) > 0;
+}
+
+bool ContentAddressedNoteStorage::removeNote(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FolderLock storeLock(objectsPath_);
+    syncRefs();
+
+    auto it = refs_.find(path);
+    if (it == refs_.end()) {
+        return false;
+    }
+
+    std::string key = it->second;
+    refs_.erase(it);
+    appendRef("D\t" + path + "\n");
+    release(key);
+    return true;
+}
+
+size_t ContentAddressedNoteStorage::collectGarbage() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FolderLock storeLock(objectsPath_);
+    loadRefs();
+
+    std::vector<fs::path> garbage;
+    for (const auto& shard : fs::directory_iterator(objectsPath_)) {
+        if (!shard.is_directory()) {
+            continue;
+        }
+        for (const auto& blob : fs::directory_iterator(shard.path())) {
+            std::string key = blob.path().filename().string();
+            if (!key.empty() && key[0] != '.' && refCounts_.count(key) == 0) {
+                garbage.push_back(blob.path());
+            }
+        }
+    }
+
+    for (const auto& path : garbage) {
+        fs::remove(path);
+    }
+    return garbage.size();
+}
+
+std::string ContentAddressedNoteStorage::blobKeyFor(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FolderLock storeLock(objectsPath_, FolderLock::Mode::Shared);
+    syncRefs();
+    auto it = refs_.find(path);
+    return it == refs_.end() ? "" : it->second;
+}
+
+ContentAddressedNoteStorage::Stats ContentAddressedNoteStorage::getStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.notes = refs_.size();
+    stats.blobs = refCounts_.size();
+    stats.dedupHits = dedupHits_;
+    return stats;
+}
+
+} // namespace filesystem
+} // namespace plotter
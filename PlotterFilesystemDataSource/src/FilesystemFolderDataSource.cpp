@@ -1,5 +1,7 @@
 #include "plotter_filesystem/FilesystemDataSource.h"
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
+#include "plotter_filesystem/MetadataCache.h"
+#include "plotter_filesystem/TrashBin.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -12,6 +14,66 @@ using namespace plotter::filesystem_dtos;
 namespace plotter {
 namespace filesystem {
 
+namespace {
+
+// In the manifest layout the folder's note list lives in its manifest, not in .plotter_folder
+void readNoteIds(const std::string& folderPath, const Json::Value& root, FilesystemFolderDTO* dto) {
+    if (FolderManifest::exists(folderPath)) {
+        for (const auto& entry : FolderManifest(folderPath).load()) {
+            dto->noteIds.push_back(entry.id);
+        }
+        return;
+    }
+
+    const Json::Value& noteIds = root["noteIds"];
+    for (const auto& noteId : noteIds) {
+        dto->noteIds.push_back(noteId.asString());
+    }
+}
+
+// Adds or drops a folder id in the child list of the folder or project at parentPath
+void patchChildList(const std::string& parentPath, const std::string& childId, bool add) {
+    std::string metadataPath = parentPath + "/.plotter_folder";
+    const char* key = "subfolderIds";
+    if (!fs::exists(metadataPath)) {
+        metadataPath = parentPath + "/.plotter_project";
+        key = "folderIds";
+    }
+
+    auto cached = MetadataCache::instance().load(metadataPath);
+    if (!cached) {
+        return;
+    }
+
+    Json::Value root = *cached;
+    Json::Value ids(Json::arrayValue);
+    bool present = false;
+    for (const auto& id : root[key]) {
+        if (id.asString() == childId) {
+            present = true;
+        } else {
+            ids.append(id);
+        }
+    }
+    if (present == add) {
+        return;
+    }
+    if (add) {
+        ids.append(childId);
+    }
+    root[key] = ids;
+
+    Json::StyledWriter writer;
+    FilesystemDTOUtils::writeDotfile(metadataPath, writer.write(root));
+}
+
+bool hasMetadataId(const std::string& metadataPath, const std::string& id) {
+    auto cached = MetadataCache::instance().load(metadataPath);
+    return cached && (*cached)["id"].asString() == id;
+}
+
+} // namespace
+
 FilesystemFolderDataSource::FilesystemFolderDataSource(const std::string& name, const std::string& rootPath)
     : name_(name), rootPath_(rootPath), connected_(false) {
 }
@@ -47,14 +109,18 @@ void FilesystemFolderDataSource::ensureRootDirectoryExists() {
 
 std::string FilesystemFolderDataSource::getFolderPath(const std::string& folderId) const {
     // Recursively search for folder by ID
-    for (const auto& entry : fs::recursive_directory_iterator(rootPath_)) {
+    for (auto it = fs::recursive_directory_iterator(rootPath_); it != fs::recursive_directory_iterator(); ++it) {
+        const auto& entry = *it;
+        if (entry.is_directory() && FilesystemDTOUtils::isInternalDirectory(entry.path().string())) {
+            it.disable_recursion_pending();
+            continue;
+        }
         if (entry.is_directory()) {
             std::string metadataPath = entry.path().string() + "/.plotter_folder";
             if (fs::exists(metadataPath)) {
-                std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-                Json::Value root;
-                Json::Reader reader;
-                if (reader.parse(content, root)) {
+                auto cached = MetadataCache::instance().load(metadataPath);
+                if (cached) {
+                    const Json::Value& root = *cached;
                     if (root["id"].asString() == folderId) {
                         return entry.path().string();
                     }
@@ -73,6 +139,33 @@ std::string FilesystemFolderDataSource::getFolderMetadataPath(const std::string&
     return folderPath + "/.plotter_folder";
 }
 
+std::string FilesystemFolderDataSource::lockFolder(const std::string& folderId,
+                                                   std::unique_ptr<FolderLockSet>& lock,
+                                                   bool includeParent,
+                                                   const std::string& otherFolder) const {
+    // Find the folder, lock it, then make sure no other process moved or removed it meanwhile
+    for (;;) {
+        std::string folderPath = getFolderPath(folderId);
+        if (folderPath.empty()) {
+            return "";
+        }
+
+        std::vector<std::string> folders{folderPath};
+        if (includeParent) {
+            folders.push_back(fs::path(folderPath).parent_path().string());
+        }
+        if (!otherFolder.empty()) {
+            folders.push_back(otherFolder);
+        }
+        lock.reset(new FolderLockSet(folders));
+
+        if (hasMetadataId(folderPath + "/.plotter_folder", folderId)) {
+            return folderPath;
+        }
+        lock.reset();
+    }
+}
+
 std::string FilesystemFolderDataSource::resolveParentPath(const std::string& parentProjectId,
                                                            const std::string& parentFolderId) const {
     if (!parentFolderId.empty()) {
@@ -84,10 +177,9 @@ std::string FilesystemFolderDataSource::resolveParentPath(const std::string& par
         if (entry.is_directory()) {
             std::string metadataPath = entry.path().string() + "/.plotter_project";
             if (fs::exists(metadataPath)) {
-                std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-                Json::Value root;
-                Json::Reader reader;
-                if (reader.parse(content, root)) {
+                auto cached = MetadataCache::instance().load(metadataPath);
+                if (cached) {
+                    const Json::Value& root = *cached;
                     if (root["id"].asString() == parentProjectId) {
                         return entry.path().string();
                     }
@@ -98,6 +190,35 @@ std::string FilesystemFolderDataSource::resolveParentPath(const std::string& par
     return "";
 }
 
+std::string FilesystemFolderDataSource::lockParent(const std::string& parentProjectId,
+                                                   const std::string& parentFolderId,
+                                                   std::unique_ptr<FolderLock>& lock) const {
+    // Like lockFolder(), but for the project or folder that a new folder is created in
+    for (;;) {
+        std::string parentPath = resolveParentPath(parentProjectId, parentFolderId);
+        if (parentPath.empty()) {
+            return "";
+        }
+
+        try {
+            lock.reset(new FolderLock(parentPath));
+        } catch (const std::runtime_error&) {
+            if (fs::is_directory(parentPath)) {
+                throw;
+            }
+            continue;   // Gone before it could be locked; look it up again
+        }
+
+        bool inPlace = parentFolderId.empty()
+            ? hasMetadataId(parentPath + "/.plotter_project", parentProjectId)
+            : hasMetadataId(parentPath + "/.plotter_folder", parentFolderId);
+        if (inPlace) {
+            return parentPath;
+        }
+        lock.reset();
+    }
+}
+
 std::string FilesystemFolderDataSource::create(dto::FolderDTO* dto) {
     auto* fsDto = dynamic_cast<FilesystemFolderDTO*>(dto);
     if (!fsDto) {
@@ -109,15 +230,15 @@ std::string FilesystemFolderDataSource::create(dto::FolderDTO* dto) {
         fsDto->id = FilesystemDTOUtils::generateId();
     }
 
-    // Resolve parent path
-    std::string parentPath = resolveParentPath(fsDto->parentProjectId, fsDto->parentFolderId);
+    std::unique_ptr<FolderLock> lock;
+    std::string parentPath = lockParent(fsDto->parentProjectId, fsDto->parentFolderId, lock);
     if (parentPath.empty()) {
         throw std::runtime_error("Parent directory not found");
     }
 
-    // Create folder directory
+    // Create folder directory; the locked parent exists, so only the last component is new
     std::string folderPath = parentPath + "/" + fsDto->name;
-    fs::create_directories(folderPath);
+    fs::create_directory(folderPath);
     fsDto->path = folderPath;
 
     // Create metadata file
@@ -149,20 +270,19 @@ std::string FilesystemFolderDataSource::create(dto::FolderDTO* dto) {
     return fsDto->id;
 }
 
-dto::FolderDTO* FilesystemFolderDataSource::read(const std::string& id) {
+dto::DTOPtr<dto::FolderDTO> FilesystemFolderDataSource::read(const std::string& id) {
     std::string metadataPath = getFolderMetadataPath(id);
     if (metadataPath.empty()) {
         return nullptr;
     }
 
-    std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-    Json::Value root;
-    Json::Reader reader;
-    if (!reader.parse(content, root)) {
+    auto cached = MetadataCache::instance().load(metadataPath);
+    if (!cached) {
         throw std::runtime_error("Failed to parse folder metadata");
     }
+    const Json::Value& root = *cached;
 
-    auto* dto = new FilesystemFolderDTO();
+    auto dto = std::make_unique<FilesystemFolderDTO>();
     dto->id = root["id"].asString();
     dto->name = root["name"].asString();
     dto->description = root["description"].asString();
@@ -172,12 +292,9 @@ dto::FolderDTO* FilesystemFolderDataSource::read(const std::string& id) {
     dto->updatedAt = root["updatedAt"].asInt64();
     dto->path = getFolderPath(id);
 
-    const Json::Value noteIds = root["noteIds"];
-    for (const auto& noteId : noteIds) {
-        dto->noteIds.push_back(noteId.asString());
-    }
+    readNoteIds(dto->path, root, dto.get());
 
-    const Json::Value subfolderIds = root["subfolderIds"];
+    const Json::Value& subfolderIds = root["subfolderIds"];
     for (const auto& subfolderId : subfolderIds) {
         dto->subfolderIds.push_back(subfolderId.asString());
     }
@@ -191,33 +308,52 @@ bool FilesystemFolderDataSource::update(const std::string& id, dto::FolderDTO* d
         throw std::runtime_error("FilesystemFolderDataSource::update - DTO is not a FilesystemFolderDTO");
     }
 
-    std::string metadataPath = getFolderMetadataPath(id);
-    if (metadataPath.empty()) {
+    std::unique_ptr<FolderLockSet> lock;
+    std::string folderPath = lockFolder(id, lock, false);
+    if (folderPath.empty()) {
         return false;
     }
+    std::string metadataPath = folderPath + "/.plotter_folder";
 
     fsDto->updatedAt = FilesystemDTOUtils::getCurrentTimestamp();
 
-    Json::Value root;
-    root["id"] = fsDto->id;
-    root["name"] = fsDto->name;
-    root["description"] = fsDto->description;
-    root["parentProjectId"] = fsDto->parentProjectId;
-    root["parentFolderId"] = fsDto->parentFolderId;
-    root["createdAt"] = (Json::Int64)fsDto->createdAt;
+    // Patch the changed fields into the stored metadata; rewrite it all only
+    // for full updates or when there is nothing readable to patch
+    std::shared_ptr<const Json::Value> stored;
+    if (fsDto->changes.fields != dto::ChangeMask::ALL) {
+        stored = MetadataCache::instance().load(metadataPath);
+    }
+    dto::ChangeMask changes = stored ? fsDto->changes : dto::ChangeMask();
+    Json::Value root = stored ? *stored : Json::Value();
+    if (!stored) {
+        root["id"] = fsDto->id;
+        root["createdAt"] = (Json::Int64)fsDto->createdAt;
+    }
+    if (changes.has(dto::ChangeMask::NAME)) {
+        root["name"] = fsDto->name;
+    }
+    if (changes.has(dto::ChangeMask::DESCRIPTION)) {
+        root["description"] = fsDto->description;
+    }
+    if (changes.has(dto::ChangeMask::PARENT)) {
+        root["parentProjectId"] = fsDto->parentProjectId;
+        root["parentFolderId"] = fsDto->parentFolderId;
+    }
     root["updatedAt"] = (Json::Int64)fsDto->updatedAt;
 
-    Json::Value noteIds(Json::arrayValue);
-    for (const auto& nid : fsDto->noteIds) {
-        noteIds.append(nid);
-    }
-    root["noteIds"] = noteIds;
+    if (changes.has(dto::ChangeMask::CHILDREN)) {
+        Json::Value noteIds(Json::arrayValue);
+        for (const auto& nid : fsDto->noteIds) {
+            noteIds.append(nid);
+        }
+        root["noteIds"] = noteIds;
 
-    Json::Value subfolderIds(Json::arrayValue);
-    for (const auto& sid : fsDto->subfolderIds) {
-        subfolderIds.append(sid);
+        Json::Value subfolderIds(Json::arrayValue);
+        for (const auto& sid : fsDto->subfolderIds) {
+            subfolderIds.append(sid);
+        }
+        root["subfolderIds"] = subfolderIds;
     }
-    root["subfolderIds"] = subfolderIds;
 
     Json::StyledWriter writer;
     FilesystemDTOUtils::writeDotfile(metadataPath, writer.write(root));
@@ -226,48 +362,109 @@ bool FilesystemFolderDataSource::update(const std::string& id, dto::FolderDTO* d
 }
 
 bool FilesystemFolderDataSource::remove(const std::string& id) {
-    std::string folderPath = getFolderPath(id);
+    std::unique_ptr<FolderLockSet> lock;
+    std::string folderPath = lockFolder(id, lock, true);
     if (folderPath.empty()) {
         return false;
     }
 
-    fs::remove_all(folderPath);
+    TrashBin(rootPath_).trash("folder", id, {folderPath});
     return true;
 }
 
-std::vector<dto::FolderDTO*> FilesystemFolderDataSource::scanFoldersInDirectory(const std::string& dirPath) const {
-    std::vector<dto::FolderDTO*> folders;
+bool FilesystemFolderDataSource::restore(const std::string& id) {
+    return TrashBin(rootPath_).restore(id);
+}
+
+bool FilesystemFolderDataSource::move(const std::string& id, const std::string& newParentProjectId,
+                                      const std::string& newParentFolderId) {
+    std::unique_ptr<FolderLockSet> lock;
+    std::string folderPath;
+    std::string parentPath;
+    for (;;) {
+        parentPath = resolveParentPath(newParentProjectId, newParentFolderId);
+        if (parentPath.empty()) {
+            throw std::runtime_error("Parent directory not found");
+        }
+        folderPath = lockFolder(id, lock, true, parentPath);
+        if (folderPath.empty()) {
+            return false;
+        }
+        bool parentInPlace = newParentFolderId.empty()
+            ? hasMetadataId(parentPath + "/.plotter_project", newParentProjectId)
+            : hasMetadataId(parentPath + "/.plotter_folder", newParentFolderId);
+        if (parentInPlace) {
+            break;
+        }
+        lock.reset();   // The destination moved before we locked it
+    }
+
+    // A folder cannot be moved into itself or one of its descendants
+    fs::path relative = fs::path(parentPath).lexically_relative(folderPath);
+    if (!relative.empty() && *relative.begin() != "..") {
+        throw std::runtime_error("Cannot move a folder into itself or one of its subfolders");
+    }
+
+    std::string oldParentPath = fs::path(folderPath).parent_path().string();
+    std::string targetPath = parentPath + "/" + fs::path(folderPath).filename().string();
+    bool relocated = targetPath != folderPath;
+    if (relocated) {
+        if (fs::exists(targetPath)) {
+            throw std::runtime_error("Cannot move folder: destination already exists: " + targetPath);
+        }
+        // One rename relocates the whole subtree, whatever its size
+        fs::rename(folderPath, targetPath);
+    }
+
+    std::string metadataPath = targetPath + "/.plotter_folder";
+    auto cached = MetadataCache::instance().load(metadataPath);
+    if (!cached) {
+        throw std::runtime_error("Failed to parse folder metadata");
+    }
+    Json::Value root = *cached;
+    root["parentProjectId"] = newParentProjectId;
+    root["parentFolderId"] = newParentFolderId;
+    root["updatedAt"] = (Json::Int64)FilesystemDTOUtils::getCurrentTimestamp();
+
+    Json::StyledWriter writer;
+    FilesystemDTOUtils::writeDotfile(metadataPath, writer.write(root));
+
+    if (relocated) {
+        patchChildList(oldParentPath, id, false);
+        patchChildList(parentPath, id, true);
+    }
+    return true;
+}
+
+dto::DTOList<dto::FolderDTO> FilesystemFolderDataSource::scanFoldersInDirectory(const std::string& dirPath) const {
+    dto::DTOList<dto::FolderDTO> folders;
 
     for (const auto& entry : fs::directory_iterator(dirPath)) {
         if (entry.is_directory()) {
             std::string metadataPath = entry.path().string() + "/.plotter_folder";
             if (fs::exists(metadataPath)) {
                 try {
-                    std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-                    Json::Value root;
-                    Json::Reader reader;
-                    if (reader.parse(content, root)) {
-                        auto* dto = new FilesystemFolderDTO();
-                        dto->id = root["id"].asString();
-                        dto->name = root["name"].asString();
-                        dto->description = root["description"].asString();
-                        dto->parentProjectId = root["parentProjectId"].asString();
-                        dto->parentFolderId = root["parentFolderId"].asString();
-                        dto->createdAt = root["createdAt"].asInt64();
-                        dto->updatedAt = root["updatedAt"].asInt64();
-                        dto->path = entry.path().string();
-
-                        const Json::Value noteIds = root["noteIds"];
-                        for (const auto& noteId : noteIds) {
-                            dto->noteIds.push_back(noteId.asString());
-                        }
-
-                        const Json::Value subfolderIds = root["subfolderIds"];
+                    auto cached = MetadataCache::instance().load(metadataPath);
+                    if (cached) {
+                        const Json::Value& root = *cached;
+                        FilesystemFolderDTO dto;
+                        dto.id = root["id"].asString();
+                        dto.name = root["name"].asString();
+                        dto.description = root["description"].asString();
+                        dto.parentProjectId = root["parentProjectId"].asString();
+                        dto.parentFolderId = root["parentFolderId"].asString();
+                        dto.createdAt = root["createdAt"].asInt64();
+                        dto.updatedAt = root["updatedAt"].asInt64();
+                        dto.path = entry.path().string();
+
+                        readNoteIds(dto.path, root, &dto);
+
+                        const Json::Value& subfolderIds = root["subfolderIds"];
                         for (const auto& subfolderId : subfolderIds) {
-                            dto->subfolderIds.push_back(subfolderId.asString());
+                            dto.subfolderIds.push_back(subfolderId.asString());
                         }
 
-                        folders.push_back(dto);
+                        folders.emplace_back<FilesystemFolderDTO>(std::move(dto));
                     }
                 } catch (const std::exception&) {
                     continue;
@@ -279,7 +476,7 @@ std::vector<dto::FolderDTO*> FilesystemFolderDataSource::scanFoldersInDirectory(
     return folders;
 }
 
-std::vector<dto::FolderDTO*> FilesystemFolderDataSource::listByProject(const std::string& projectId) {
+dto::DTOList<dto::FolderDTO> FilesystemFolderDataSource::listByProject(const std::string& projectId) {
     std::string projectPath = resolveParentPath(projectId, "");
     if (projectPath.empty()) {
         return {};
@@ -288,7 +485,7 @@ std::vector<dto::FolderDTO*> FilesystemFolderDataSource::listByProject(const std
     return scanFoldersInDirectory(projectPath);
 }
 
-std::vector<dto::FolderDTO*> FilesystemFolderDataSource::listByParentFolder(const std::string& folderId) {
+dto::DTOList<dto::FolderDTO> FilesystemFolderDataSource::listByParentFolder(const std::string& folderId) {
     std::string folderPath = getFolderPath(folderId);
     if (folderPath.empty()) {
         return {};
@@ -1,5 +1,8 @@
 #include "plotter_filesystem/FilesystemDataSource.h"
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
+#include "plotter_filesystem/MetadataCache.h"
+#include "plotter_filesystem/TrashBin.h"
+#include "plotter_filesystem_dtos/AtomicFileWriter.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -12,9 +15,68 @@ using namespace plotter::filesystem_dtos;
 namespace plotter {
 namespace filesystem {
 
+namespace {
+
+// Adds or drops a note id in the noteIds list of the folder at folderPath
+void patchNoteIds(const std::string& folderPath, const std::string& noteId, bool add) {
+    std::string metadataPath = folderPath + "/.plotter_folder";
+    auto cached = MetadataCache::instance().load(metadataPath);
+    if (!cached) {
+        return;
+    }
+
+    Json::Value root = *cached;
+    Json::Value ids(Json::arrayValue);
+    bool present = false;
+    for (const auto& id : root["noteIds"]) {
+        if (id.asString() == noteId) {
+            present = true;
+        } else {
+            ids.append(id);
+        }
+    }
+    if (present == add) {
+        return;
+    }
+    if (add) {
+        ids.append(noteId);
+    }
+    root["noteIds"] = ids;
+
+    Json::StyledWriter writer;
+    FilesystemDTOUtils::writeDotfile(metadataPath, writer.write(root));
+}
+
+bool isFolderWithId(const std::string& folderPath, const std::string& folderId) {
+    auto cached = MetadataCache::instance().load(folderPath + "/.plotter_folder");
+    return cached && (*cached)["id"].asString() == folderId;
+}
+
+std::string readNoteFile(const std::string& notePath) {
+    std::ifstream noteFile(notePath);
+    if (!noteFile.is_open()) {
+        throw std::runtime_error("Failed to open note file");
+    }
+
+    std::stringstream buffer;
+    buffer << noteFile.rdbuf();
+    return buffer.str();
+}
+
+// Listed notes read their file only when the content is asked for
+void deferContent(FilesystemNoteDTO& dto) {
+    dto.contentLoaded = false;
+    std::string notePath = dto.path;
+    dto.contentLoader = [notePath]() { return readNoteFile(notePath); };
+}
+
+} // namespace
+
 FilesystemNoteDataSource::FilesystemNoteDataSource(const std::string& name, const std::string& rootPath,
-                                                   const std::string& defaultExtension)
-    : name_(name), rootPath_(rootPath), connected_(false), defaultExtension_(defaultExtension) {
+                                                   const std::string& defaultExtension,
+                                                   NoteMetadataLayout layout)
+    : name_(name), rootPath_(rootPath), connected_(false), defaultExtension_(defaultExtension),
+      layout_(layout), batchReader_(new BatchFileReader()) {
 }
 
 FilesystemNoteDataSource::~FilesystemNoteDataSource() {
@@ -46,24 +108,76 @@ void FilesystemNoteDataSource::ensureRootDirectoryExists() {
     }
 }
 
-std::string FilesystemNoteDataSource::getNotePath(const std::string& noteId) const {
-    // Recursively search for note by ID
-    for (const auto& entry : fs::recursive_directory_iterator(rootPath_)) {
-        if (entry.is_regular_file()) {
+bool FilesystemNoteDataSource::locateNote(const std::string& noteId, NoteLocation& location) const {
+    // Recursively search for note by ID, in manifests and sidecars alike
+    for (auto it = fs::recursive_directory_iterator(rootPath_); it != fs::recursive_directory_iterator(); ++it) {
+        const auto& entry = *it;
+        if (entry.is_directory() && FilesystemDTOUtils::isInternalDirectory(entry.path().string())) {
+            it.disable_recursion_pending();
+            continue;
+        }
+        if (entry.is_directory()) {
+            std::string dirPath = entry.path().string();
+            if (FolderManifest::exists(dirPath) && FolderManifest(dirPath).find(noteId, location.entry)) {
+                location.folderPath = dirPath;
+                location.notePath = dirPath + "/" + location.entry.file;
+                location.inManifest = true;
+                return true;
+            }
+        } else if (entry.is_regular_file()) {
             std::string metadataPath = entry.path().string() + ".plotter_meta";
             if (fs::exists(metadataPath)) {
-                std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-                Json::Value root;
-                Json::Reader reader;
-                if (reader.parse(content, root)) {
+                auto cached = MetadataCache::instance().load(metadataPath);
+                if (cached) {
+                    const Json::Value& root = *cached;
                     if (root["id"].asString() == noteId) {
-                        return entry.path().string();
+                        location.folderPath = entry.path().parent_path().string();
+                        location.notePath = entry.path().string();
+                        location.inManifest = false;
+                        return true;
                     }
                 }
             }
         }
     }
-    return "";
+    return false;
+}
+
+bool FilesystemNoteDataSource::lockNote(const std::string& noteId, NoteLocation& location,
+                                        std::unique_ptr<FolderLockSet>& lock,
+                                        const std::string& otherFolder) const {
+    // Find the note, lock its folder, then make sure no other process moved or removed it meanwhile
+    for (;;) {
+        if (!locateNote(noteId, location)) {
+            return false;
+        }
+
+        std::vector<std::string> folders{location.folderPath};
+        if (!otherFolder.empty()) {
+            folders.push_back(otherFolder);
+        }
+        lock.reset(new FolderLockSet(folders));
+
+        if (location.inManifest) {
+            if (FolderManifest(location.folderPath).find(noteId, location.entry)) {
+                return true;
+            }
+        } else {
+            auto cached = MetadataCache::instance().load(getNoteMetadataPath(location.notePath));
+            if (cached && (*cached)["id"].asString() == noteId) {
+                return true;
+            }
+        }
+        lock.reset();
+    }
+}
+
+std::string FilesystemNoteDataSource::getNotePath(const std::string& noteId) const {
+    NoteLocation location;
+    if (!locateNote(noteId, location)) {
+        return "";
+    }
+    return location.notePath;
 }
 
 std::string FilesystemNoteDataSource::getNoteMetadataPath(const std::string& notePath) const {
@@ -72,14 +186,18 @@ std::string FilesystemNoteDataSource::getNoteMetadataPath(const std::string& not
 
 std::string FilesystemNoteDataSource::resolveFolderPath(const std::string& folderId) const {
     // Search for folder by ID
-    for (const auto& entry : fs::recursive_directory_iterator(rootPath_)) {
+    for (auto it = fs::recursive_directory_iterator(rootPath_); it != fs::recursive_directory_iterator(); ++it) {
+        const auto& entry = *it;
+        if (entry.is_directory() && FilesystemDTOUtils::isInternalDirectory(entry.path().string())) {
+            it.disable_recursion_pending();
+            continue;
+        }
         if (entry.is_directory()) {
             std::string metadataPath = entry.path().string() + "/.plotter_folder";
             if (fs::exists(metadataPath)) {
-                std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-                Json::Value root;
-                Json::Reader reader;
-                if (reader.parse(content, root)) {
+                auto cached = MetadataCache::instance().load(metadataPath);
+                if (cached) {
+                    const Json::Value& root = *cached;
                     if (root["id"].asString() == folderId) {
                         return entry.path().string();
                     }
@@ -90,6 +208,32 @@ std::string FilesystemNoteDataSource::resolveFolderPath(const std::string& folde
     return "";
 }
 
+std::string FilesystemNoteDataSource::lockFolder(const std::string& folderId,
+                                                 std::unique_ptr<FolderLock>& lock) const {
+    // Find the folder, lock it, then make sure no other process moved or removed it meanwhile
+    for (;;) {
+        std::string folderPath = resolveFolderPath(folderId);
+        if (folderPath.empty()) {
+            return "";
+        }
+
+        try {
+            lock.reset(new FolderLock(folderPath));
+        } catch (const std::runtime_error&) {
+            if (fs::is_directory(folderPath)) {
+                throw;
+            }
+            continue;   // Gone before it could be locked; look it up again
+        }
+
+        auto cached = MetadataCache::instance().load(folderPath + "/.plotter_folder");
+        if (cached && (*cached)["id"].asString() == folderId) {
+            return folderPath;
+        }
+        lock.reset();
+    }
+}
+
 std::string FilesystemNoteDataSource::create(dto::NoteDTO* dto) {
     auto* fsDto = dynamic_cast<FilesystemNoteDTO*>(dto);
     if (!fsDto) {
@@ -101,8 +245,8 @@ std::string FilesystemNoteDataSource::create(dto::NoteDTO* dto) {
         fsDto->id = FilesystemDTOUtils::generateId();
     }
 
-    // Resolve folder path
-    std::string folderPath = resolveFolderPath(fsDto->parentFolderId);
+    std::unique_ptr<FolderLock> lock;
+    std::string folderPath = lockFolder(fsDto->parentFolderId, lock);
     if (folderPath.empty()) {
         throw std::runtime_error("Parent folder not found");
     }
@@ -111,12 +255,29 @@ std::string FilesystemNoteDataSource::create(dto::NoteDTO* dto) {
     std::string notePath = folderPath + "/" + fsDto->name + defaultExtension_;
     fsDto->path = notePath;
 
-    std::ofstream noteFile(notePath);
-    if (!noteFile.is_open()) {
-        throw std::runtime_error("Failed to create note file");
+    try {
+        AtomicFileWriter::writeFile(notePath, fsDto->content);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string("Failed to create note file: ") + e.what());
+    }
+
+    // Record metadata in the folder manifest, converting the folder first if needed
+    bool hasManifest = FolderManifest::exists(folderPath);
+    if (layout_ == NoteMetadataLayout::Manifest && !hasManifest) {
+        FolderManifest::migrateFromSidecars(folderPath);
+        hasManifest = true;
+    }
+    if (hasManifest) {
+        ManifestEntry entry;
+        entry.id = fsDto->id;
+        entry.name = fsDto->name;
+        entry.file = fs::path(notePath).filename().string();
+        entry.parentFolderId = fsDto->parentFolderId;
+        entry.createdAt = fsDto->createdAt;
+        entry.updatedAt = fsDto->updatedAt;
+        FolderManifest(folderPath).put(entry);
+        return fsDto->id;
     }
-    noteFile << fsDto->content;
-    noteFile.close();
 
     // Create metadata file
     Json::Value root;
@@ -133,26 +294,34 @@ std::string FilesystemNoteDataSource::create(dto::NoteDTO* dto) {
     return fsDto->id;
 }
 
-dto::NoteDTO* FilesystemNoteDataSource::read(const std::string& id) {
-    std::string notePath = getNotePath(id);
-    if (notePath.empty()) {
+dto::DTOPtr<dto::NoteDTO> FilesystemNoteDataSource::read(const std::string& id) {
+    NoteLocation location;
+    if (!locateNote(id, location)) {
         return nullptr;
     }
+    const std::string& notePath = location.notePath;
+
+    auto dto = std::make_unique<FilesystemNoteDTO>();
+    if (location.inManifest) {
+        dto->id = location.entry.id;
+        dto->name = location.entry.name;
+        dto->parentFolderId = location.entry.parentFolderId;
+        dto->createdAt = location.entry.createdAt;
+        dto->updatedAt = location.entry.updatedAt;
+    } else {
+        std::string metadataPath = getNoteMetadataPath(notePath);
+        auto cached = MetadataCache::instance().load(metadataPath);
+        if (!cached) {
+            throw std::runtime_error("Failed to parse note metadata");
+        }
+        const Json::Value& root = *cached;
 
-    std::string metadataPath = getNoteMetadataPath(notePath);
-    std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-    Json::Value root;
-    Json::Reader reader;
-    if (!reader.parse(content, root)) {
-        throw std::runtime_error("Failed to parse note metadata");
+        dto->id = root["id"].asString();
+        dto->name = root["name"].asString();
+        dto->parentFolderId = root["parentFolderId"].asString();
+        dto->createdAt = root["createdAt"].asInt64();
+        dto->updatedAt = root["updatedAt"].asInt64();
     }
-
-    auto* dto = new FilesystemNoteDTO();
-    dto->id = root["id"].asString();
-    dto->name = root["name"].asString();
-    dto->parentFolderId = root["parentFolderId"].asString();
-    dto->createdAt = root["createdAt"].asInt64();
-    dto->updatedAt = root["updatedAt"].asInt64();
     dto->path = notePath;
 
     // Read note content
@@ -172,70 +341,115 @@ bool FilesystemNoteDataSource::update(const std::string& id, dto::NoteDTO* dto)
         throw std::runtime_error("FilesystemNoteDataSource::update - DTO is not a FilesystemNoteDTO");
     }
 
-    std::string notePath = getNotePath(id);
-    if (notePath.empty()) {
+    NoteLocation location;
+    std::unique_ptr<FolderLockSet> lock;
+    if (!lockNote(id, location, lock)) {
         return false;
     }
+    const std::string& notePath = location.notePath;
 
     fsDto->updatedAt = FilesystemDTOUtils::getCurrentTimestamp();
+    bool fullUpdate = fsDto->changes.fields == dto::ChangeMask::ALL;
+
+    // Only changed fields are patched into the stored record
+    if (location.inManifest) {
+        ManifestEntry entry = location.entry;
+        if (fsDto->changes.has(dto::ChangeMask::NAME)) {
+            entry.name = fsDto->name;
+        }
+        if (fsDto->changes.has(dto::ChangeMask::PARENT)) {
+            entry.parentFolderId = fsDto->parentFolderId;
+        }
+        if (fullUpdate) {
+            entry.createdAt = fsDto->createdAt;
+        }
+        entry.updatedAt = fsDto->updatedAt;
+        FolderManifest(location.folderPath).put(entry);
+        return true;
+    }
 
     // Update metadata
-    Json::Value root;
-    root["id"] = fsDto->id;
-    root["name"] = fsDto->name;
-    root["parentFolderId"] = fsDto->parentFolderId;
-    root["createdAt"] = (Json::Int64)fsDto->createdAt;
+    std::string metadataPath = getNoteMetadataPath(notePath);
+    std::shared_ptr<const Json::Value> stored;
+    if (!fullUpdate) {
+        stored = MetadataCache::instance().load(metadataPath);
+    }
+    dto::ChangeMask changes = stored ? fsDto->changes : dto::ChangeMask();
+    Json::Value root = stored ? *stored : Json::Value();
+    if (!stored) {
+        root["id"] = fsDto->id;
+        root["createdAt"] = (Json::Int64)fsDto->createdAt;
+    }
+    if (changes.has(dto::ChangeMask::NAME)) {
+        root["name"] = fsDto->name;
+    }
+    if (changes.has(dto::ChangeMask::PARENT)) {
+        root["parentFolderId"] = fsDto->parentFolderId;
+    }
     root["updatedAt"] = (Json::Int64)fsDto->updatedAt;
 
     Json::StyledWriter writer;
-    std::string metadataPath = getNoteMetadataPath(notePath);
     FilesystemDTOUtils::writeDotfile(metadataPath, writer.write(root));
 
     return true;
 }
 
 bool FilesystemNoteDataSource::remove(const std::string& id) {
-    std::string notePath = getNotePath(id);
-    if (notePath.empty()) {
+    NoteLocation location;
+    std::unique_ptr<FolderLockSet> lock;
+    if (!lockNote(id, location, lock)) {
         return false;
     }
 
-    std::string metadataPath = getNoteMetadataPath(notePath);
-    fs::remove(notePath);
-    fs::remove(metadataPath);
+    if (location.inManifest) {
+        // Trash the file first: if that fails the manifest must still list the note
+        TrashBin(rootPath_).trash("note", id, {location.notePath}, &location.entry);
+        FolderManifest(location.folderPath).remove(id);
+        return true;
+    }
 
+    TrashBin(rootPath_).trash("note", id, {location.notePath, getNoteMetadataPath(location.notePath)});
     return true;
 }
 
-std::vector<dto::NoteDTO*> FilesystemNoteDataSource::scanNotesInDirectory(const std::string& dirPath) const {
-    std::vector<dto::NoteDTO*> notes;
+bool FilesystemNoteDataSource::restore(const std::string& id) {
+    return TrashBin(rootPath_).restore(id);
+}
+
+dto::DTOList<dto::NoteDTO> FilesystemNoteDataSource::scanNotesInDirectory(const std::string& dirPath) const {
+    dto::DTOList<dto::NoteDTO> notes;
+
+    if (FolderManifest::exists(dirPath)) {
+        for (const auto& entry : FolderManifest(dirPath).load()) {
+            auto& dto = notes.emplace_back<FilesystemNoteDTO>();
+            dto.id = entry.id;
+            dto.name = entry.name;
+            dto.parentFolderId = entry.parentFolderId;
+            dto.createdAt = entry.createdAt;
+            dto.updatedAt = entry.updatedAt;
+            dto.path = dirPath + "/" + entry.file;
+            deferContent(dto);
+        }
+        return notes;
+    }
 
     for (const auto& entry : fs::directory_iterator(dirPath)) {
         if (entry.is_regular_file()) {
             std::string metadataPath = entry.path().string() + ".plotter_meta";
             if (fs::exists(metadataPath)) {
                 try {
-                    std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-                    Json::Value root;
-                    Json::Reader reader;
-                    if (reader.parse(content, root)) {
-                        auto* dto = new FilesystemNoteDTO();
-                        dto->id = root["id"].asString();
-                        dto->name = root["name"].asString();
-                        dto->parentFolderId = root["parentFolderId"].asString();
-                        dto->createdAt = root["createdAt"].asInt64();
-                        dto->updatedAt = root["updatedAt"].asInt64();
-                        dto->path = entry.path().string();
-
-                        // Read note content
-                        std::ifstream noteFile(dto->path);
-                        if (noteFile.is_open()) {
-                            std::stringstream buffer;
-                            buffer << noteFile.rdbuf();
-                            dto->content = buffer.str();
-                        }
-
-                        notes.push_back(dto);
+                    auto cached = MetadataCache::instance().load(metadataPath);
+                    if (cached) {
+                        const Json::Value& root = *cached;
+                        FilesystemNoteDTO dto;
+                        dto.id = root["id"].asString();
+                        dto.name = root["name"].asString();
+                        dto.parentFolderId = root["parentFolderId"].asString();
+                        dto.createdAt = root["createdAt"].asInt64();
+                        dto.updatedAt = root["updatedAt"].asInt64();
+                        dto.path = entry.path().string();
+                        deferContent(dto);
+                        notes.emplace_back<FilesystemNoteDTO>(std::move(dto));
                     }
                 } catch (const std::exception&) {
                     continue;
@@ -247,7 +461,29 @@ std::vector<dto::NoteDTO*> FilesystemNoteDataSource::scanNotesInDirectory(const
     return notes;
 }
 
-std::vector<dto::NoteDTO*> FilesystemNoteDataSource::listByFolder(const std::string& folderId) {
+void FilesystemNoteDataSource::loadContents(const dto::DTOList<dto::NoteDTO>& notes) const {
+    // Read the files of all notes still missing their content in one batch
+    std::vector<FilesystemNoteDTO*> pending;
+    std::vector<std::string> paths;
+    for (dto::NoteDTO& note : notes) {
+        auto* fsNote = dynamic_cast<FilesystemNoteDTO*>(&note);
+        if (fsNote && !fsNote->contentLoaded) {
+            pending.push_back(fsNote);
+            paths.push_back(fsNote->path);
+        }
+    }
+
+    std::vector<BatchReadResult> results = batchReader_->readAll(paths);
+    for (size_t i = 0; i < pending.size(); i++) {
+        if (results[i].ok()) {
+            pending[i]->content = std::move(results[i].content);
+            pending[i]->contentLoaded = true;
+            pending[i]->contentLoader = nullptr;
+        }
+    }
+}
+
+dto::DTOList<dto::NoteDTO> FilesystemNoteDataSource::listByFolder(const std::string& folderId) {
     std::string folderPath = resolveFolderPath(folderId);
     if (folderPath.empty()) {
         return {};
@@ -262,36 +498,34 @@ std::string FilesystemNoteDataSource::getContent(const std::string& id) {
         throw std::runtime_error("Note not found");
     }
 
-    std::ifstream noteFile(notePath);
-    if (!noteFile.is_open()) {
-        throw std::runtime_error("Failed to open note file");
-    }
-
-    std::stringstream buffer;
-    buffer << noteFile.rdbuf();
-    return buffer.str();
+    return readNoteFile(notePath);
 }
 
 bool FilesystemNoteDataSource::updateContent(const std::string& id, const std::string& content) {
-    std::string notePath = getNotePath(id);
-    if (notePath.empty()) {
+    NoteLocation location;
+    std::unique_ptr<FolderLockSet> lock;
+    if (!lockNote(id, location, lock)) {
         return false;
     }
+    const std::string& notePath = location.notePath;
 
-    std::ofstream noteFile(notePath);
-    if (!noteFile.is_open()) {
+    try {
+        AtomicFileWriter::writeFile(notePath, content);
+    } catch (const std::exception&) {
         return false;
     }
 
-    noteFile << content;
-    noteFile.close();
+    if (location.inManifest) {
+        location.entry.updatedAt = FilesystemDTOUtils::getCurrentTimestamp();
+        FolderManifest(location.folderPath).put(location.entry);
+        return true;
+    }
 
     // Update timestamp in metadata
     std::string metadataPath = getNoteMetadataPath(notePath);
-    std::string metaContent = FilesystemDTOUtils::readDotfile(metadataPath);
-    Json::Value root;
-    Json::Reader reader;
-    if (reader.parse(metaContent, root)) {
+    auto cached = MetadataCache::instance().load(metadataPath);
+    if (cached) {
+        Json::Value root = *cached;
         root["updatedAt"] = (Json::Int64)FilesystemDTOUtils::getCurrentTimestamp();
         Json::StyledWriter writer;
         FilesystemDTOUtils::writeDotfile(metadataPath, writer.write(root));
@@ -300,6 +534,116 @@ bool FilesystemNoteDataSource::updateContent(const std::string& id, const std::s
     return true;
 }
 
+bool FilesystemNoteDataSource::move(const std::string& id, const std::string& newFolderId) {
+    NoteLocation location;
+    std::unique_ptr<FolderLockSet> lock;
+    std::string folderPath;
+    for (;;) {
+        folderPath = resolveFolderPath(newFolderId);
+        if (folderPath.empty()) {
+            throw std::runtime_error("Parent folder not found");
+        }
+        if (!lockNote(id, location, lock, folderPath)) {
+            return false;
+        }
+        if (isFolderWithId(folderPath, newFolderId)) {
+            break;
+        }
+        lock.reset();   // The destination moved before we locked it
+    }
+
+    std::string fileName = fs::path(location.notePath).filename().string();
+    std::string notePath = folderPath + "/" + fileName;
+    bool relocated = notePath != location.notePath;
+    if (relocated && fs::exists(notePath)) {
+        throw std::runtime_error("Cannot move note: destination already exists: " + notePath);
+    }
+
+    // Gather the current metadata before anything moves
+    ManifestEntry entry;
+    if (location.inManifest) {
+        entry = location.entry;
+    } else {
+        auto cached = MetadataCache::instance().load(getNoteMetadataPath(location.notePath));
+        if (!cached) {
+            throw std::runtime_error("Failed to parse note metadata");
+        }
+        const Json::Value& root = *cached;
+        entry.id = root["id"].asString();
+        entry.name = root["name"].asString();
+        entry.createdAt = root["createdAt"].asInt64();
+    }
+    entry.file = fileName;
+    entry.parentFolderId = newFolderId;
+    entry.updatedAt = FilesystemDTOUtils::getCurrentTimestamp();
+
+    if (relocated) {
+        fs::rename(location.notePath, notePath);
+    }
+
+    // Record the note at its destination, converting the folder first if needed
+    bool hasManifest = FolderManifest::exists(folderPath);
+    if (layout_ == NoteMetadataLayout::Manifest && !hasManifest) {
+        FolderManifest::migrateFromSidecars(folderPath);
+        hasManifest = true;
+    }
+    if (hasManifest) {
+        FolderManifest(folderPath).put(entry);
+    } else {
+        std::string metadataPath = getNoteMetadataPath(notePath);
+        if (!location.inManifest && relocated) {
+            fs::rename(getNoteMetadataPath(location.notePath), metadataPath);
+        }
+
+        Json::Value root;
+        root["id"] = entry.id;
+        root["name"] = entry.name;
+        root["parentFolderId"] = entry.parentFolderId;
+        root["createdAt"] = (Json::Int64)entry.createdAt;
+        root["updatedAt"] = (Json::Int64)entry.updatedAt;
+
+        Json::StyledWriter writer;
+        FilesystemDTOUtils::writeDotfile(metadataPath, writer.write(root));
+    }
+
+    if (!relocated) {
+        return true;
+    }
+
+    // Drop the record left at the source
+    if (location.inManifest) {
+        FolderManifest(location.folderPath).remove(id);
+    } else if (hasManifest) {
+        fs::remove(getNoteMetadataPath(location.notePath));
+    }
+
+    patchNoteIds(location.folderPath, id, false);
+    patchNoteIds(folderPath, id, true);
+    return true;
+}
+
+size_t FilesystemNoteDataSource::migrateToManifestLayout() {
+    // Collect first: migrating deletes sidecars from the tree being walked
+    std::vector<std::string> folderPaths;
+    for (auto it = fs::recursive_directory_iterator(rootPath_); it != fs::recursive_directory_iterator(); ++it) {
+        const auto& entry = *it;
+        if (entry.is_directory() && FilesystemDTOUtils::isInternalDirectory(entry.path().string())) {
+            it.disable_recursion_pending();
+            continue;
+        }
+        if (entry.is_directory() && FilesystemDTOUtils::isFolderDirectory(entry.path().string())) {
+            folderPaths.push_back(entry.path().string());
+        }
+    }
+
+    size_t migrated = 0;
+    for (const auto& folderPath : folderPaths) {
+        migrated += FolderManifest::migrateFromSidecars(folderPath);
+    }
+    layout_ = NoteMetadataLayout::Manifest;
+    return migrated;
+}
+
 } // namespace filesystem
 } // namespace plotter
 
@@ -1,24 +1,101 @@
 #include "plotter_filesystem/FilesystemNoteStorage.h"
+#include "plotter_filesystem_dtos/AtomicFileWriter.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <filesystem>
+#include <vector>
 
 namespace plotter {
 namespace filesystem {
 
-FilesystemNoteStorage::FilesystemNoteStorage(const std::string& baseDir)
-    : baseDirectory(baseDir) {
+namespace {
+
+// Records the layout chosen by migrateToShardedLayout(), so later instances keep to it
+constexpr const char* LAYOUT_FILENAME = ".plotter_layout";
+constexpr const char* SHARDED_MARKER = "sharded";
+
+// Longest escaped path kept verbatim as a shard file name (NAME_MAX is 255)
+constexpr size_t MAX_SHARD_NAME = 200;
+
+uint64_t hashPath(const std::string& path) {
+    // FNV-1a; only needs to spread paths evenly over the shards
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : path) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::string escapePath(const std::string& path) {
+    std::string escaped;
+    escaped.reserve(path.size());
+    for (char c : path) {
+        if (c == '%') {
+            escaped += "%25";
+        } else if (c == '/') {
+            escaped += "%2F";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+FilesystemNoteStorage::FilesystemNoteStorage(const std::string& baseDir, NoteStorageLayout layout)
+    : baseDirectory(baseDir), layout(layout) {
     // Create base directory if it doesn't exist
     std::filesystem::create_directories(baseDirectory);
+
+    std::ifstream marker(baseDirectory + "/" + LAYOUT_FILENAME);
+    std::string recorded;
+    if (marker.is_open() && std::getline(marker, recorded) && recorded == SHARDED_MARKER) {
+        this->layout = NoteStorageLayout::Sharded;
+    }
+}
+
+std::string FilesystemNoteStorage::flatPath(const std::string& path) const {
+    return baseDirectory + "/" + path;
+}
+
+std::string FilesystemNoteStorage::shardedPath(const std::string& path) const {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hashPath(path)));
+
+    std::string name = escapePath(path);
+    if (name.size() > MAX_SHARD_NAME) {
+        // Keep the (unique) hash plus the most specific part of the path
+        name = std::string(hex) + "-" + name.substr(name.size() - (MAX_SHARD_NAME - 17));
+    }
+    return baseDirectory + "/" + SHARDS_DIRECTORY + "/" + std::string(hex, 2) + "/" +
+           std::string(hex + 2, 2) + "/" + name;
+}
+
+std::string FilesystemNoteStorage::resolvePath(const std::string& path) const {
+    // Look in the current layout first, then in the other one
+    std::string primary = layout == NoteStorageLayout::Sharded ? shardedPath(path) : flatPath(path);
+    if (std::filesystem::exists(primary)) {
+        return primary;
+    }
+    std::string secondary = layout == NoteStorageLayout::Sharded ? flatPath(path) : shardedPath(path);
+    if (std::filesystem::exists(secondary)) {
+        return secondary;
+    }
+    return "";
 }
 
 std::string FilesystemNoteStorage::loadNote(const std::string& path) {
-    std::string fullPath = baseDirectory + "/" + path;
+    std::string fullPath = resolvePath(path);
     std::ifstream file(fullPath);
 
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to load note from: " + fullPath);
+    if (fullPath.empty() || !file.is_open()) {
+        throw std::runtime_error("Failed to load note from: " + flatPath(path));
     }
 
     std::stringstream buffer;
@@ -27,88 +104,73 @@ std::string FilesystemNoteStorage::loadNote(const std::string& path) {
 }
 
 void FilesystemNoteStorage::saveNote(const std::string& path, const std::string& content) {
-    std::string fullPath = baseDirectory + "/" + path;
+    bool sharded = layout == NoteStorageLayout::Sharded;
+    std::string fullPath = sharded ? shardedPath(path) : flatPath(path);
 
     // Create parent directories if needed
     std::filesystem::path filePath(fullPath);
     std::filesystem::create_directories(filePath.parent_path());
 
-    std::ofstream file(fullPath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to save note to: " + fullPath);
+    try {
+        plotter::filesystem_dtos::AtomicFileWriter::writeFile(fullPath, content);
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Failed to save note to: " + fullPath + " (" + e.what() + ")");
     }
 
-    file << content;
+    // Drop a copy left in the other layout so it cannot shadow this one
+    std::error_code ec;
+    std::filesystem::remove(sharded ? flatPath(path) : shardedPath(path), ec);
 }
 
 bool FilesystemNoteStorage::noteExists(const std::string& path) {
-    std::string fullPath = baseDirectory + "/" + path;
-    return std::filesystem::exists(fullPath);
+    return !resolvePath(path).empty();
 }
 
-} // namespace filesystem
-} // namespace plotter
-#ifndef PLOTTER_FILESYSTEM_NOTE_STORAGE_H
-#define PLOTTER_FILESYSTEM_NOTE_STORAGE_H
+size_t FilesystemNoteStorage::migrateToShardedLayout() {
+    namespace fs = std::filesystem;
+
+    // Collect first: renaming while iterating would disturb the walk
+    std::vector<std::string> notes;
+    std::vector<fs::path> directories;
+    for (auto it = fs::recursive_directory_iterator(baseDirectory); it != fs::recursive_directory_iterator(); ++it) {
+        std::string name = it->path().filename().string();
+        if (it->is_directory()) {
+            if (!name.empty() && name[0] == '.') {
+                // The shards themselves, trash, object stores and other internal directories
+                it.disable_recursion_pending();
+            } else {
+                directories.push_back(it->path());
+            }
+        } else if (it->is_regular_file() && !name.empty() && name[0] != '.') {
+            // Dotfiles are in-flight temp files, not notes
+            notes.push_back(fs::relative(it->path(), baseDirectory).generic_string());
+        }
+    }
 
-#include "NoteStorage.h"
-#include <fstream>
-#include <sstream>
-#include <stdexcept>
-#include <filesystem>
+    // Record the switch before moving anything, so instances opened during or
+    // after an interrupted migration already save into the shards
+    plotter::filesystem_dtos::AtomicFileWriter::writeFile(baseDirectory + "/" + LAYOUT_FILENAME,
+                                                       std::string(SHARDED_MARKER) + "\n");
+    layout = NoteStorageLayout::Sharded;
 
-namespace plotter {
-namespace filesystem {
+    for (const auto& path : notes) {
+        std::string target = shardedPath(path);
+        fs::create_directories(fs::path(target).parent_path());
+        fs::rename(flatPath(path), target);
+    }
 
-/**
- * @brief Filesystem-based implementation of NoteStorage.
- *
- * Stores notes as text files on disk, allowing notes to be loaded
- * lazily only when accessed. This prevents loading all notes into memory.
- *
- * This is an INFRASTRUCTURE component and should NOT be in the domain layer.
- */
-class FilesystemNoteStorage : public NoteStorage {
-private:
-    std::string baseDirectory;
-
-public:
-    /**
-     * @brief Construct a new FilesystemNoteStorage object.
-     *
-     * @param baseDir The base directory where notes will be stored
-     */
-    explicit FilesystemNoteStorage(const std::string& baseDir);
-
-    /**
-     * @brief Load note content from a file.
-     *
-     * @param path Relative path to the note file (relative to baseDirectory)
-     * @return The content of the note
-     * @throws std::runtime_error if the file cannot be read
-     */
-    std::string loadNote(const std::string& path) override;
-
-    /**
-     * @brief Save note content to a file.
-     *
-     * @param path Relative path to the note file (relative to baseDirectory)
-     * @param content The content to write
-     * @throws std::runtime_error if the file cannot be written
-     */
-    void saveNote(const std::string& path, const std::string& content) override;
-
-    /**
-     * @brief Check if a note file exists.
-     *
-     * @param path Relative path to the note file
-     * @return true if the file exists, false otherwise
-     */
-    bool noteExists(const std::string& path) override;
-};
+    // Remove the flat directories that are now empty, deepest first
+    std::sort(directories.begin(), directories.end(),
+              [](const fs::path& a, const fs::path& b) { return a.native().size() > b.native().size(); });
+    for (const auto& directory : directories) {
+        std::error_code ec;
+        if (fs::is_empty(directory, ec)) {
+            fs::remove(directory, ec);
+        }
+    }
+
+    return notes.size();
+}
 
 } // namespace filesystem
 } // namespace plotter
-
-#endif // PLOTTER_FILESYSTEM_NOTE_STORAGE_H
-
@@ -1,5 +1,7 @@
 #include "plotter_filesystem/FilesystemDataSource.h"
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
+#include "plotter_filesystem/MetadataCache.h"
+#include "plotter_filesystem/TrashBin.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -51,10 +53,9 @@ std::string FilesystemProjectDataSource::getProjectPath(const std::string& proje
         if (entry.is_directory()) {
             std::string metadataPath = entry.path().string() + "/.plotter_project";
             if (fs::exists(metadataPath)) {
-                std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-                Json::Value root;
-                Json::Reader reader;
-                if (reader.parse(content, root)) {
+                auto cached = MetadataCache::instance().load(metadataPath);
+                if (cached) {
+                    const Json::Value& root = *cached;
                     if (root["id"].asString() == projectId) {
                         return entry.path().string();
                     }
@@ -73,6 +74,30 @@ std::string FilesystemProjectDataSource::getProjectMetadataPath(const std::strin
     return projectPath + "/.plotter_project";
 }
 
+std::string FilesystemProjectDataSource::lockProject(const std::string& projectId,
+                                                     std::unique_ptr<FolderLockSet>& lock,
+                                                     bool includeRoot) const {
+    // Find the project, lock it, then make sure no other process removed it meanwhile
+    for (;;) {
+        std::string projectPath = getProjectPath(projectId);
+        if (projectPath.empty()) {
+            return "";
+        }
+
+        std::vector<std::string> folders{projectPath};
+        if (includeRoot) {
+            folders.push_back(rootPath_);
+        }
+        lock.reset(new FolderLockSet(folders));
+
+        auto cached = MetadataCache::instance().load(projectPath + "/.plotter_project");
+        if (cached && (*cached)["id"].asString() == projectId) {
+            return projectPath;
+        }
+        lock.reset();
+    }
+}
+
 std::string FilesystemProjectDataSource::create(dto::ProjectDTO* dto) {
     auto* fsDto = dynamic_cast<FilesystemProjectDTO*>(dto);
     if (!fsDto) {
@@ -84,6 +109,8 @@ std::string FilesystemProjectDataSource::create(dto::ProjectDTO* dto) {
         fsDto->id = FilesystemDTOUtils::generateId();
     }
 
+    FolderLock lock(rootPath_);
+
     // Create project directory
     std::string projectPath = rootPath_ + "/" + fsDto->name;
     fs::create_directories(projectPath);
@@ -110,20 +137,19 @@ std::string FilesystemProjectDataSource::create(dto::ProjectDTO* dto) {
     return fsDto->id;
 }
 
-dto::ProjectDTO* FilesystemProjectDataSource::read(const std::string& id) {
+dto::DTOPtr<dto::ProjectDTO> FilesystemProjectDataSource::read(const std::string& id) {
     std::string metadataPath = getProjectMetadataPath(id);
     if (metadataPath.empty()) {
         return nullptr;
     }
 
-    std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-    Json::Value root;
-    Json::Reader reader;
-    if (!reader.parse(content, root)) {
+    auto cached = MetadataCache::instance().load(metadataPath);
+    if (!cached) {
         throw std::runtime_error("Failed to parse project metadata");
     }
+    const Json::Value& root = *cached;
 
-    auto* dto = new FilesystemProjectDTO();
+    auto dto = std::make_unique<FilesystemProjectDTO>();
     dto->id = root["id"].asString();
     dto->name = root["name"].asString();
     dto->description = root["description"].asString();
@@ -131,7 +157,7 @@ dto::ProjectDTO* FilesystemProjectDataSource::read(const std::string& id) {
     dto->updatedAt = root["updatedAt"].asInt64();
     dto->rootPath = getProjectPath(id);
 
-    const Json::Value folderIds = root["folderIds"];
+    const Json::Value& folderIds = root["folderIds"];
     for (const auto& folderId : folderIds) {
         dto->folderIds.push_back(folderId.asString());
     }
@@ -145,25 +171,41 @@ bool FilesystemProjectDataSource::update(const std::string& id, dto::ProjectDTO*
         throw std::runtime_error("FilesystemProjectDataSource::update - DTO is not a FilesystemProjectDTO");
     }
 
-    std::string metadataPath = getProjectMetadataPath(id);
-    if (metadataPath.empty()) {
+    std::unique_ptr<FolderLockSet> lock;
+    std::string projectPath = lockProject(id, lock, false);
+    if (projectPath.empty()) {
         return false;
     }
+    std::string metadataPath = projectPath + "/.plotter_project";
 
     fsDto->updatedAt = FilesystemDTOUtils::getCurrentTimestamp();
 
-    Json::Value root;
-    root["id"] = fsDto->id;
-    root["name"] = fsDto->name;
-    root["description"] = fsDto->description;
-    root["createdAt"] = (Json::Int64)fsDto->createdAt;
+    // Patch the changed fields into the stored metadata, as for folders
+    std::shared_ptr<const Json::Value> stored;
+    if (fsDto->changes.fields != dto::ChangeMask::ALL) {
+        stored = MetadataCache::instance().load(metadataPath);
+    }
+    dto::ChangeMask changes = stored ? fsDto->changes : dto::ChangeMask();
+    Json::Value root = stored ? *stored : Json::Value();
+    if (!stored) {
+        root["id"] = fsDto->id;
+        root["createdAt"] = (Json::Int64)fsDto->createdAt;
+    }
+    if (changes.has(dto::ChangeMask::NAME)) {
+        root["name"] = fsDto->name;
+    }
+    if (changes.has(dto::ChangeMask::DESCRIPTION)) {
+        root["description"] = fsDto->description;
+    }
     root["updatedAt"] = (Json::Int64)fsDto->updatedAt;
 
-    Json::Value folderIds(Json::arrayValue);
-    for (const auto& fid : fsDto->folderIds) {
-        folderIds.append(fid);
+    if (changes.has(dto::ChangeMask::CHILDREN)) {
+        Json::Value folderIds(Json::arrayValue);
+        for (const auto& fid : fsDto->folderIds) {
+            folderIds.append(fid);
+        }
+        root["folderIds"] = folderIds;
     }
-    root["folderIds"] = folderIds;
 
     Json::StyledWriter writer;
     FilesystemDTOUtils::writeDotfile(metadataPath, writer.write(root));
@@ -172,41 +214,47 @@ bool FilesystemProjectDataSource::update(const std::string& id, dto::ProjectDTO*
 }
 
 bool FilesystemProjectDataSource::remove(const std::string& id) {
-    std::string projectPath = getProjectPath(id);
+    std::unique_ptr<FolderLockSet> lock;
+    std::string projectPath = lockProject(id, lock, true);
     if (projectPath.empty()) {
         return false;
     }
 
-    fs::remove_all(projectPath);
+    TrashBin(rootPath_).trash("project", id, {projectPath});
     return true;
 }
 
-std::vector<dto::ProjectDTO*> FilesystemProjectDataSource::list() {
-    std::vector<dto::ProjectDTO*> projects;
+bool FilesystemProjectDataSource::restore(const std::string& id) {
+    return TrashBin(rootPath_).restore(id);
+}
+
+dto::DTOList<dto::ProjectDTO> FilesystemProjectDataSource::list() {
+    dto::DTOList<dto::ProjectDTO> projects;
 
     for (const auto& entry : fs::directory_iterator(rootPath_)) {
         if (entry.is_directory()) {
             std::string metadataPath = entry.path().string() + "/.plotter_project";
             if (fs::exists(metadataPath)) {
                 try {
-                    std::string content = FilesystemDTOUtils::readDotfile(metadataPath);
-                    Json::Value root;
-                    Json::Reader reader;
-                    if (reader.parse(content, root)) {
-                        auto* dto = new FilesystemProjectDTO();
-                        dto->id = root["id"].asString();
-                        dto->name = root["name"].asString();
-                        dto->description = root["description"].asString();
-                        dto->createdAt = root["createdAt"].asInt64();
-                        dto->updatedAt = root["updatedAt"].asInt64();
-                        dto->rootPath = entry.path().string();
-
-                        const Json::Value folderIds = root["folderIds"];
+                    auto cached = MetadataCache::instance().load(metadataPath);
+                    if (cached) {
+                        const Json::Value& root = *cached;
+                        // Built aside and moved in, so metadata that fails
+                        // to parse leaves no half-filled entry in the list
+                        FilesystemProjectDTO dto;
+                        dto.id = root["id"].asString();
+                        dto.name = root["name"].asString();
+                        dto.description = root["description"].asString();
+                        dto.createdAt = root["createdAt"].asInt64();
+                        dto.updatedAt = root["updatedAt"].asInt64();
+                        dto.rootPath = entry.path().string();
+
+                        const Json::Value& folderIds = root["folderIds"];
                         for (const auto& folderId : folderIds) {
-                            dto->folderIds.push_back(folderId.asString());
+                            dto.folderIds.push_back(folderId.asString());
                         }
 
-                        projects.push_back(dto);
+                        projects.emplace_back<FilesystemProjectDTO>(std::move(dto));
                     }
                 } catch (const std::exception&) {
                     // Skip invalid projects
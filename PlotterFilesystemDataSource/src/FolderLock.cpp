@@ -0,0 +1,110 @@
+#include "plotter_filesystem/FolderLock.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace plotter {
+namespace filesystem {
+
+namespace {
+
+struct HeldLock {
+    FolderLock::Mode mode;
+    size_t depth;
+};
+
+// Locks held by the calling thread, for re-entrancy
+std::unordered_map<std::string, HeldLock>& heldLocks() {
+    thread_local std::unordered_map<std::string, HeldLock> held;
+    return held;
+}
+
+bool lockFile(int fd, FolderLock::Mode mode) {
+#if defined(F_OFD_SETLKW)
+    struct flock request;
+    std::memset(&request, 0, sizeof(request));
+    request.l_type = mode == FolderLock::Mode::Exclusive ? F_WRLCK : F_RDLCK;
+    request.l_whence = SEEK_SET;
+    for (;;) {
+        if (::fcntl(fd, F_OFD_SETLKW, &request) == 0) {
+            return true;
+        }
+        if (errno == EINVAL) {
+            break;   // Kernel without OFD locks; use flock() below
+        }
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+#endif
+    int operation = mode == FolderLock::Mode::Exclusive ? LOCK_EX : LOCK_SH;
+    while (::flock(fd, operation) != 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+FolderLock::FolderLock(const std::string& folderPath, Mode mode)
+    : folderPath_(folderPath), fd_(-1) {
+    auto& held = heldLocks();
+    auto it = held.find(folderPath);
+    if (it != held.end()) {
+        if (it->second.mode == Mode::Shared && mode == Mode::Exclusive) {
+            throw std::runtime_error("Cannot upgrade a shared folder lock: " + folderPath);
+        }
+        it->second.depth++;
+        return;
+    }
+
+    std::string lockPath = folderPath + "/" + FILENAME;
+    int fd = ::open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open folder lock " + lockPath + ": " + std::strerror(errno));
+    }
+    if (!lockFile(fd, mode)) {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Failed to lock folder " + folderPath + ": " + std::strerror(error));
+    }
+
+    fd_ = fd;
+    held.emplace(folderPath, HeldLock{mode, 1});
+}
+
+FolderLock::~FolderLock() {
+    auto& held = heldLocks();
+    auto it = held.find(folderPath_);
+    if (it != held.end() && --it->second.depth == 0) {
+        held.erase(it);
+    }
+    if (fd_ >= 0) {
+        // Closing the last descriptor of the open file releases the lock
+        ::close(fd_);
+    }
+}
+
+bool FolderLock::isHeld(const std::string& folderPath) {
+    return heldLocks().count(folderPath) > 0;
+}
+
+FolderLockSet::FolderLockSet(std::vector<std::string> folderPaths, FolderLock::Mode mode) {
+    std::sort(folderPaths.begin(), folderPaths.end());
+    folderPaths.erase(std::unique(folderPaths.begin(), folderPaths.end()), folderPaths.end());
+
+    locks_.reserve(folderPaths.size());
+    for (const auto& folderPath : folderPaths) {
+        locks_.push_back(std::unique_ptr<FolderLock>(new FolderLock(folderPath, mode)));
+    }
+}
+
+} // namespace filesystem
+} // namespace plotter
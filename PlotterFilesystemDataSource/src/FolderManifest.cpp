@@ -0,0 +1,366 @@
+#include "plotter_filesystem/FolderManifest.h"
+#include "plotter_filesystem/FolderLock.h"
+#include "plotter_filesystem/MetadataCache.h"
+#include "plotter_filesystem_dtos/FilesystemDTOs.h"
+#include "plotter_filesystem_dtos/AtomicFileWriter.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <sys/stat.h>
+#include <json/json.h>
+
+namespace fs = std::filesystem;
+using namespace plotter::filesystem_dtos;
+
+namespace plotter {
+namespace filesystem {
+
+namespace {
+
+// Compact once the file holds this many more records than live entries
+constexpr size_t COMPACTION_SLACK = 16;
+
+// Manifests whose replayed state is kept in memory
+constexpr size_t CACHED_MANIFESTS = 256;
+
+std::string toLine(const Json::Value& record) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, record) + "\n";
+}
+
+ManifestEntry toEntry(const Json::Value& record) {
+    ManifestEntry entry;
+    entry.id = record["id"].asString();
+    entry.name = record["name"].asString();
+    entry.file = record["file"].asString();
+    entry.parentFolderId = record["parentFolderId"].asString();
+    entry.createdAt = record["createdAt"].asInt64();
+    entry.updatedAt = record["updatedAt"].asInt64();
+    return entry;
+}
+
+struct FileStamp {
+    uint64_t device = 0;
+    uint64_t inode = 0;
+    int64_t mtimeNs = 0;
+    int64_t size = 0;
+
+    bool operator==(const FileStamp& other) const {
+        return device == other.device && inode == other.inode &&
+               mtimeNs == other.mtimeNs && size == other.size;
+    }
+};
+
+bool statFile(const std::string& path, FileStamp& out) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    out.device = static_cast<uint64_t>(st.st_dev);
+    out.inode = static_cast<uint64_t>(st.st_ino);
+#ifdef __APPLE__
+    out.mtimeNs = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    out.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    out.size = static_cast<int64_t>(st.st_size);
+    return true;
+}
+
+// The record log replayed into its live entries, in the order they were first
+// added, with an index by id. Records appended by this process are applied
+// directly, so only a change made by someone else forces a re-read.
+struct Replay {
+    bool current = false;        // stamp describes the file as replayed
+    FileStamp stamp;
+    std::vector<ManifestEntry> slots;
+    std::vector<bool> live;
+    std::unordered_map<std::string, size_t> positions;   // Live entries only
+    size_t liveCount = 0;
+    size_t records = 0;          // Lines on disk, live or dead
+
+    const ManifestEntry* find(const std::string& id) const {
+        auto it = positions.find(id);
+        return it == positions.end() ? nullptr : &slots[it->second];
+    }
+
+    void apply(const Json::Value& record) {
+        records++;
+        std::string id = record["id"].asString();
+        auto it = positions.find(id);
+        if (record["op"].asString() == "del") {
+            if (it != positions.end()) {
+                live[it->second] = false;
+                positions.erase(it);
+                liveCount--;
+            }
+        } else if (it != positions.end()) {
+            slots[it->second] = toEntry(record);
+        } else {
+            positions.emplace(std::move(id), slots.size());
+            slots.push_back(toEntry(record));
+            live.push_back(true);
+            liveCount++;
+        }
+    }
+
+    std::vector<ManifestEntry> entries() const {
+        std::vector<ManifestEntry> result;
+        result.reserve(liveCount);
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (live[i]) {
+                result.push_back(slots[i]);
+            }
+        }
+        return result;
+    }
+
+    void reset(std::vector<ManifestEntry> entries) {
+        slots = std::move(entries);
+        live.assign(slots.size(), true);
+        positions.clear();
+        for (size_t i = 0; i < slots.size(); i++) {
+            positions[slots[i].id] = i;
+        }
+        liveCount = records = slots.size();
+    }
+
+    // Adopt the file's current stamp after writing it ourselves
+    void restamp(const std::string& path) {
+        current = statFile(path, stamp);
+    }
+
+    void refresh(const std::string& path) {
+        FileStamp onDisk;
+        if (!statFile(path, onDisk)) {
+            reset({});
+            current = false;
+            return;
+        }
+        if (current && stamp == onDisk) {
+            return;
+        }
+
+        std::ifstream file(path);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+
+        reset({});
+        Json::Reader reader;
+        std::istringstream lines(buffer.str());
+        for (std::string line; std::getline(lines, line);) {
+            Json::Value record;
+            if (line.empty() || !reader.parse(line, record) || !record.isObject()) {
+                continue;  // Torn tail from an interrupted append
+            }
+            apply(record);
+        }
+        stamp = onDisk;
+        current = true;
+    }
+};
+
+// Replays of recently used manifests, shared by every FolderManifest of the
+// process. Each replay has its own mutex; mutations additionally hold the
+// folder's FolderLock, which keeps other processes out while they restamp.
+class ReplayCache {
+public:
+    struct Slot {
+        std::mutex mutex;
+        Replay replay;
+    };
+
+    static ReplayCache& instance() {
+        static ReplayCache cache;
+        return cache;
+    }
+
+    std::shared_ptr<Slot> slot(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = slots_.find(path);
+        if (it != slots_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second.second);
+            return it->second.first;
+        }
+        lru_.push_front(path);
+        auto slot = std::make_shared<Slot>();
+        slots_.emplace(path, std::make_pair(slot, lru_.begin()));
+        if (slots_.size() > CACHED_MANIFESTS) {
+            slots_.erase(lru_.back());
+            lru_.pop_back();
+        }
+        return slot;
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::pair<std::shared_ptr<Slot>, std::list<std::string>::iterator>> slots_;
+    std::list<std::string> lru_;   // Most recently used at the front
+};
+
+// The manifest's replay, locked and brought up to date with the file
+class CurrentReplay {
+public:
+    explicit CurrentReplay(const std::string& path)
+        : slot_(ReplayCache::instance().slot(path)), lock_(slot_->mutex) {
+        slot_->replay.refresh(path);
+    }
+
+    Replay& operator*() { return slot_->replay; }
+    Replay* operator->() { return &slot_->replay; }
+
+private:
+    std::shared_ptr<ReplayCache::Slot> slot_;
+    std::unique_lock<std::mutex> lock_;
+};
+
+Json::Value putRecord(const ManifestEntry& entry) {
+    Json::Value record;
+    record["op"] = "put";
+    record["id"] = entry.id;
+    record["name"] = entry.name;
+    record["file"] = entry.file;
+    record["parentFolderId"] = entry.parentFolderId;
+    record["createdAt"] = (Json::Int64)entry.createdAt;
+    record["updatedAt"] = (Json::Int64)entry.updatedAt;
+    return record;
+}
+
+void rewriteManifest(const std::string& path, Replay& replay, std::vector<ManifestEntry> entries) {
+    std::string content;
+    for (const auto& entry : entries) {
+        content += toLine(putRecord(entry));
+    }
+    AtomicFileWriter::writeFile(path, content);
+    replay.reset(std::move(entries));
+    replay.restamp(path);
+}
+
+void appendRecord(const std::string& path, Replay& replay, const Json::Value& record) {
+    AtomicFileWriter::truncateTornTail(path);
+    AtomicFileWriter::appendFile(path, toLine(record));
+    replay.apply(record);
+
+    if (replay.records > 2 * replay.liveCount + COMPACTION_SLACK) {
+        rewriteManifest(path, replay, replay.entries());
+    } else {
+        replay.restamp(path);
+    }
+}
+
+} // namespace
+
+FolderManifest::FolderManifest(const std::string& folderPath)
+    : folderPath_(folderPath), manifestPath_(folderPath + "/" + FILENAME) {
+}
+
+bool FolderManifest::exists(const std::string& folderPath) {
+    return fs::exists(folderPath + "/" + FILENAME);
+}
+
+std::vector<ManifestEntry> FolderManifest::load() const {
+    return CurrentReplay(manifestPath_)->entries();
+}
+
+bool FolderManifest::find(const std::string& id, ManifestEntry& out) const {
+    CurrentReplay replay(manifestPath_);
+    const ManifestEntry* entry = replay->find(id);
+    if (!entry) {
+        return false;
+    }
+    out = *entry;
+    return true;
+}
+
+void FolderManifest::put(const ManifestEntry& entry) {
+    FolderLock lock(folderPath_);
+    CurrentReplay replay(manifestPath_);
+    appendRecord(manifestPath_, *replay, putRecord(entry));
+}
+
+bool FolderManifest::remove(const std::string& id) {
+    FolderLock lock(folderPath_);
+    CurrentReplay replay(manifestPath_);
+    if (!replay->find(id)) {
+        return false;
+    }
+
+    Json::Value record;
+    record["op"] = "del";
+    record["id"] = id;
+    appendRecord(manifestPath_, *replay, record);
+    return true;
+}
+
+void FolderManifest::compact() {
+    FolderLock lock(folderPath_);
+    CurrentReplay replay(manifestPath_);
+    rewriteManifest(manifestPath_, *replay, replay->entries());
+}
+
+size_t FolderManifest::migrateFromSidecars(const std::string& folderPath) {
+    FolderManifest manifest(folderPath);
+    FolderLock lock(folderPath);
+    CurrentReplay replay(manifest.manifestPath_);
+
+    std::vector<ManifestEntry> entries = replay->entries();
+    std::unordered_map<std::string, size_t> positions;   // id -> index in entries
+    positions.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        positions.emplace(entries[i].id, i);
+    }
+    std::vector<std::string> sidecars;
+
+    for (const auto& dirEntry : fs::directory_iterator(folderPath)) {
+        if (!dirEntry.is_regular_file()) {
+            continue;
+        }
+        std::string metadataPath = dirEntry.path().string() + ".plotter_meta";
+        if (!fs::exists(metadataPath)) {
+            continue;
+        }
+
+        auto cached = MetadataCache::instance().load(metadataPath);
+        if (!cached) {
+            continue;
+        }
+        const Json::Value& root = *cached;
+
+        ManifestEntry entry;
+        entry.id = root["id"].asString();
+        entry.name = root["name"].asString();
+        entry.file = dirEntry.path().filename().string();
+        entry.parentFolderId = root["parentFolderId"].asString();
+        entry.createdAt = root["createdAt"].asInt64();
+        entry.updatedAt = root["updatedAt"].asInt64();
+
+        auto existing = positions.emplace(entry.id, entries.size());
+        if (existing.second) {
+            entries.push_back(std::move(entry));
+        } else {
+            entries[existing.first->second] = std::move(entry);
+        }
+        sidecars.push_back(metadataPath);
+    }
+
+    if (sidecars.empty() && manifest.exists(folderPath)) {
+        return 0;
+    }
+
+    rewriteManifest(manifest.manifestPath_, *replay, std::move(entries));
+    for (const auto& sidecar : sidecars) {
+        fs::remove(sidecar);
+    }
+    return sidecars.size();
+}
+
+} // namespace filesystem
+} // namespace plotter
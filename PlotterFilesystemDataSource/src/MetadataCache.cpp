@@ -0,0 +1,128 @@
+#include "plotter_filesystem/MetadataCache.h"
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace plotter {
+namespace filesystem {
+
+namespace {
+
+bool parseJson(const std::string& content, Json::Value& out) {
+    Json::Reader reader;
+    return reader.parse(content, out);
+}
+
+// Parsed jsoncpp trees are several times larger than their source text
+constexpr size_t PARSED_SIZE_FACTOR = 4;
+constexpr size_t ENTRY_OVERHEAD = 128;
+
+} // namespace
+
+MetadataCache::MetadataCache() : budget_(DEFAULT_BUDGET) {
+}
+
+MetadataCache& MetadataCache::instance() {
+    static MetadataCache cache;
+    return cache;
+}
+
+std::shared_ptr<const Json::Value> MetadataCache::load(const std::string& path) {
+    return load(path, parseJson);
+}
+
+std::shared_ptr<const Json::Value> MetadataCache::load(const std::string& path, Parser parser) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return nullptr;
+    }
+
+    FileStamp stamp;
+    stamp.device = static_cast<uint64_t>(st.st_dev);
+    stamp.inode = static_cast<uint64_t>(st.st_ino);
+#ifdef __APPLE__
+    stamp.mtimeNs = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    stamp.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    stamp.size = static_cast<int64_t>(st.st_size);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(path);
+        if (it != entries_.end() && it->second.stamp == stamp) {
+            stats_.hits++;
+            lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+            return it->second.value;
+        }
+        stats_.misses++;
+    }
+
+    // Read and parse without holding the lock
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    auto value = std::make_shared<Json::Value>();
+    if (!parser(buffer.str(), *value)) {
+        return nullptr;
+    }
+
+    size_t cost = static_cast<size_t>(stamp.size) * PARSED_SIZE_FACTOR + path.size() + ENTRY_OVERHEAD;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(path);
+    if (it != entries_.end()) {
+        stats_.bytes -= it->second.cost;
+        lru_.erase(it->second.lruPosition);
+        entries_.erase(it);
+    }
+    if (cost <= budget_) {
+        lru_.push_front(path);
+        entries_[path] = Entry{stamp, value, cost, lru_.begin()};
+        stats_.bytes += cost;
+        evictToBudget();
+    }
+    stats_.entries = entries_.size();
+    return value;
+}
+
+void MetadataCache::evictToBudget() {
+    while (stats_.bytes > budget_ && !lru_.empty()) {
+        auto it = entries_.find(lru_.back());
+        stats_.bytes -= it->second.cost;
+        entries_.erase(it);
+        lru_.pop_back();
+        stats_.evictions++;
+    }
+    stats_.entries = entries_.size();
+}
+
+void MetadataCache::setBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = bytes;
+    evictToBudget();
+}
+
+size_t MetadataCache::getBudget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_;
+}
+
+void MetadataCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    stats_ = Stats();
+}
+
+MetadataCache::Stats MetadataCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace filesystem
+} // namespace plotter
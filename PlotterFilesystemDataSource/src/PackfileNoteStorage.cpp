@@ -0,0 +1,682 @@
+#include "plotter_filesystem/PackfileNoteStorage.h"
+#include "plotter_filesystem_dtos/AtomicFileWriter.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using plotter::filesystem_dtos::AtomicFileWriter;
+using plotter::filesystem_dtos::GroupCommitCoordinator;
+
+namespace plotter {
+namespace filesystem {
+
+namespace {
+
+constexpr const char* LIST_FILENAME = "packs.list";
+constexpr uint32_t RECORD_MAGIC = 0x52544c50;   // "PLTR"
+constexpr char INDEX_MAGIC[8] = {'P', 'L', 'T', 'I', 'D', 'X', '1', '\0'};
+constexpr uint8_t RECORD_PUT = 1;
+constexpr uint8_t RECORD_TOMBSTONE = 2;
+
+// Repack output is flushed to disk in chunks of this size
+constexpr size_t REPACK_BUFFER = 1024 * 1024;
+
+struct RecordHeader {
+    uint32_t magic;
+    uint8_t type;
+    uint8_t reserved[3];
+    uint32_t keyLength;
+    uint32_t valueLength;
+    uint32_t checksum;       // Over type, key and value
+};
+static_assert(sizeof(RecordHeader) == 20, "RecordHeader must be packed");
+
+struct IndexHeader {
+    char magic[8];
+    uint64_t count;
+};
+
+struct IndexEntry {
+    uint64_t hash;
+    uint64_t offset;
+    uint32_t size;
+    uint32_t type;
+};
+static_assert(sizeof(IndexEntry) == 24, "IndexEntry must be packed");
+
+uint64_t hashKey(const char* data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint32_t checksumRecord(uint8_t type, const char* key, size_t keyLength,
+                        const char* value, size_t valueLength) {
+    uint32_t hash = 0x811c9dc5u ^ type;
+    hash *= 0x01000193u;
+    for (size_t i = 0; i < keyLength; i++) {
+        hash = (hash ^ static_cast<unsigned char>(key[i])) * 0x01000193u;
+    }
+    for (size_t i = 0; i < valueLength; i++) {
+        hash = (hash ^ static_cast<unsigned char>(value[i])) * 0x01000193u;
+    }
+    return hash;
+}
+
+std::string encodeRecord(uint8_t type, const std::string& key, const std::string* value) {
+    RecordHeader header{};
+    header.magic = RECORD_MAGIC;
+    header.type = type;
+    header.keyLength = static_cast<uint32_t>(key.size());
+    header.valueLength = value ? static_cast<uint32_t>(value->size()) : 0;
+    header.checksum = checksumRecord(type, key.data(), key.size(),
+                                     value ? value->data() : nullptr, header.valueLength);
+
+    std::string record(reinterpret_cast<const char*>(&header), sizeof(header));
+    record += key;
+    if (value) {
+        record += *value;
+    }
+    return record;
+}
+
+void writeAll(int fd, const char* data, size_t size, uint64_t offset, const std::string& path) {
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write pack " + path + ": " + std::strerror(errno));
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+}
+
+void syncData(int fd, const std::string& path) {
+#if defined(__APPLE__)
+    int result = ::fsync(fd);
+#else
+    int result = ::fdatasync(fd);
+#endif
+    if (result != 0) {
+        throw std::runtime_error("Failed to sync pack " + path + ": " + std::strerror(errno));
+    }
+}
+
+/**
+ * @brief Read-only mapping of a whole file
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat " + path + ": " + std::strerror(errno));
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Failed to map " + path + ": " + std::strerror(errno));
+            }
+            data_ = static_cast<const char*>(mapped);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_;
+    size_t size_;
+};
+
+/**
+ * @brief Walk the well-formed records of a pack image
+ * @return Length of the valid prefix; anything after it is a torn append
+ */
+template <typename Visitor>
+size_t scanRecords(const char* data, size_t size, Visitor visit) {
+    size_t offset = 0;
+    while (size - offset >= sizeof(RecordHeader)) {
+        RecordHeader header;
+        std::memcpy(&header, data + offset, sizeof(header));
+        uint64_t length = sizeof(header) + static_cast<uint64_t>(header.keyLength) + header.valueLength;
+        if (header.magic != RECORD_MAGIC || length > size - offset ||
+            (header.type != RECORD_PUT && header.type != RECORD_TOMBSTONE)) {
+            break;
+        }
+        const char* key = data + offset + sizeof(header);
+        const char* value = key + header.keyLength;
+        if (checksumRecord(header.type, key, header.keyLength, value, header.valueLength) != header.checksum) {
+            break;
+        }
+        visit(offset, header, key);
+        offset += static_cast<size_t>(length);
+    }
+    return offset;
+}
+
+std::string packFile(const std::string& packsPath, const std::string& name) {
+    return packsPath + "/" + name + ".pack";
+}
+
+std::string indexFile(const std::string& packsPath, const std::string& name) {
+    return packsPath + "/" + name + ".idx";
+}
+
+void writeIndex(const std::string& path, std::vector<IndexEntry>& entries) {
+    std::sort(entries.begin(), entries.end(), [](const IndexEntry& a, const IndexEntry& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.offset < b.offset;
+    });
+
+    IndexHeader header;
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.count = entries.size();
+
+    std::string content(reinterpret_cast<const char*>(&header), sizeof(header));
+    content.append(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(IndexEntry));
+    AtomicFileWriter::writeFile(path, content);
+}
+
+} // namespace
+
+/**
+ * @brief A sealed pack and its index, both memory-mapped
+ */
+struct PackfileNoteStorage::SealedPack {
+    std::string name;
+    MappedFile pack;
+    MappedFile index;
+
+    SealedPack(const std::string& packsPath, const std::string& packName)
+        : name(packName),
+          pack(packFile(packsPath, packName)),
+          index(indexFile(packsPath, packName)) {
+        IndexHeader header;
+        if (index.size() < sizeof(header)) {
+            throw std::runtime_error("Truncated pack index: " + indexFile(packsPath, packName));
+        }
+        std::memcpy(&header, index.data(), sizeof(header));
+        if (std::memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) != 0 ||
+            header.count > (index.size() - sizeof(header)) / sizeof(IndexEntry)) {
+            throw std::runtime_error("Corrupt pack index: " + indexFile(packsPath, packName));
+        }
+    }
+
+    size_t count() const {
+        IndexHeader header;
+        std::memcpy(&header, index.data(), sizeof(header));
+        return static_cast<size_t>(header.count);
+    }
+
+    const IndexEntry* entries() const {
+        return reinterpret_cast<const IndexEntry*>(index.data() + sizeof(IndexHeader));
+    }
+
+    RecordHeader recordAt(uint64_t offset) const {
+        RecordHeader header;
+        std::memcpy(&header, pack.data() + offset, sizeof(header));
+        return header;
+    }
+
+    /**
+     * @brief Binary search the index, then confirm the key in the pack
+     */
+    const IndexEntry* find(const std::string& key, uint64_t hash) const {
+        const IndexEntry* begin = entries();
+        const IndexEntry* end = begin + count();
+        const IndexEntry* it = std::lower_bound(begin, end, hash,
+            [](const IndexEntry& entry, uint64_t value) { return entry.hash < value; });
+        for (; it != end && it->hash == hash; ++it) {
+            RecordHeader header = recordAt(it->offset);
+            if (header.keyLength == key.size() &&
+                std::memcmp(pack.data() + it->offset + sizeof(header), key.data(), key.size()) == 0) {
+                return it;
+            }
+        }
+        return nullptr;
+    }
+};
+
+PackfileNoteStorage::FileHandle::~FileHandle() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+PackfileNoteStorage::PackfileNoteStorage(const std::string& rootDir, uint64_t maxPackSize)
+    : packsPath_(rootDir + "/" + PACKS_DIRECTORY),
+      maxPackSize_(maxPackSize),
+      activeSize_(0),
+      nextSequence_(1),
+      sealedBytes_(0),
+      deadBytes_(0),
+      activeDeadBytes_(0),
+      repacks_(0),
+      stopRepacker_(false) {
+    fs::create_directories(packsPath_);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    std::ifstream list(packsPath_ + "/" + LIST_FILENAME);
+    if (!list.is_open()) {
+        openActiveLocked(nextPackNameLocked(), false);
+        writeListLocked();
+        return;
+    }
+
+    // packs.list: "next <seq>", "dead <bytes>", then "sealed <name>" lines oldest first and one "active <name>"
+    std::string activeName;
+    std::string kind;
+    std::string value;
+    while (list >> kind >> value) {
+        if (kind == "next") {
+            nextSequence_ = std::stoull(value);
+        } else if (kind == "dead") {
+            deadBytes_ = std::stoull(value);
+        } else if (kind == "sealed") {
+            auto pack = openSealed(value);
+            sealedBytes_ += pack->pack.size();
+            packs_.push_back(std::move(pack));
+        } else if (kind == "active") {
+            activeName = value;
+        }
+    }
+
+    if (activeName.empty()) {
+        openActiveLocked(nextPackNameLocked(), false);
+        writeListLocked();
+    } else {
+        openActiveLocked(activeName, true);
+    }
+}
+
+PackfileNoteStorage::~PackfileNoteStorage() {
+    stopBackgroundRepack();
+}
+
+std::string PackfileNoteStorage::nextPackNameLocked() {
+    char name[32];
+    std::snprintf(name, sizeof(name), "pack-%06llu", static_cast<unsigned long long>(nextSequence_++));
+    return name;
+}
+
+std::shared_ptr<const PackfileNoteStorage::SealedPack> PackfileNoteStorage::openSealed(const std::string& name) const {
+    return std::make_shared<const SealedPack>(packsPath_, name);
+}
+
+void PackfileNoteStorage::openActiveLocked(const std::string& name, bool replay) {
+    std::string path = packFile(packsPath_, name);
+    // Names at or past "next" in packs.list can only belong to leftovers of a crash
+    int flags = O_RDWR | O_CREAT | O_CLOEXEC | (replay ? 0 : O_TRUNC);
+    int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open pack " + path + ": " + std::strerror(errno));
+    }
+
+    activeName_ = name;
+    activeFile_ = std::make_shared<FileHandle>(fd);
+    activeIndex_.clear();
+    activeSize_ = 0;
+    activeDeadBytes_ = 0;
+
+    if (!replay) {
+        GroupCommitCoordinator::instance().syncFile(path, true);
+        return;
+    }
+
+    // Rebuild the in-memory index of the active pack and drop a torn tail
+    MappedFile image(path);
+    size_t valid = scanRecords(image.data(), image.size(),
+        [this](size_t offset, const RecordHeader& header, const char* key) {
+            std::string notePath(key, header.keyLength);
+            uint32_t size = static_cast<uint32_t>(sizeof(header) + header.keyLength + header.valueLength);
+            bool tombstone = header.type == RECORD_TOMBSTONE;
+            countDeadLocked(notePath, tombstone ? size : 0);
+            activeIndex_[notePath] = ActiveEntry{offset, size, tombstone};
+        });
+
+    if (valid < image.size() && ::ftruncate(fd, static_cast<off_t>(valid)) != 0) {
+        throw std::runtime_error("Failed to truncate pack " + path + ": " + std::strerror(errno));
+    }
+    activeSize_ = valid;
+}
+
+void PackfileNoteStorage::writeListLocked() {
+    std::ostringstream list;
+    list << "next " << nextSequence_ << "\n";
+    // The active pack's share is recounted when it is replayed
+    list << "dead " << deadBytes_ - activeDeadBytes_ << "\n";
+    for (const auto& pack : packs_) {
+        list << "sealed " << pack->name << "\n";
+    }
+    list << "active " << activeName_ << "\n";
+    AtomicFileWriter::writeFile(packsPath_ + "/" + LIST_FILENAME, list.str());
+}
+
+bool PackfileNoteStorage::findLocked(const std::string& path, Found& found, std::string* content) const {
+    // Newest first: the active pack, then sealed packs from the youngest
+    auto active = activeIndex_.find(path);
+    if (active != activeIndex_.end()) {
+        found.size = active->second.size;
+        found.tombstone = active->second.tombstone;
+        if (content && !found.tombstone) {
+            size_t length = active->second.size - sizeof(RecordHeader) - path.size();
+            content->resize(length);
+            uint64_t offset = active->second.offset + sizeof(RecordHeader) + path.size();
+            size_t done = 0;
+            while (done < length) {
+                ssize_t n = ::pread(activeFile_->fd, &(*content)[done], length - done,
+                                    static_cast<off_t>(offset + done));
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    throw std::runtime_error("Failed to read pack " + packFile(packsPath_, activeName_));
+                }
+                done += static_cast<size_t>(n);
+            }
+        }
+        return true;
+    }
+
+    uint64_t hash = hashKey(path.data(), path.size());
+    for (auto it = packs_.rbegin(); it != packs_.rend(); ++it) {
+        const IndexEntry* entry = (*it)->find(path, hash);
+        if (!entry) {
+            continue;
+        }
+        found.size = entry->size;
+        found.tombstone = entry->type == RECORD_TOMBSTONE;
+        if (content && !found.tombstone) {
+            const char* value = (*it)->pack.data() + entry->offset + sizeof(RecordHeader) + path.size();
+            content->assign(value, entry->size - sizeof(RecordHeader) - path.size());
+        }
+        return true;
+    }
+    return false;
+}
+
+void PackfileNoteStorage::countDeadLocked(const std::string& path, uint64_t tombstoneSize) {
+    // The version being superseded becomes dead, and so does a tombstone itself
+    Found previous;
+    uint64_t dead = tombstoneSize;
+    if (findLocked(path, previous, nullptr)) {
+        dead += previous.size;
+    }
+    deadBytes_ += dead;
+    activeDeadBytes_ += dead;
+}
+
+void PackfileNoteStorage::appendLocked(const std::string& path, const std::string* content) {
+    uint8_t type = content ? RECORD_PUT : RECORD_TOMBSTONE;
+    std::string record = encodeRecord(type, path, content);
+
+    countDeadLocked(path, content ? 0 : record.size());
+
+    writeAll(activeFile_->fd, record.data(), record.size(), activeSize_, packFile(packsPath_, activeName_));
+    activeIndex_[path] = ActiveEntry{activeSize_, static_cast<uint32_t>(record.size()), !content};
+    activeSize_ += record.size();
+
+    if (activeSize_ >= maxPackSize_) {
+        sealLocked();
+    }
+}
+
+void PackfileNoteStorage::sealLocked() {
+    if (activeSize_ == 0) {
+        return;
+    }
+
+    syncData(activeFile_->fd, packFile(packsPath_, activeName_));
+
+    std::vector<IndexEntry> entries;
+    entries.reserve(activeIndex_.size());
+    for (const auto& record : activeIndex_) {
+        entries.push_back(IndexEntry{hashKey(record.first.data(), record.first.size()),
+                                     record.second.offset, record.second.size,
+                                     record.second.tombstone ? RECORD_TOMBSTONE : RECORD_PUT});
+    }
+    writeIndex(indexFile(packsPath_, activeName_), entries);
+
+    auto sealed = openSealed(activeName_);
+    sealedBytes_ += sealed->pack.size();
+    packs_.push_back(std::move(sealed));
+
+    openActiveLocked(nextPackNameLocked(), false);
+    writeListLocked();
+}
+
+std::string PackfileNoteStorage::loadNote(const std::string& path) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    Found found;
+    std::string content;
+    if (!findLocked(path, found, &content) || found.tombstone) {
+        throw std::runtime_error("Failed to load note from: " + path);
+    }
+    return content;
+}
+
+void PackfileNoteStorage::saveNote(const std::string& path, const std::string& content) {
+    if (path.empty()) {
+        throw std::runtime_error("Invalid note path for pack storage: ''");
+    }
+
+    std::shared_ptr<FileHandle> file;
+    std::string packPath;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        appendLocked(path, &content);
+        file = activeFile_;
+        packPath = packFile(packsPath_, activeName_);
+    }
+    // Concurrent writers sync outside the lock, so one flush can cover several appends
+    syncData(file->fd, packPath);
+}
+
+bool PackfileNoteStorage::noteExists(const std::string& path) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    Found found;
+    return findLocked(path, found, nullptr) && !found.tombstone;
+}
+
+bool PackfileNoteStorage::removeNote(const std::string& path) {
+    std::shared_ptr<FileHandle> file;
+    std::string packPath;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        Found found;
+        if (!findLocked(path, found, nullptr) || found.tombstone) {
+            return false;
+        }
+        appendLocked(path, nullptr);
+        file = activeFile_;
+        packPath = packFile(packsPath_, activeName_);
+    }
+    syncData(file->fd, packPath);
+    return true;
+}
+
+void PackfileNoteStorage::seal() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    sealLocked();
+}
+
+uint64_t PackfileNoteStorage::repack() {
+    std::lock_guard<std::mutex> repackLock(repackMutex_);
+
+    std::vector<std::shared_ptr<const SealedPack>> victims;
+    std::string mergedName;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        sealLocked();
+        victims = packs_;
+        mergedName = nextPackNameLocked();
+    }
+    if (victims.empty()) {
+        return 0;
+    }
+
+    // Copy the newest version of every live note; readers and writers carry on meanwhile
+    std::string mergedPath = packFile(packsPath_, mergedName);
+    int fd = ::open(mergedPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create pack " + mergedPath + ": " + std::strerror(errno));
+    }
+    FileHandle merged(fd);
+
+    uint64_t victimBytes = 0;
+    uint64_t mergedBytes = 0;
+    std::vector<IndexEntry> entries;
+    std::unordered_set<std::string> seen;
+    std::string buffer;
+
+    for (auto it = victims.rbegin(); it != victims.rend(); ++it) {
+        const SealedPack& pack = **it;
+        victimBytes += pack.pack.size();
+
+        const IndexEntry* begin = pack.entries();
+        for (const IndexEntry* entry = begin; entry != begin + pack.count(); ++entry) {
+            RecordHeader header = pack.recordAt(entry->offset);
+            const char* record = pack.pack.data() + entry->offset;
+            if (!seen.emplace(record + sizeof(header), header.keyLength).second ||
+                entry->type == RECORD_TOMBSTONE) {
+                // Shadowed by a newer pack, or deleted; every older pack is merged too
+                continue;
+            }
+
+            entries.push_back(IndexEntry{entry->hash, mergedBytes + buffer.size(), entry->size, RECORD_PUT});
+            buffer.append(record, entry->size);
+            if (buffer.size() >= REPACK_BUFFER) {
+                writeAll(merged.fd, buffer.data(), buffer.size(), mergedBytes, mergedPath);
+                mergedBytes += buffer.size();
+                buffer.clear();
+            }
+        }
+    }
+    writeAll(merged.fd, buffer.data(), buffer.size(), mergedBytes, mergedPath);
+    mergedBytes += buffer.size();
+    syncData(merged.fd, mergedPath);
+
+    std::shared_ptr<const SealedPack> mergedPack;
+    if (!entries.empty()) {
+        writeIndex(indexFile(packsPath_, mergedName), entries);
+        mergedPack = openSealed(mergedName);
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        // Packs sealed while merging are newer than every victim and stay after the merged pack
+        std::vector<std::shared_ptr<const SealedPack>> packs;
+        if (mergedPack) {
+            packs.push_back(mergedPack);
+        }
+        packs.insert(packs.end(), packs_.begin() + victims.size(), packs_.end());
+        packs_ = std::move(packs);
+
+        sealedBytes_ = sealedBytes_ - victimBytes + mergedBytes;
+        deadBytes_ -= std::min(deadBytes_, victimBytes - mergedBytes);
+        repacks_++;
+        writeListLocked();
+        removeOrphansLocked();
+    }
+
+    return victimBytes - mergedBytes;
+}
+
+void PackfileNoteStorage::removeOrphansLocked() const {
+    // Victims of this repack, and leftovers of one that crashed before updating packs.list
+    std::unordered_set<std::string> live{activeName_};
+    for (const auto& pack : packs_) {
+        live.insert(pack->name);
+    }
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(packsPath_, ec)) {
+        std::string extension = entry.path().extension().string();
+        if ((extension == ".pack" || extension == ".idx") && !live.count(entry.path().stem().string())) {
+            // Mapped victims stay readable until their last reader lets go
+            fs::remove(entry.path(), ec);
+        }
+    }
+}
+
+void PackfileNoteStorage::startBackgroundRepack(double deadRatio, std::chrono::milliseconds interval) {
+    stopBackgroundRepack();
+
+    stopRepacker_ = false;
+    repacker_ = std::thread([this, deadRatio, interval]() {
+        std::unique_lock<std::mutex> lock(repackerMutex_);
+        while (!repackerWake_.wait_for(lock, interval, [this]() { return stopRepacker_; })) {
+            Stats stats = getStats();
+            if (stats.deadBytes == 0 || stats.deadBytes < deadRatio * stats.totalBytes) {
+                continue;
+            }
+            lock.unlock();
+            try {
+                repack();
+            } catch (const std::exception&) {
+                // Retried on the next tick; the store is unchanged by a failed repack
+            }
+            lock.lock();
+        }
+    });
+}
+
+void PackfileNoteStorage::stopBackgroundRepack() {
+    {
+        std::lock_guard<std::mutex> lock(repackerMutex_);
+        stopRepacker_ = true;
+    }
+    repackerWake_.notify_all();
+    if (repacker_.joinable()) {
+        repacker_.join();
+    }
+}
+
+PackfileNoteStorage::Stats PackfileNoteStorage::getStats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    Stats stats;
+    stats.packs = packs_.size() + 1;
+    stats.totalBytes = sealedBytes_ + activeSize_;
+    stats.deadBytes = deadBytes_;
+    stats.repacks = repacks_;
+    return stats;
+}
+
+} // namespace filesystem
+} // namespace plotter
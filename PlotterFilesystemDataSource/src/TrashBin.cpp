@@ -0,0 +1,347 @@
+#include "plotter_filesystem/TrashBin.h"
+#include "plotter_filesystem/FolderLock.h"
+#include "plotter_filesystem_dtos/FilesystemDTOs.h"
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <json/json.h>
+
+namespace fs = std::filesystem;
+using namespace plotter::filesystem_dtos;
+
+namespace plotter {
+namespace filesystem {
+
+namespace {
+
+constexpr const char* INFO_FILENAME = ".plotter_trashinfo";
+constexpr const char* RESTORING_PREFIX = ".restoring-";
+constexpr const char* PURGING_PREFIX = ".purging-";
+
+std::string itemPath(const std::string& entryPath, size_t index) {
+    return entryPath + "/" + std::to_string(index);
+}
+
+} // namespace
+
+TrashBin::TrashBin(const std::string& rootPath)
+    : rootPath_(rootPath), trashPath_(rootPath + "/" + DIRECTORY), stopPurger_(false) {
+}
+
+TrashBin::~TrashBin() {
+    stopPurger();
+}
+
+TrashBin::Throttle TrashBin::unthrottled() {
+    Throttle throttle;
+    throttle.filesPerTick = std::numeric_limits<size_t>::max();
+    throttle.pause = std::chrono::milliseconds(0);
+    return throttle;
+}
+
+void TrashBin::trash(const std::string& kind, const std::string& id,
+                     const std::vector<std::string>& paths,
+                     const ManifestEntry* manifestEntry) {
+    fs::create_directories(trashPath_);
+
+    long long deletedAt = FilesystemDTOUtils::getCurrentTimestamp();
+    std::string base = trashPath_ + "/" + std::to_string(deletedAt) + "-" + id;
+    std::string entryPath = base;
+    for (int suffix = 1; !fs::create_directory(entryPath); suffix++) {
+        entryPath = base + "-" + std::to_string(suffix);
+    }
+
+    Json::Value info;
+    info["id"] = id;
+    info["kind"] = kind;
+    info["deletedAt"] = (Json::Int64)deletedAt;
+    Json::Value originalPaths(Json::arrayValue);
+    for (const auto& path : paths) {
+        originalPaths.append(path);
+    }
+    info["originalPaths"] = originalPaths;
+    if (manifestEntry) {
+        Json::Value entry;
+        entry["id"] = manifestEntry->id;
+        entry["name"] = manifestEntry->name;
+        entry["file"] = manifestEntry->file;
+        entry["parentFolderId"] = manifestEntry->parentFolderId;
+        entry["createdAt"] = (Json::Int64)manifestEntry->createdAt;
+        entry["updatedAt"] = (Json::Int64)manifestEntry->updatedAt;
+        info["manifestEntry"] = entry;
+    }
+
+    Json::StyledWriter writer;
+    FilesystemDTOUtils::writeDotfile(entryPath + "/" + INFO_FILENAME, writer.write(info));
+
+    for (size_t i = 0; i < paths.size(); i++) {
+        std::error_code ec;
+        fs::rename(paths[i], itemPath(entryPath, i), ec);
+        if (ec) {
+            // Put back what was already moved, so a failed delete changes nothing
+            for (size_t j = 0; j < i; j++) {
+                std::error_code ignored;
+                fs::rename(itemPath(entryPath, j), paths[j], ignored);
+            }
+            fs::remove_all(entryPath, ec);
+            throw std::runtime_error("Failed to move " + paths[i] + " to the trash");
+        }
+    }
+}
+
+bool TrashBin::readEntry(const std::string& entryPath, Entry& entry) const {
+    Json::Value info;
+    Json::Reader reader;
+    try {
+        if (!reader.parse(FilesystemDTOUtils::readDotfile(entryPath + "/" + INFO_FILENAME), info)) {
+            return false;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    entry.id = info["id"].asString();
+    entry.kind = info["kind"].asString();
+    entry.deletedAt = info["deletedAt"].asInt64();
+    entry.originalPaths.clear();
+    for (const auto& path : info["originalPaths"]) {
+        entry.originalPaths.push_back(path.asString());
+    }
+    entry.path = entryPath;
+    return true;
+}
+
+std::vector<TrashBin::Entry> TrashBin::list() const {
+    std::vector<Entry> entries;
+    std::error_code ec;
+    for (const auto& dirEntry : fs::directory_iterator(trashPath_, ec)) {
+        std::string name = dirEntry.path().filename().string();
+        Entry entry;
+        if (dirEntry.is_directory() && name[0] != '.' && readEntry(dirEntry.path().string(), entry)) {
+            entries.push_back(std::move(entry));
+        }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.deletedAt < b.deletedAt; });
+    return entries;
+}
+
+bool TrashBin::restore(const std::string& id) {
+    for (;;) {
+        std::vector<Entry> entries = list();
+        auto latest = std::find_if(entries.rbegin(), entries.rend(),
+                                   [&id](const Entry& entry) { return entry.id == id; });
+        if (latest == entries.rend() || latest->originalPaths.empty()) {
+            return false;
+        }
+
+        // Held until the entry is gone, so recoverRestores() can tell this restore
+        // from a crashed one. The lock file travels with the entry when it is renamed.
+        std::unique_ptr<FolderLock> entryLock;
+        try {
+            entryLock = std::make_unique<FolderLock>(latest->path);
+        } catch (const std::runtime_error&) {
+            if (!fs::exists(latest->path)) {
+                continue;   // Claimed by a concurrent purge or restore
+            }
+            throw;
+        }
+
+        // Claim the entry so a concurrent purge or restore cannot take it too
+        std::string claimedPath = trashPath_ + "/" + RESTORING_PREFIX +
+                                  fs::path(latest->path).filename().string();
+        std::error_code ec;
+        fs::rename(latest->path, claimedPath, ec);
+        if (ec == std::errc::no_such_file_or_directory) {
+            continue;
+        }
+        if (ec) {
+            throw std::runtime_error("Failed to claim trash entry " + latest->path + ": " + ec.message());
+        }
+
+        std::string parentPath = fs::path(latest->originalPaths[0]).parent_path().string();
+        if (!fs::is_directory(parentPath)) {
+            fs::rename(claimedPath, latest->path, ec);
+            throw std::runtime_error("Cannot restore " + id + ": " + parentPath +
+                                     " no longer exists; restore its parent first");
+        }
+
+        FolderLock lock(parentPath);
+        for (const auto& original : latest->originalPaths) {
+            if (fs::exists(original)) {
+                fs::rename(claimedPath, latest->path, ec);
+                throw std::runtime_error("Cannot restore " + id + ": " + original + " already exists");
+            }
+        }
+        finishRestore(claimedPath, *latest);
+        return true;
+    }
+}
+
+void TrashBin::finishRestore(const std::string& claimedPath, const Entry& entry) {
+    // Items that are already gone were moved back before a crash
+    for (size_t i = 0; i < entry.originalPaths.size(); i++) {
+        std::string item = itemPath(claimedPath, i);
+        if (!fs::exists(item)) {
+            continue;
+        }
+        if (fs::exists(entry.originalPaths[i])) {
+            throw std::runtime_error("Cannot restore " + entry.id + ": " + entry.originalPaths[i] +
+                                     " already exists");
+        }
+        fs::rename(item, entry.originalPaths[i]);
+    }
+
+    Json::Value info;
+    Json::Reader reader;
+    reader.parse(FilesystemDTOUtils::readDotfile(claimedPath + "/" + INFO_FILENAME), info);
+    if (info.isMember("manifestEntry")) {
+        const Json::Value& record = info["manifestEntry"];
+        ManifestEntry manifestEntry;
+        manifestEntry.id = record["id"].asString();
+        manifestEntry.name = record["name"].asString();
+        manifestEntry.file = record["file"].asString();
+        manifestEntry.parentFolderId = record["parentFolderId"].asString();
+        manifestEntry.createdAt = record["createdAt"].asInt64();
+        manifestEntry.updatedAt = record["updatedAt"].asInt64();
+        FolderManifest(fs::path(entry.originalPaths[0]).parent_path().string()).put(manifestEntry);
+    }
+
+    std::error_code ec;
+    fs::remove_all(claimedPath, ec);
+}
+
+void TrashBin::recoverRestores() {
+    std::vector<fs::path> claimed;
+    std::error_code ec;
+    for (const auto& dirEntry : fs::directory_iterator(trashPath_, ec)) {
+        if (dirEntry.path().filename().string().compare(0, 11, RESTORING_PREFIX) == 0) {
+            claimed.push_back(dirEntry.path());
+        }
+    }
+
+    for (const auto& claimedPath : claimed) {
+        try {
+            // Waits for a restore that is still running; once it has the lock, the restore is dead
+            FolderLock entryLock(claimedPath.string());
+            Entry entry;
+            if (!readEntry(claimedPath.string(), entry) || entry.originalPaths.empty()) {
+                // Everything was moved back and only the cleanup was cut short
+                fs::remove_all(claimedPath, ec);
+                continue;
+            }
+
+            std::string parentPath = fs::path(entry.originalPaths[0]).parent_path().string();
+            if (!fs::is_directory(parentPath)) {
+                // Hand the entry back to the trash until its parent is restored
+                std::string name = claimedPath.filename().string().substr(11);
+                fs::rename(claimedPath, trashPath_ + "/" + name, ec);
+                continue;
+            }
+            FolderLock lock(parentPath);
+            finishRestore(claimedPath.string(), entry);
+        } catch (const std::exception&) {
+            // Finished by someone else meanwhile, or retried by the next purge
+        }
+    }
+}
+
+size_t TrashBin::purgeExpired(std::chrono::milliseconds retention, const Throttle& throttle) {
+    recoverRestores();
+
+    long long cutoff = FilesystemDTOUtils::getCurrentTimestamp() - retention.count();
+
+    std::vector<std::string> claimed;
+    for (const auto& entry : list()) {
+        if (entry.deletedAt > cutoff) {
+            continue;
+        }
+        std::string claimedPath = trashPath_ + "/" + PURGING_PREFIX + fs::path(entry.path).filename().string();
+        std::error_code ec;
+        fs::rename(entry.path, claimedPath, ec);
+        if (!ec) {
+            claimed.push_back(claimedPath);
+        }
+    }
+
+    // Also finish purges that an earlier run (or a crashed process) left behind
+    std::error_code ec;
+    for (const auto& dirEntry : fs::directory_iterator(trashPath_, ec)) {
+        std::string path = dirEntry.path().string();
+        if (dirEntry.path().filename().string().compare(0, 9, PURGING_PREFIX) == 0 &&
+            std::find(claimed.begin(), claimed.end(), path) == claimed.end()) {
+            claimed.push_back(path);
+        }
+    }
+
+    size_t purged = 0;
+    for (const auto& path : claimed) {
+        if (!purgeEntry(path, throttle)) {
+            break;
+        }
+        purged++;
+    }
+    return purged;
+}
+
+bool TrashBin::purgeEntry(const std::string& entryPath, const Throttle& throttle) {
+    // Pre-order listing; deleting it back to front removes children before their directories
+    std::vector<fs::path> paths;
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(entryPath, ec); it != fs::recursive_directory_iterator();
+         it.increment(ec)) {
+        paths.push_back(it->path());
+    }
+    paths.push_back(entryPath);
+
+    size_t inTick = 0;
+    for (auto it = paths.rbegin(); it != paths.rend(); ++it) {
+        fs::remove(*it, ec);
+        if (++inTick < throttle.filesPerTick) {
+            continue;
+        }
+        inTick = 0;
+        if (throttle.pause.count() > 0) {
+            std::unique_lock<std::mutex> lock(purgerMutex_);
+            if (purgerWake_.wait_for(lock, throttle.pause, [this]() { return stopPurger_; })) {
+                return false;   // Stopping; the claimed entry is finished by the next purge
+            }
+        }
+    }
+    return true;
+}
+
+void TrashBin::startPurger(std::chrono::milliseconds retention, std::chrono::milliseconds interval,
+                           const Throttle& throttle) {
+    stopPurger();
+
+    stopPurger_ = false;
+    purger_ = std::thread([this, retention, interval, throttle]() {
+        std::unique_lock<std::mutex> lock(purgerMutex_);
+        while (!purgerWake_.wait_for(lock, interval, [this]() { return stopPurger_; })) {
+            lock.unlock();
+            try {
+                purgeExpired(retention, throttle);
+            } catch (const std::exception&) {
+                // Retried on the next tick
+            }
+            lock.lock();
+        }
+    });
+}
+
+void TrashBin::stopPurger() {
+    {
+        std::lock_guard<std::mutex> lock(purgerMutex_);
+        stopPurger_ = true;
+    }
+    purgerWake_.notify_all();
+    if (purger_.joinable()) {
+        purger_.join();
+    }
+}
+
+} // namespace filesystem
+} // namespace plotter
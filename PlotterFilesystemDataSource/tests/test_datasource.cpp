@@ -1,8 +1,23 @@
 #include "plotter_filesystem/FilesystemDataSource.h"
+#include "plotter_filesystem/MetadataCache.h"
+#include "plotter_filesystem/BatchFileReader.h"
+#include "plotter_filesystem/ContentAddressedNoteStorage.h"
+#include "plotter_filesystem/FilesystemNoteStorage.h"
+#include "plotter_filesystem/PackfileNoteStorage.h"
+#include "plotter_filesystem/FolderLock.h"
+#include "plotter_filesystem/TrashBin.h"
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 using namespace plotter::filesystem;
 using namespace plotter::filesystem_dtos;
@@ -21,6 +36,16 @@ void setup() {
     fs::create_directories(TEST_ROOT);
 }
 
+// Downcast the handle returned by read(); null if nothing was found
+template<typename T, typename Base>
+std::unique_ptr<T> as(std::unique_ptr<Base> dto) {
+    T* concrete = dynamic_cast<T*>(dto.get());
+    if (concrete) {
+        dto.release();
+    }
+    return std::unique_ptr<T>(concrete);
+}
+
 void testProjectDataSourceConnection() {
     FilesystemProjectDataSource ds("test-project-ds", TEST_ROOT);
 
@@ -70,23 +95,21 @@ void testProjectReadAndList() {
     std::string projectId = ds.create(&createDto);
 
     // Read it back
-    auto* readDto = dynamic_cast<FilesystemProjectDTO*>(ds.read(projectId));
+    auto readDto = as<FilesystemProjectDTO>(ds.read(projectId));
     assert(readDto != nullptr);
     assert(readDto->id == projectId);
     assert(readDto->name == "ReadTestProject");
     assert(readDto->description == "Test reading");
-    delete readDto;
 
     // List all projects
     auto projects = ds.list();
     assert(!projects.empty());
     bool found = false;
-    for (auto* proj : projects) {
-        auto* fsProj = dynamic_cast<FilesystemProjectDTO*>(proj);
+    for (auto& proj : projects) {
+        auto* fsProj = dynamic_cast<FilesystemProjectDTO*>(&proj);
         if (fsProj && fsProj->id == projectId) {
             found = true;
         }
-        delete proj;
     }
     assert(found);
 
@@ -122,18 +145,14 @@ void testFolderDataSource() {
     assert(!folderId.empty());
 
     // Read it back
-    auto* readFolder = dynamic_cast<FilesystemFolderDTO*>(folderDs.read(folderId));
+    auto readFolder = as<FilesystemFolderDTO>(folderDs.read(folderId));
     assert(readFolder != nullptr);
     assert(readFolder->id == folderId);
     assert(readFolder->name == "TestFolder");
-    delete readFolder;
 
     // List folders in project
     auto folders = folderDs.listByProject(projectId);
     assert(!folders.empty());
-    for (auto* folder : folders) {
-        delete folder;
-    }
 
     folderDs.disconnect();
     std::cout << "✓ Folder DataSource test passed\n";
@@ -179,12 +198,11 @@ void testNoteDataSource() {
     assert(!noteId.empty());
 
     // Read it back
-    auto* readNote = dynamic_cast<FilesystemNoteDTO*>(noteDs.read(noteId));
+    auto readNote = as<FilesystemNoteDTO>(noteDs.read(noteId));
     assert(readNote != nullptr);
     assert(readNote->id == noteId);
     assert(readNote->name == "TestNote");
     assert(readNote->content == "# Test Note\n\nThis is a test note.");
-    delete readNote;
 
     // Test content operations
     std::string content = noteDs.getContent(noteId);
@@ -199,9 +217,6 @@ void testNoteDataSource() {
     // List notes in folder
     auto notes = noteDs.listByFolder(folderId);
     assert(!notes.empty());
-    for (auto* note : notes) {
-        delete note;
-    }
 
     noteDs.disconnect();
     std::cout << "✓ Note DataSource test passed\n";
@@ -255,6 +270,741 @@ void testDataSourceIntegration() {
     std::cout << "✓ DataSource integration test passed\n";
 }
 
+// Creates a project with one folder under TEST_ROOT and returns the folder ID
+std::string createProjectWithFolder(const std::string& projectName, const std::string& folderName) {
+    FilesystemProjectDataSource projectDs("fixture-project", TEST_ROOT);
+    projectDs.connect();
+    FilesystemProjectDTO projectDto;
+    projectDto.name = projectName;
+    projectDto.createdAt = FilesystemDTOUtils::getCurrentTimestamp();
+    projectDto.updatedAt = projectDto.createdAt;
+    std::string projectId = projectDs.create(&projectDto);
+
+    FilesystemFolderDataSource folderDs("fixture-folder", TEST_ROOT);
+    folderDs.connect();
+    FilesystemFolderDTO folderDto;
+    folderDto.name = folderName;
+    folderDto.parentProjectId = projectId;
+    folderDto.createdAt = FilesystemDTOUtils::getCurrentTimestamp();
+    folderDto.updatedAt = folderDto.createdAt;
+    return folderDs.create(&folderDto);
+}
+
+std::string createNote(FilesystemNoteDataSource& noteDs, const std::string& folderId,
+                       const std::string& name, const std::string& content) {
+    FilesystemNoteDTO noteDto;
+    noteDto.name = name;
+    noteDto.content = content;
+    noteDto.parentFolderId = folderId;
+    noteDto.createdAt = FilesystemDTOUtils::getCurrentTimestamp();
+    noteDto.updatedAt = noteDto.createdAt;
+    return noteDs.create(&noteDto);
+}
+
+void testManifestLayout() {
+    std::string folderId = createProjectWithFolder("ManifestProject", "Inbox");
+    std::string folderPath = TEST_ROOT + "/ManifestProject/Inbox";
+
+    FilesystemNoteDataSource noteDs("manifest-note", TEST_ROOT, ".md", NoteMetadataLayout::Manifest);
+    noteDs.connect();
+
+    std::string keepId = createNote(noteDs, folderId, "Keep", "kept");
+    std::string dropId = createNote(noteDs, folderId, "Drop", "dropped");
+
+    // Metadata goes to the manifest, not to sidecars
+    assert(fs::exists(folderPath + "/.plotter_manifest"));
+    assert(!fs::exists(folderPath + "/Keep.md.plotter_meta"));
+
+    auto note = as<FilesystemNoteDTO>(noteDs.read(keepId));
+    assert(note != nullptr);
+    assert(note->name == "Keep");
+    assert(note->content == "kept");
+    note->name = "Kept";
+    assert(noteDs.update(keepId, note.get()));
+
+    assert(noteDs.updateContent(keepId, "kept, edited"));
+    assert(noteDs.remove(dropId));
+    assert(noteDs.read(dropId) == nullptr);
+
+    auto notes = noteDs.listByFolder(folderId);
+    assert(notes.size() == 1);
+    auto* listed = dynamic_cast<FilesystemNoteDTO*>(&notes[0]);
+    assert(listed->name == "Kept");
+    assert(!listed->contentLoaded && listed->content.empty());
+    assert(listed->contentLoader() == "kept, edited");
+
+    // The folder's note list is taken from the manifest
+    FilesystemFolderDataSource folderDs("manifest-folder", TEST_ROOT);
+    folderDs.connect();
+    auto folder = as<FilesystemFolderDTO>(folderDs.read(folderId));
+    assert(folder->noteIds.size() == 1 && folder->noteIds[0] == keepId);
+
+    // Repeated updates trigger compaction instead of growing without bound
+    for (int i = 0; i < 100; i++) {
+        assert(noteDs.updateContent(keepId, "revision " + std::to_string(i)));
+    }
+    size_t lines = 0;
+    std::ifstream manifest(folderPath + "/.plotter_manifest");
+    for (std::string line; std::getline(manifest, line);) {
+        lines++;
+    }
+    assert(lines < 40);
+
+    // A crash mid-append leaves half a record; the next put must not be glued onto it
+    std::string manifestPath = folderPath + "/.plotter_manifest";
+    FolderManifest tornManifest(folderPath);
+    ManifestEntry first;
+    first.id = "torn-first";
+    first.name = "First";
+    first.file = "First.md";
+    tornManifest.put(first);
+    fs::resize_file(manifestPath, fs::file_size(manifestPath) - 10);
+
+    ManifestEntry second = first;
+    second.id = "torn-second";
+    second.name = "Second";
+    tornManifest.put(second);
+
+    ManifestEntry found;
+    FolderManifest reloaded(folderPath);
+    assert(reloaded.find("torn-second", found) && found.name == "Second");
+    assert(!reloaded.find("torn-first", found));
+    assert(reloaded.find(keepId, found));
+
+    // Records appended by another writer are picked up from the file
+    std::ofstream(manifestPath, std::ios::app)
+        << "{\"op\":\"put\",\"id\":\"external\",\"name\":\"External\",\"file\":\"External.md\"}\n";
+    assert(reloaded.find("external", found) && found.name == "External");
+    assert(reloaded.remove("external"));
+    assert(!FolderManifest(folderPath).find("external", found));
+
+    std::cout << "✓ Manifest layout test passed\n";
+}
+
+void testManifestMigration() {
+    std::string folderId = createProjectWithFolder("LegacyProject", "Notes");
+    std::string folderPath = TEST_ROOT + "/LegacyProject/Notes";
+
+    FilesystemNoteDataSource sidecarDs("legacy-note", TEST_ROOT);
+    sidecarDs.connect();
+    std::string firstId = createNote(sidecarDs, folderId, "First", "one");
+    std::string secondId = createNote(sidecarDs, folderId, "Second", "two");
+    assert(fs::exists(folderPath + "/First.md.plotter_meta"));
+
+    assert(sidecarDs.migrateToManifestLayout() == 2);
+    assert(sidecarDs.getMetadataLayout() == NoteMetadataLayout::Manifest);
+    assert(!fs::exists(folderPath + "/First.md.plotter_meta"));
+    assert(fs::exists(folderPath + "/.plotter_manifest"));
+
+    // Re-running is a no-op
+    assert(sidecarDs.migrateToManifestLayout() == 0);
+
+    // A sidecar-configured data source still reads migrated folders
+    FilesystemNoteDataSource readerDs("reader-note", TEST_ROOT);
+    readerDs.connect();
+    assert(readerDs.getContent(firstId) == "one");
+    assert(readerDs.getContent(secondId) == "two");
+    auto notes = readerDs.listByFolder(folderId);
+    assert(notes.size() == 2);
+
+    std::cout << "✓ Manifest migration test passed\n";
+}
+
+void testMetadataCache() {
+    std::string folderId = createProjectWithFolder("CacheProject", "Cached");
+    FilesystemNoteDataSource noteDs("cache-note", TEST_ROOT);
+    noteDs.connect();
+    std::string noteId = createNote(noteDs, folderId, "CachedNote", "body");
+
+    MetadataCache& cache = MetadataCache::instance();
+    cache.clear();
+
+    auto first = noteDs.listByFolder(folderId);
+    auto afterFirst = cache.getStats();
+    auto second = noteDs.listByFolder(folderId);
+    auto afterSecond = cache.getStats();
+
+    // The second listing is served entirely from the cache
+    assert(afterFirst.misses > 0);
+    assert(afterSecond.misses == afterFirst.misses);
+    assert(afterSecond.hits > afterFirst.hits);
+
+    // A rewrite on disk invalidates the entry
+    auto note = as<FilesystemNoteDTO>(noteDs.read(noteId));
+    note->name = "Renamed";
+    assert(noteDs.update(noteId, note.get()));
+    auto beforeRead = cache.getStats();
+    auto reread = as<FilesystemNoteDTO>(noteDs.read(noteId));
+    assert(reread->name == "Renamed");
+    assert(cache.getStats().misses > beforeRead.misses);
+
+    // The budget bounds the cache
+    size_t budget = cache.getBudget();
+    cache.setBudget(1);
+    assert(cache.getStats().entries == 0);
+    assert(cache.getStats().evictions > 0);
+    cache.setBudget(budget);
+
+    std::cout << "✓ Metadata cache test passed\n";
+}
+
+void testBatchFileReader() {
+    std::vector<std::string> paths;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 150; i++) {
+        std::string path = TEST_ROOT + "/batch_" + std::to_string(i) + ".md";
+        std::string content(static_cast<size_t>(i * 97), static_cast<char>('a' + i % 26));
+        std::ofstream(path) << content;
+        paths.push_back(path);
+        expected.push_back(content);
+    }
+    paths.push_back(TEST_ROOT + "/missing.md");
+
+    for (bool useRing : {true, false}) {
+        BatchFileReader reader(16, 4);
+        if (!useRing) {
+            reader.disableIoUring();
+            assert(reader.getBackend() == BatchFileReader::Backend::ThreadPool);
+        }
+
+        auto results = reader.readAll(paths);
+        assert(results.size() == paths.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            assert(results[i].ok());
+            assert(results[i].content == expected[i]);
+        }
+        assert(!results.back().ok());
+        assert(reader.readAll({}).empty());
+    }
+
+    std::cout << "✓ Batch file reader test passed\n";
+}
+
+void testContentAddressedStorage() {
+    std::string objects = TEST_ROOT + "/.plotter_objects";
+    auto countBlobs = [&]() {
+        size_t blobs = 0;
+        for (const auto& entry : fs::recursive_directory_iterator(objects)) {
+            if (entry.is_regular_file() && entry.path().parent_path() != objects) {
+                blobs++;
+            }
+        }
+        return blobs;
+    };
+
+    {
+        ContentAddressedNoteStorage storage(TEST_ROOT);
+        const std::string body = "# Meeting template\n\n- Attendees\n- Agenda\n";
+
+        storage.saveNote("a/monday.md", body);
+        storage.saveNote("b/tuesday.md", body);
+        storage.saveNote("c/other.md", "something else");
+
+        // Identical bodies share one blob
+        assert(storage.blobKeyFor("a/monday.md") == storage.blobKeyFor("b/tuesday.md"));
+        assert(countBlobs() == 2);
+        assert(storage.getStats().notes == 3);
+        assert(storage.getStats().blobs == 2);
+        assert(storage.getStats().dedupHits == 1);
+        assert(storage.loadNote("b/tuesday.md") == body);
+
+        // Overwriting one copy keeps the shared blob alive for the other
+        storage.saveNote("a/monday.md", body + "edited");
+        assert(storage.collectGarbage() == 0);
+        assert(storage.loadNote("b/tuesday.md") == body);
+
+        assert(storage.removeNote("b/tuesday.md"));
+        assert(!storage.noteExists("b/tuesday.md"));
+        assert(!storage.removeNote("b/tuesday.md"));
+        assert(storage.collectGarbage() == 1);
+        assert(countBlobs() == 2);
+    }
+
+    // References survive a restart
+    ContentAddressedNoteStorage reopened(TEST_ROOT);
+    assert(reopened.noteExists("a/monday.md"));
+    assert(reopened.loadNote("c/other.md") == "something else");
+    assert(reopened.getStats().notes == 2);
+    assert(reopened.collectGarbage() == 0);
+
+    // A collector that loaded its refs earlier still sees notes saved since by someone else
+    ContentAddressedNoteStorage writer(TEST_ROOT);
+    writer.saveNote("d/new.md", "written by another process");
+    assert(reopened.collectGarbage() == 0);
+    assert(writer.loadNote("d/new.md") == "written by another process");
+    assert(reopened.noteExists("d/new.md"));
+    assert(writer.removeNote("d/new.md"));
+    assert(reopened.collectGarbage() == 1);
+
+    // Lookups see what other instances wrote since
+    writer.saveNote("e/later.md", "saved after the reader loaded its refs");
+    assert(reopened.loadNote("e/later.md") == "saved after the reader loaded its refs");
+    assert(writer.removeNote("e/later.md"));
+    assert(!reopened.noteExists("e/later.md"));
+    assert(reopened.collectGarbage() == 1);
+
+    // A record torn by a crash is cut off before the next append instead of swallowing it
+    {
+        std::ofstream refs(objects + "/refs", std::ios::app | std::ios::binary);
+        refs << "P\tb.t";
+    }
+    writer.saveNote("f/after-crash.md", "appended after a torn record");
+    assert(reopened.collectGarbage() == 0);
+    assert(reopened.loadNote("f/after-crash.md") == "appended after a torn record");
+    assert(ContentAddressedNoteStorage(TEST_ROOT).noteExists("f/after-crash.md"));
+
+    bool threw = false;
+    try {
+        reopened.loadNote("missing.md");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Content-addressed storage test passed\n";
+}
+
+void testMoves() {
+    std::string inboxId = createProjectWithFolder("MoveProject", "Inbox");
+    std::string projectPath = TEST_ROOT + "/MoveProject";
+
+    FilesystemFolderDataSource folderDs("move-folder", TEST_ROOT);
+    folderDs.connect();
+    auto inbox = as<FilesystemFolderDTO>(folderDs.read(inboxId));
+    std::string projectId = inbox->parentProjectId;
+
+    FilesystemFolderDTO subDto;
+    subDto.name = "Sub";
+    subDto.parentFolderId = inboxId;
+    std::string subId = folderDs.create(&subDto);
+
+    FilesystemFolderDTO archiveDto;
+    archiveDto.name = "Archive";
+    archiveDto.parentProjectId = projectId;
+    std::string archiveId = folderDs.create(&archiveDto);
+
+    FilesystemNoteDataSource noteDs("move-note", TEST_ROOT);
+    noteDs.connect();
+    std::string deepId = createNote(noteDs, subId, "Deep", "deep content");
+
+    // The subtree is renamed, not copied
+    struct stat before;
+    assert(stat((projectPath + "/Inbox/Sub").c_str(), &before) == 0);
+    assert(folderDs.move(subId, "", archiveId));
+    struct stat after;
+    assert(stat((projectPath + "/Archive/Sub").c_str(), &after) == 0);
+    assert(before.st_ino == after.st_ino);
+    assert(!fs::exists(projectPath + "/Inbox/Sub"));
+
+    auto moved = as<FilesystemFolderDTO>(folderDs.read(subId));
+    assert(moved->parentFolderId == archiveId);
+    auto archive = as<FilesystemFolderDTO>(folderDs.read(archiveId));
+    assert(archive->subfolderIds.size() == 1 && archive->subfolderIds[0] == subId);
+    auto children = folderDs.listByParentFolder(archiveId);
+    assert(children.size() == 1);
+    assert(noteDs.getContent(deepId) == "deep content");
+
+    // Cycles are rejected
+    bool threw = false;
+    try {
+        folderDs.move(archiveId, "", subId);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(!folderDs.move("missing", projectId, ""));
+
+    // Notes move between sidecar and manifest folders
+    assert(noteDs.move(deepId, inboxId));
+    assert(fs::exists(projectPath + "/Inbox/Deep.md.plotter_meta"));
+    assert(!fs::exists(projectPath + "/Archive/Sub/Deep.md"));
+    auto note = as<FilesystemNoteDTO>(noteDs.read(deepId));
+    assert(note->parentFolderId == inboxId);
+    assert(note->content == "deep content");
+
+    FolderManifest::migrateFromSidecars(projectPath + "/Archive/Sub");
+    assert(noteDs.move(deepId, subId));
+    assert(!fs::exists(projectPath + "/Inbox/Deep.md.plotter_meta"));
+    ManifestEntry entry;
+    assert(FolderManifest(projectPath + "/Archive/Sub").find(deepId, entry));
+    assert(entry.parentFolderId == subId);
+    assert(noteDs.getContent(deepId) == "deep content");
+
+    std::cout << "✓ Move test passed\n";
+}
+
+void testShardedNoteStorage() {
+    std::string base = TEST_ROOT + "/notes_store";
+    {
+        FilesystemNoteStorage flat(base);
+        flat.saveNote("notes/a_First.txt", "first");
+        flat.saveNote("notes/b_Second.txt", "second");
+    }
+
+    // Sharded storage still finds flat notes, and moves them on save
+    FilesystemNoteStorage storage(base, NoteStorageLayout::Sharded);
+    assert(storage.loadNote("notes/a_First.txt") == "first");
+    storage.saveNote("notes/a_First.txt", "first, edited");
+    assert(!fs::exists(base + "/notes/a_First.txt"));
+    assert(storage.loadNote("notes/a_First.txt") == "first, edited");
+
+    storage.saveNote("notes/c_Third.txt", "third");
+    assert(!fs::exists(base + "/notes/c_Third.txt"));
+    assert(storage.noteExists("notes/c_Third.txt"));
+    assert(!storage.noteExists("notes/missing.txt"));
+
+    // Notes land two levels below the shard root
+    size_t shardedFiles = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(base + "/" + FilesystemNoteStorage::SHARDS_DIRECTORY)) {
+        if (entry.is_regular_file()) {
+            assert(fs::relative(entry.path(), base + "/" + FilesystemNoteStorage::SHARDS_DIRECTORY).begin()->string().size() == 2);
+            shardedFiles++;
+        }
+    }
+    assert(shardedFiles == 2);
+
+    // Migration moves the rest and clears the flat directories, leaving dot directories alone
+    fs::create_directories(base + "/.internal");
+    std::ofstream(base + "/.internal/state.txt") << "not a note";
+    FilesystemNoteStorage legacy(base);
+    assert(legacy.loadNote("notes/c_Third.txt") == "third");
+    assert(legacy.migrateToShardedLayout() == 1);
+    assert(legacy.getLayout() == NoteStorageLayout::Sharded);
+    assert(!fs::exists(base + "/notes"));
+    assert(legacy.loadNote("notes/b_Second.txt") == "second");
+    assert(legacy.migrateToShardedLayout() == 0);
+    assert(fs::exists(base + "/.internal/state.txt"));
+
+    // The layout sticks for storages opened later, whatever they ask for
+    FilesystemNoteStorage reopened(base);
+    assert(reopened.getLayout() == NoteStorageLayout::Sharded);
+    reopened.saveNote("notes/d_Fourth.txt", "fourth");
+    assert(!fs::exists(base + "/notes"));
+    assert(reopened.loadNote("notes/d_Fourth.txt") == "fourth");
+
+    std::cout << "✓ Sharded note storage test passed\n";
+}
+
+void testPackfileStorage() {
+    std::string packs = TEST_ROOT + "/" + PackfileNoteStorage::PACKS_DIRECTORY;
+    {
+        // Tiny packs so that most records end up in sealed, mapped packs
+        PackfileNoteStorage storage(TEST_ROOT, 256);
+        for (int i = 0; i < 20; i++) {
+            storage.saveNote("notes/" + std::to_string(i) + ".txt", "body " + std::to_string(i));
+        }
+        storage.saveNote("notes/3.txt", "rewritten");
+        assert(storage.removeNote("notes/4.txt"));
+        assert(!storage.removeNote("notes/4.txt"));
+
+        assert(storage.getStats().packs > 2);
+        assert(storage.loadNote("notes/0.txt") == "body 0");
+        assert(storage.loadNote("notes/3.txt") == "rewritten");
+        assert(!storage.noteExists("notes/4.txt"));
+        assert(storage.getStats().deadBytes > 0);
+    }
+
+    // A torn append at the end of the active pack is dropped on open
+    std::string activePack;
+    std::ifstream list(packs + "/packs.list");
+    for (std::string kind, name; list >> kind >> name;) {
+        if (kind == "active") {
+            activePack = packs + "/" + name + ".pack";
+        }
+    }
+    std::ofstream(activePack, std::ios::app) << "PLTR torn";
+
+    PackfileNoteStorage storage(TEST_ROOT, 256);
+    assert(storage.loadNote("notes/19.txt") == "body 19");
+    assert(storage.loadNote("notes/3.txt") == "rewritten");
+    assert(!storage.noteExists("notes/4.txt"));
+    storage.saveNote("notes/20.txt", "after reopen");
+    bool threw = false;
+    try {
+        storage.loadNote("notes/4.txt");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Repacking drops dead records and keeps every live note
+    PackfileNoteStorage::Stats before = storage.getStats();
+    uint64_t reclaimed = storage.repack();
+    PackfileNoteStorage::Stats after = storage.getStats();
+    assert(reclaimed > 0);
+    assert(after.totalBytes == before.totalBytes - reclaimed);
+    assert(after.packs == 2);
+    assert(after.repacks == 1);
+    for (int i = 0; i < 21; i++) {
+        std::string path = "notes/" + std::to_string(i) + ".txt";
+        assert(storage.noteExists(path) == (i != 4));
+    }
+    assert(storage.loadNote("notes/3.txt") == "rewritten");
+    assert(storage.loadNote("notes/20.txt") == "after reopen");
+
+    size_t packFiles = 0;
+    for (const auto& entry : fs::directory_iterator(packs)) {
+        packFiles += entry.path().extension() == ".pack";
+    }
+    assert(packFiles == after.packs);
+
+    // The background repacker picks up new garbage on its own
+    for (int i = 0; i < 10; i++) {
+        storage.saveNote("notes/0.txt", "churn " + std::to_string(i));
+    }
+    storage.startBackgroundRepack(0.1, std::chrono::milliseconds(5));
+    for (int i = 0; i < 400 && storage.getStats().repacks < 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    storage.stopBackgroundRepack();
+    assert(storage.getStats().repacks >= 2);
+    assert(storage.loadNote("notes/0.txt") == "churn 9");
+
+    std::cout << "✓ Packfile storage test passed\n";
+}
+
+void testFolderLocking() {
+    std::string folderA = TEST_ROOT + "/A";
+    std::string folderB = TEST_ROOT + "/B";
+    fs::create_directories(folderA);
+    fs::create_directories(folderB);
+
+    // Exclusive locks exclude other threads on the same folder only
+    std::atomic<bool> acquiredA(false);
+    std::atomic<bool> acquiredB(false);
+    std::thread waiter;
+    std::thread other;
+    {
+        FolderLock lock(folderA);
+        {
+            FolderLock nested(folderA);   // Re-entrant on the owning thread
+            assert(FolderLock::isHeld(folderA));
+        }
+        assert(FolderLock::isHeld(folderA));
+
+        waiter = std::thread([&]() {
+            FolderLock contended(folderA);
+            acquiredA = true;
+        });
+        other = std::thread([&]() {
+            FolderLock independent(folderB);
+            acquiredB = true;
+        });
+        other.join();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(acquiredB);
+        assert(!acquiredA);
+    }
+    waiter.join();
+    assert(acquiredA);
+    assert(!FolderLock::isHeld(folderA));
+
+    // Two processes appending to one manifest, with compactions, lose nothing
+    std::string folderId = createProjectWithFolder("LockProject", "Shared");
+    std::cout.flush();
+    const int NOTES_PER_WRITER = 30;
+    std::vector<pid_t> writers;
+    for (int writer = 0; writer < 2; writer++) {
+        pid_t pid = fork();
+        assert(pid >= 0);
+        if (pid == 0) {
+            try {
+                FilesystemNoteDataSource noteDs("lock-writer", TEST_ROOT, ".md", NoteMetadataLayout::Manifest);
+                noteDs.connect();
+                for (int i = 0; i < NOTES_PER_WRITER; i++) {
+                    std::string name = "w" + std::to_string(writer) + "_" + std::to_string(i);
+                    std::string id = createNote(noteDs, folderId, name, name);
+                    if (!noteDs.updateContent(id, name + "!") || !noteDs.updateContent(id, name + "!!")) {
+                        _exit(1);
+                    }
+                }
+            } catch (const std::exception&) {
+                _exit(1);
+            }
+            _exit(0);
+        }
+        writers.push_back(pid);
+    }
+    for (pid_t pid : writers) {
+        int status = 0;
+        assert(waitpid(pid, &status, 0) == pid);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    FilesystemNoteDataSource noteDs("lock-reader", TEST_ROOT);
+    noteDs.connect();
+    auto notes = noteDs.listByFolder(folderId);
+    assert(notes.size() == 2 * NOTES_PER_WRITER);
+    noteDs.loadContents(notes);
+    for (auto& note : notes) {
+        auto* fsNote = dynamic_cast<FilesystemNoteDTO*>(&note);
+        assert(fsNote->contentLoaded);
+        assert(fsNote->content == fsNote->name + "!!");
+    }
+
+    std::cout << "✓ Folder locking test passed\n";
+}
+
+void testTrashBin() {
+    std::string folderId = createProjectWithFolder("TrashProject", "Doomed");
+    std::string folderPath = TEST_ROOT + "/TrashProject/Doomed";
+
+    FilesystemFolderDataSource folderDs("trash-folder", TEST_ROOT);
+    folderDs.connect();
+    FilesystemNoteDataSource sidecarDs("trash-note", TEST_ROOT);
+    sidecarDs.connect();
+    std::string sidecarId = createNote(sidecarDs, folderId, "Inside", "inside");
+
+    // Removing a folder moves it into the trash; restoring brings back its notes
+    assert(folderDs.remove(folderId));
+    assert(!fs::exists(folderPath));
+    assert(folderDs.read(folderId) == nullptr);
+    TrashBin trash(TEST_ROOT);
+    auto entries = trash.list();
+    assert(entries.size() == 1);
+    assert(entries[0].id == folderId);
+    assert(entries[0].kind == "folder");
+
+    // Trash is invisible to lookups that walk the root
+    assert(sidecarDs.read(sidecarId) == nullptr);
+
+    assert(folderDs.restore(folderId));
+    assert(!folderDs.restore(folderId));
+    auto note = as<FilesystemNoteDTO>(sidecarDs.read(sidecarId));
+    assert(note != nullptr && note->content == "inside");
+
+    // A sidecar note comes back with its sidecar
+    assert(sidecarDs.remove(sidecarId));
+    assert(!fs::exists(folderPath + "/Inside.md.plotter_meta"));
+    assert(sidecarDs.restore(sidecarId));
+    assert(fs::exists(folderPath + "/Inside.md.plotter_meta"));
+
+    // A manifest note comes back with its manifest entry
+    FilesystemNoteDataSource manifestDs("trash-manifest", TEST_ROOT, ".md", NoteMetadataLayout::Manifest);
+    manifestDs.connect();
+    std::string manifestId = createNote(manifestDs, folderId, "Listed", "listed");
+    assert(manifestDs.remove(manifestId));
+    auto listed = manifestDs.listByFolder(folderId);
+    assert(listed.size() == 1);
+    assert(manifestDs.restore(manifestId));
+    note = as<FilesystemNoteDTO>(manifestDs.read(manifestId));
+    assert(note != nullptr && note->name == "Listed" && note->content == "listed");
+
+    // Restoring over a recreated note fails and leaves the trash entry alone
+    assert(manifestDs.remove(manifestId));
+    createNote(manifestDs, folderId, "Listed", "replacement");
+    bool threw = false;
+    try {
+        manifestDs.restore(manifestId);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(trash.list().size() == 1);
+
+    // A restore that died after moving part of its entry back is finished by the next purge
+    assert(sidecarDs.remove(sidecarId));
+    entries = trash.list();
+    auto sidecarEntry = std::find_if(entries.begin(), entries.end(),
+                                     [&](const TrashBin::Entry& entry) { return entry.id == sidecarId; });
+    assert(sidecarEntry != entries.end());
+    std::string crashedPath = TEST_ROOT + "/" + TrashBin::DIRECTORY + "/.restoring-" +
+                              fs::path(sidecarEntry->path).filename().string();
+    fs::rename(sidecarEntry->path, crashedPath);
+    fs::rename(crashedPath + "/0", sidecarEntry->originalPaths[0]);
+    assert(trash.purgeExpired(std::chrono::hours(1)) == 0);
+    assert(!fs::exists(crashedPath));
+    note = as<FilesystemNoteDTO>(sidecarDs.read(sidecarId));
+    assert(note != nullptr && note->content == "inside");
+    assert(trash.list().size() == 1);
+
+    // Entries inside the retention window survive a purge; expired ones go
+    assert(trash.purgeExpired(std::chrono::hours(1)) == 0);
+    assert(trash.purgeExpired(std::chrono::milliseconds(0)) == 1);
+    assert(trash.list().empty());
+
+    // The background purger reclaims the whole subtree, a few files per tick
+    FilesystemProjectDataSource projectDs("trash-project", TEST_ROOT);
+    projectDs.connect();
+    auto folder = as<FilesystemFolderDTO>(folderDs.read(folderId));
+    std::string projectId = folder->parentProjectId;
+    assert(projectDs.remove(projectId));
+    assert(!fs::exists(TEST_ROOT + "/TrashProject"));
+    TrashBin::Throttle throttle;
+    throttle.filesPerTick = 2;
+    throttle.pause = std::chrono::milliseconds(1);
+    trash.startPurger(std::chrono::milliseconds(0), std::chrono::milliseconds(10), throttle);
+    for (int i = 0; i < 200 && !fs::is_empty(TEST_ROOT + "/" + TrashBin::DIRECTORY); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    trash.stopPurger();
+    assert(fs::is_empty(TEST_ROOT + "/" + TrashBin::DIRECTORY));
+    assert(!projectDs.restore(projectId));
+
+    std::cout << "✓ Trash bin test passed\n";
+}
+
+void testPartialUpdate() {
+    FilesystemProjectDataSource projectDs("test-project-ds", TEST_ROOT);
+    FilesystemFolderDataSource folderDs("test-folder-ds", TEST_ROOT);
+    projectDs.connect();
+    folderDs.connect();
+
+    FilesystemProjectDTO projectDto;
+    projectDto.name = "PartialProject";
+    projectDto.description = "Kept";
+    std::string projectId = projectDs.create(&projectDto);
+
+    FilesystemFolderDTO folderDto;
+    folderDto.name = "PartialFolder";
+    folderDto.description = "Kept too";
+    folderDto.parentProjectId = projectId;
+    folderDto.noteIds = {"note-a", "note-b"};
+    std::string folderId = folderDs.create(&folderDto);
+
+    // A stale DTO whose mask only flags the name must not touch anything else
+    FilesystemFolderDTO rename;
+    rename.id = folderId;
+    rename.name = "Renamed";
+    rename.changes = plotter::dto::ChangeMask(plotter::dto::ChangeMask::NAME);
+    assert(folderDs.update(folderId, &rename));
+
+    auto folder = as<FilesystemFolderDTO>(folderDs.read(folderId));
+    assert(folder != nullptr);
+    assert(folder->name == "Renamed");
+    assert(folder->description == "Kept too");
+    assert(folder->parentProjectId == projectId);
+    assert(folder->noteIds.size() == 2);
+    assert(folder->createdAt == folderDto.createdAt);
+
+    FilesystemProjectDTO describe;
+    describe.id = projectId;
+    describe.description = "Changed";
+    describe.changes = plotter::dto::ChangeMask(plotter::dto::ChangeMask::DESCRIPTION);
+    assert(projectDs.update(projectId, &describe));
+
+    auto project = as<FilesystemProjectDTO>(projectDs.read(projectId));
+    assert(project != nullptr);
+    assert(project->name == "PartialProject");
+    assert(project->description == "Changed");
+
+    // The default mask still rewrites the whole record
+    FilesystemFolderDTO full;
+    full.id = folderId;
+    full.name = "Renamed";
+    full.parentProjectId = projectId;
+    full.createdAt = folderDto.createdAt;
+    assert(folderDs.update(folderId, &full));
+
+    folder = as<FilesystemFolderDTO>(folderDs.read(folderId));
+    assert(folder->description.empty());
+    assert(folder->noteIds.empty());
+
+    folderDs.disconnect();
+    projectDs.disconnect();
+    std::cout << "✓ Partial update test passed\n";
+}
+
 int main() {
     std::cout << "Running PlotterFilesystemDataSource tests...\n\n";
 
@@ -277,6 +1027,39 @@ int main() {
         cleanup(); setup();
 
         testDataSourceIntegration();
+        cleanup(); setup();
+
+        testManifestLayout();
+        cleanup(); setup();
+
+        testManifestMigration();
+        cleanup(); setup();
+
+        testMetadataCache();
+        cleanup(); setup();
+
+        testBatchFileReader();
+        cleanup(); setup();
+
+        testContentAddressedStorage();
+        cleanup(); setup();
+
+        testMoves();
+        cleanup(); setup();
+
+        testShardedNoteStorage();
+        cleanup(); setup();
+
+        testPackfileStorage();
+        cleanup(); setup();
+
+        testFolderLocking();
+        cleanup(); setup();
+
+        testTrashBin();
+        cleanup(); setup();
+
+        testPartialUpdate();
         cleanup();
 
         std::cout << "\n✅ All tests passed!\n";
@@ -34,6 +34,9 @@ public:
      * @return Domain entity
      */
     Project toEntity(const dto::ProjectDTO& dto) override;
+    Project toEntity(dto::ProjectDTO&& dto) override;
+    std::vector<Project> toEntities(dto::DTOList<dto::ProjectDTO>&& dtos) override;
+    dto::DTOList<dto::ProjectDTO> toDTOs(const std::vector<Project>& entities) override;
 };
 
 /**
@@ -45,6 +48,9 @@ class FilesystemFolderMapper : public repositories::FolderDTOMapper {
 public:
     dto::FolderDTO* toDTO(const Folder& entity) override;
     Folder toEntity(const dto::FolderDTO& dto) override;
+    Folder toEntity(dto::FolderDTO&& dto) override;
+    std::vector<Folder> toEntities(dto::DTOList<dto::FolderDTO>&& dtos) override;
+    dto::DTOList<dto::FolderDTO> toDTOs(const std::vector<Folder>& entities) override;
 };
 
 /**
@@ -56,6 +62,9 @@ class FilesystemNoteMapper : public repositories::NoteDTOMapper {
 public:
     dto::NoteDTO* toDTO(const Note& entity) override;
     Note toEntity(const dto::NoteDTO& dto) override;
+    Note toEntity(dto::NoteDTO&& dto) override;
+    std::vector<Note> toEntities(dto::DTOList<dto::NoteDTO>&& dtos) override;
+    dto::DTOList<dto::NoteDTO> toDTOs(const std::vector<Note>& entities) override;
 };
 
 } // namespace filesystem_mappers
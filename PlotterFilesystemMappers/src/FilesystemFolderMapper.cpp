@@ -2,24 +2,55 @@
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
 // Use real entities instead of stubs
 #include "Folder.h"
+#include <utility>
 
 namespace plotter {
 namespace filesystem_mappers {
 
+namespace {
+
+// Called with a const DTO by the copying toEntity and with an rvalue by the
+// moving one; std::forward picks copy or move for each field
+template<typename Dto>
+Folder buildFolder(Dto&& dto) {
+    Folder folder(std::forward<Dto>(dto).id, std::forward<Dto>(dto).name, std::forward<Dto>(dto).description,
+                  dto.parentProjectId, dto.parentFolderId);
+
+    // Add note IDs from DTO
+    for (const auto& noteId : dto.noteIds) {
+        folder.addNoteId(noteId);
+    }
+
+    // Add subfolder IDs from DTO
+    for (const auto& subfolderId : dto.subfolderIds) {
+        folder.addSubfolderId(subfolderId);
+    }
+
+    folder.clearDirtyFields();  // Loaded state matches the store
+    return folder;
+}
+
+void fillFolder(const Folder& entity, filesystem_dtos::FilesystemFolderDTO& dto, long long now) {
+    dto.id = entity.getId();
+    dto.name = entity.getName();
+    dto.description = entity.getDescription();
+    dto.parentProjectId = entity.getParentProjectId();
+    dto.parentFolderId = entity.getParentFolderId();
+    dto.noteIds.assign(entity.getNoteIds().begin(), entity.getNoteIds().end());
+    dto.subfolderIds.assign(entity.getSubfolderIds().begin(), entity.getSubfolderIds().end());
+    dto.createdAt = now;
+    dto.updatedAt = now;
+    // path would be set by the data source layer
+    dto.changes = repositories::changeMaskOf(entity.getDirtyFields());
+}
+
+} // namespace
+
 // ================ FilesystemFolderMapper ================
 
 dto::FolderDTO* FilesystemFolderMapper::toDTO(const Folder& entity) {
     auto* dto = new filesystem_dtos::FilesystemFolderDTO();
-    dto->id = entity.getId();
-    dto->name = entity.getName();
-    dto->description = entity.getDescription();
-    dto->parentProjectId = entity.getParentProjectId();
-    dto->parentFolderId = entity.getParentFolderId();
-    dto->noteIds = entity.getNoteIds();
-    dto->subfolderIds = entity.getSubfolderIds();
-    dto->createdAt = filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp();
-    dto->updatedAt = filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp();
-    // path would be set by the data source layer
+    fillFolder(entity, *dto, filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp());
     return dto;
 }
 
@@ -29,26 +60,37 @@ Folder FilesystemFolderMapper::toEntity(const dto::FolderDTO& dto) {
     if (!fsDto) {
         throw std::runtime_error("FilesystemFolderMapper::toEntity - DTO is not a FilesystemFolderDTO");
     }
+    return buildFolder(*fsDto);
+}
 
-    Folder folder(
-        fsDto->id,
-        fsDto->name,
-        fsDto->description,
-        fsDto->parentProjectId,
-        fsDto->parentFolderId
-    );
-
-    // Add note IDs
-    for (const auto& noteId : fsDto->noteIds) {
-        folder.addNoteId(noteId);
+Folder FilesystemFolderMapper::toEntity(dto::FolderDTO&& dto) {
+    auto* fsDto = dynamic_cast<filesystem_dtos::FilesystemFolderDTO*>(&dto);
+    if (!fsDto) {
+        throw std::runtime_error("FilesystemFolderMapper::toEntity - DTO is not a FilesystemFolderDTO");
     }
+    return buildFolder(std::move(*fsDto));
+}
 
-    // Add subfolder IDs
-    for (const auto& subfolderId : fsDto->subfolderIds) {
-        folder.addSubfolderId(subfolderId);
+std::vector<Folder> FilesystemFolderMapper::toEntities(dto::DTOList<dto::FolderDTO>&& dtos) {
+    if (!dtos.holdsOnly<filesystem_dtos::FilesystemFolderDTO>()) {
+        return FolderDTOMapper::toEntities(std::move(dtos));  // Checks each DTO
+    }
+    std::vector<Folder> folders;
+    folders.reserve(dtos.size());
+    for (dto::FolderDTO& listed : dtos) {
+        folders.push_back(buildFolder(static_cast<filesystem_dtos::FilesystemFolderDTO&&>(listed)));
     }
+    return folders;
+}
 
-    return folder;
+dto::DTOList<dto::FolderDTO> FilesystemFolderMapper::toDTOs(const std::vector<Folder>& entities) {
+    dto::DTOList<dto::FolderDTO> dtos;
+    dtos.reserve(entities.size());
+    long long now = filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp();
+    for (const Folder& entity : entities) {
+        fillFolder(entity, dtos.emplace_back<filesystem_dtos::FilesystemFolderDTO>(), now);
+    }
+    return dtos;
 }
 
 } // namespace filesystem_mappers
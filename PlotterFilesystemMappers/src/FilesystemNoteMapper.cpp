@@ -2,21 +2,49 @@
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
 // Use real entities instead of stubs
 #include "Note.h"
+#include <utility>
 
 namespace plotter {
 namespace filesystem_mappers {
 
+namespace {
+
+// Called with a const DTO by the copying toEntity and with an rvalue by the
+// moving one; std::forward picks copy or move for each field
+template<typename Dto>
+Note buildNote(Dto&& dto) {
+    Note note(std::forward<Dto>(dto).id, std::forward<Dto>(dto).name, std::forward<Dto>(dto).path, dto.parentFolderId);
+    if (dto.contentLoaded) {
+        note.setContent(std::forward<Dto>(dto).content);
+    } else if (dto.contentLoader) {
+        note.setContentLoader(std::forward<Dto>(dto).contentLoader);
+    }
+    note.clearDirtyFields();  // Loaded state matches the store
+    return note;
+}
+
+void fillNote(const Note& entity, filesystem_dtos::FilesystemNoteDTO& dto, long long now) {
+    dto.id = entity.getId();
+    dto.name = entity.getName();
+    dto.path = entity.getPath();
+    dto.parentFolderId = entity.getParentFolderId();
+    dto.createdAt = now;
+    dto.updatedAt = now;
+    // Content that was never read stays out of the DTO, so the file is left alone
+    dto.contentLoaded = entity.isContentLoaded();
+    if (dto.contentLoaded) {
+        dto.content = entity.getContent();
+    }
+    dto.changes = repositories::changeMaskOf(entity.getDirtyFields());
+}
+
+} // namespace
+
 // ================ FilesystemNoteMapper ================
 
 dto::NoteDTO* FilesystemNoteMapper::toDTO(const Note& entity) {
     auto* dto = new filesystem_dtos::FilesystemNoteDTO();
-    dto->id = entity.getId();
-    dto->name = entity.getName();
-    dto->path = entity.getPath();
-    dto->parentFolderId = entity.getParentFolderId();
-    dto->createdAt = filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp();
-    dto->updatedAt = filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp();
-    // content would be read from file by the data source layer
+    fillNote(entity, *dto, filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp());
     return dto;
 }
 
@@ -26,15 +54,37 @@ Note FilesystemNoteMapper::toEntity(const dto::NoteDTO& dto) {
     if (!fsDto) {
         throw std::runtime_error("FilesystemNoteMapper::toEntity - DTO is not a FilesystemNoteDTO");
     }
+    return buildNote(*fsDto);
+}
+
+Note FilesystemNoteMapper::toEntity(dto::NoteDTO&& dto) {
+    auto* fsDto = dynamic_cast<filesystem_dtos::FilesystemNoteDTO*>(&dto);
+    if (!fsDto) {
+        throw std::runtime_error("FilesystemNoteMapper::toEntity - DTO is not a FilesystemNoteDTO");
+    }
+    return buildNote(std::move(*fsDto));
+}
 
-    Note note(
-        fsDto->id,
-        fsDto->name,
-        fsDto->path,
-        fsDto->parentFolderId
-    );
+std::vector<Note> FilesystemNoteMapper::toEntities(dto::DTOList<dto::NoteDTO>&& dtos) {
+    if (!dtos.holdsOnly<filesystem_dtos::FilesystemNoteDTO>()) {
+        return NoteDTOMapper::toEntities(std::move(dtos));  // Checks each DTO
+    }
+    std::vector<Note> notes;
+    notes.reserve(dtos.size());
+    for (dto::NoteDTO& listed : dtos) {
+        notes.push_back(buildNote(static_cast<filesystem_dtos::FilesystemNoteDTO&&>(listed)));
+    }
+    return notes;
+}
 
-    return note;
+dto::DTOList<dto::NoteDTO> FilesystemNoteMapper::toDTOs(const std::vector<Note>& entities) {
+    dto::DTOList<dto::NoteDTO> dtos;
+    dtos.reserve(entities.size());
+    long long now = filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp();
+    for (const Note& entity : entities) {
+        fillNote(entity, dtos.emplace_back<filesystem_dtos::FilesystemNoteDTO>(), now);
+    }
+    return dtos;
 }
 
 } // namespace filesystem_mappers
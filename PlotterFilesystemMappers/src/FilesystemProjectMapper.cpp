@@ -2,21 +2,46 @@
 #include "plotter_filesystem_dtos/FilesystemDTOs.h"
 // Use real entities instead of stubs
 #include "Project.h"
+#include <utility>
 
 namespace plotter {
 namespace filesystem_mappers {
 
+namespace {
+
+// Called with a const DTO by the copying toEntity and with an rvalue by the
+// moving one; std::forward picks copy or move for each field
+template<typename Dto>
+Project buildProject(Dto&& dto) {
+    Project project(std::forward<Dto>(dto).id, std::forward<Dto>(dto).name, std::forward<Dto>(dto).description);
+
+    // Add folder IDs from DTO
+    for (const auto& folderId : dto.folderIds) {
+        project.addFolderId(folderId);
+    }
+
+    project.clearDirtyFields();  // Loaded state matches the store
+    return project;
+}
+
+void fillProject(const Project& entity, filesystem_dtos::FilesystemProjectDTO& dto, long long now) {
+    dto.id = entity.getId();
+    dto.name = entity.getName();
+    dto.description = entity.getDescription();
+    dto.folderIds.assign(entity.getFolderIds().begin(), entity.getFolderIds().end());
+    dto.createdAt = now;
+    dto.updatedAt = now;
+    // rootPath would be set by the data source layer
+    dto.changes = repositories::changeMaskOf(entity.getDirtyFields());
+}
+
+} // namespace
+
 // ================ FilesystemProjectMapper ================
 
 dto::ProjectDTO* FilesystemProjectMapper::toDTO(const Project& entity) {
     auto* dto = new filesystem_dtos::FilesystemProjectDTO();
-    dto->id = entity.getId();
-    dto->name = entity.getName();
-    dto->description = entity.getDescription();
-    dto->folderIds = entity.getFolderIds();
-    dto->createdAt = filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp();
-    dto->updatedAt = filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp();
-    // rootPath would be set by the data source layer
+    fillProject(entity, *dto, filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp());
     return dto;
 }
 
@@ -26,15 +51,37 @@ Project FilesystemProjectMapper::toEntity(const dto::ProjectDTO& dto) {
     if (!fsDto) {
         throw std::runtime_error("FilesystemProjectMapper::toEntity - DTO is not a FilesystemProjectDTO");
     }
+    return buildProject(*fsDto);
+}
 
-    Project project(fsDto->id, fsDto->name, fsDto->description);
+Project FilesystemProjectMapper::toEntity(dto::ProjectDTO&& dto) {
+    auto* fsDto = dynamic_cast<filesystem_dtos::FilesystemProjectDTO*>(&dto);
+    if (!fsDto) {
+        throw std::runtime_error("FilesystemProjectMapper::toEntity - DTO is not a FilesystemProjectDTO");
+    }
+    return buildProject(std::move(*fsDto));
+}
 
-    // Add folder IDs from DTO
-    for (const auto& folderId : fsDto->folderIds) {
-        project.addFolderId(folderId);
+std::vector<Project> FilesystemProjectMapper::toEntities(dto::DTOList<dto::ProjectDTO>&& dtos) {
+    if (!dtos.holdsOnly<filesystem_dtos::FilesystemProjectDTO>()) {
+        return ProjectDTOMapper::toEntities(std::move(dtos));  // Checks each DTO
+    }
+    std::vector<Project> projects;
+    projects.reserve(dtos.size());
+    for (dto::ProjectDTO& listed : dtos) {
+        projects.push_back(buildProject(static_cast<filesystem_dtos::FilesystemProjectDTO&&>(listed)));
     }
+    return projects;
+}
 
-    return project;
+dto::DTOList<dto::ProjectDTO> FilesystemProjectMapper::toDTOs(const std::vector<Project>& entities) {
+    dto::DTOList<dto::ProjectDTO> dtos;
+    dtos.reserve(entities.size());
+    long long now = filesystem_dtos::FilesystemDTOUtils::getCurrentTimestamp();
+    for (const Project& entity : entities) {
+        fillProject(entity, dtos.emplace_back<filesystem_dtos::FilesystemProjectDTO>(), now);
+    }
+    return dtos;
 }
 
 } // namespace filesystem_mappers
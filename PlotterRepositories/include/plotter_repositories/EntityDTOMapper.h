@@ -2,15 +2,44 @@
 #define ENTITY_DTO_MAPPER_H
 
 #include "BaseDTOs.h"
+#include "ChangeMask.h"
+#include "DTOList.h"
 #include "Project.h"
 #include "Folder.h"
 #include "Note.h"
+#include <memory>
 #include <vector>
 #include <string>
 
 namespace plotter {
 namespace repositories {
 
+/**
+ * @brief Translate an entity's changed fields into a DTO change mask
+ * 
+ * Mappers use this in toDTO so data sources can limit updates to the
+ * changed fields. Attributes are not stored by any data source yet and
+ * have no DTO counterpart.
+ * 
+ * @param dirty The entity's changed fields
+ * @return The matching DTO change mask
+ */
+inline dto::ChangeMask changeMaskOf(const FieldMask& dirty) {
+    if (dirty == FieldMask::all()) {
+        return dto::ChangeMask();
+    }
+    uint32_t fields = dto::ChangeMask::NONE;
+    if (dirty.has(EntityField::Name)) fields |= dto::ChangeMask::NAME;
+    if (dirty.has(EntityField::Description)) fields |= dto::ChangeMask::DESCRIPTION;
+    if (dirty.has(EntityField::Path)) fields |= dto::ChangeMask::PATH;
+    if (dirty.has(EntityField::Content)) fields |= dto::ChangeMask::CONTENT;
+    if (dirty.has(EntityField::ParentFolder) || dirty.has(EntityField::ParentProject)) {
+        fields |= dto::ChangeMask::PARENT;
+    }
+    if (dirty.has(EntityField::Children)) fields |= dto::ChangeMask::CHILDREN;
+    return dto::ChangeMask(fields);
+}
+
 /**
  * @brief Abstract interface for mapping between entities and DTOs
  * 
@@ -48,6 +77,48 @@ public:
      * @return Domain entity
      */
     virtual Project toEntity(const dto::ProjectDTO& dto) = 0;
+    
+    /**
+     * @brief Convert a DTO the caller no longer needs to a Project entity
+     * 
+     * Mappers override this to move the DTO's strings into the entity
+     * instead of copying them; the default copies. The DTO is left in a
+     * valid but unspecified state and is still destroyed by its owner.
+     * 
+     * @param dto The DTO from datasource; its fields may be moved from
+     * @return Domain entity
+     */
+    virtual Project toEntity(dto::ProjectDTO&& dto) {
+        return toEntity(static_cast<const dto::ProjectDTO&>(dto));
+    }
+    
+    /**
+     * @brief Convert a list of DTOs to Project entities
+     * 
+     * The list is consumed, so fields are moved out as with the rvalue
+     * toEntity(). Mappers override this to check the concrete DTO type once
+     * for the whole list (dto::DTOList::holdsOnly) instead of per DTO; the
+     * default converts one DTO at a time.
+     * 
+     * @param dtos The DTOs from datasource
+     * @return Domain entities, in list order
+     */
+    virtual std::vector<Project> toEntities(dto::DTOList<dto::ProjectDTO>&& dtos) {
+        std::vector<Project> projects;
+        projects.reserve(dtos.size());
+        for (dto::ProjectDTO& listed : dtos) {
+            projects.push_back(toEntity(std::move(listed)));
+        }
+        return projects;
+    }
+    
+    /**
+     * @brief Convert a batch of Project entities to DTOs
+     * 
+     * @param entities The domain entities
+     * @return DTOs in entity order, all stamped with the same time
+     */
+    virtual dto::DTOList<dto::ProjectDTO> toDTOs(const std::vector<Project>& entities) = 0;
 };
 
 /**
@@ -68,6 +139,27 @@ public:
      * @return Domain entity
      */
     virtual Folder toEntity(const dto::FolderDTO& dto) = 0;
+    
+    /**
+     * @brief Convert a DTO the caller no longer needs, moving its strings
+     */
+    virtual Folder toEntity(dto::FolderDTO&& dto) {
+        return toEntity(static_cast<const dto::FolderDTO&>(dto));
+    }
+    
+    /**
+     * @brief Convert a list of DTOs, consuming it (see ProjectDTOMapper)
+     */
+    virtual std::vector<Folder> toEntities(dto::DTOList<dto::FolderDTO>&& dtos) {
+        std::vector<Folder> folders;
+        folders.reserve(dtos.size());
+        for (dto::FolderDTO& listed : dtos) {
+            folders.push_back(toEntity(std::move(listed)));
+        }
+        return folders;
+    }
+    
+    virtual dto::DTOList<dto::FolderDTO> toDTOs(const std::vector<Folder>& entities) = 0;
 };
 
 /**
@@ -80,6 +172,30 @@ public:
     virtual dto::NoteDTO* toDTO(const Note& entity) = 0;
     
     virtual Note toEntity(const dto::NoteDTO& dto) = 0;
+    
+    /**
+     * @brief Convert a DTO the caller no longer needs, moving its strings
+     * 
+     * Moving matters most here: the content of a loaded note is taken over
+     * rather than copied.
+     */
+    virtual Note toEntity(dto::NoteDTO&& dto) {
+        return toEntity(static_cast<const dto::NoteDTO&>(dto));
+    }
+    
+    /**
+     * @brief Convert a list of DTOs, consuming it (see ProjectDTOMapper)
+     */
+    virtual std::vector<Note> toEntities(dto::DTOList<dto::NoteDTO>&& dtos) {
+        std::vector<Note> notes;
+        notes.reserve(dtos.size());
+        for (dto::NoteDTO& listed : dtos) {
+            notes.push_back(toEntity(std::move(listed)));
+        }
+        return notes;
+    }
+    
+    virtual dto::DTOList<dto::NoteDTO> toDTOs(const std::vector<Note>& entities) = 0;
 };
 
 } // namespace repositories
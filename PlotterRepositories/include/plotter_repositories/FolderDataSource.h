@@ -3,7 +3,9 @@
 
 #include "DataSource.h"
 #include "BaseDTOs.h"
+#include "DTOList.h"
 #include <optional>
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -37,32 +39,47 @@ public:
      * @brief Find a folder by its ID
      * 
      * @param id The ID of the folder to find
-     * @return An optional containing the folder DTO if found, std::nullopt otherwise
+     * @return The folder DTO, or a null handle if not found
      */
-    virtual std::optional<dto::FolderDTO*> findById(const std::string& id) = 0;
+    virtual dto::DTOPtr<dto::FolderDTO> findById(const std::string& id) = 0;
     
     /**
      * @brief Get all folders from the datasource
      * 
-     * @return A vector containing all folder DTOs
+     * @return A list containing all folder DTOs
      */
-    virtual std::vector<dto::FolderDTO*> findAll() = 0;
+    virtual dto::DTOList<dto::FolderDTO> findAll() = 0;
     
     /**
      * @brief Find folders by parent project ID
      * 
      * @param projectId The ID of the parent project
-     * @return A vector of folder DTOs belonging to the project
+     * @return A list of folder DTOs belonging to the project
      */
-    virtual std::vector<dto::FolderDTO*> findByProjectId(const std::string& projectId) = 0;
+    virtual dto::DTOList<dto::FolderDTO> findByProjectId(const std::string& projectId) = 0;
     
     /**
      * @brief Find folders by parent folder ID
      * 
      * @param parentFolderId The ID of the parent folder
-     * @return A vector of child folder DTOs
+     * @return A list of child folder DTOs
      */
-    virtual std::vector<dto::FolderDTO*> findByParentFolderId(const std::string& parentFolderId) = 0;
+    virtual dto::DTOList<dto::FolderDTO> findByParentFolderId(const std::string& parentFolderId) = 0;
+    
+    /**
+     * @brief Find every folder of a project, at any depth, in one query
+     * 
+     * Data sources that can query the whole tree at once override this.
+     * The default returns nullopt, which tells the repository to walk the
+     * tree with findByProjectId() and findByParentFolderId() instead.
+     * 
+     * @param projectId The ID of the project
+     * @return A list of the project's folder DTOs in any order, or nullopt if unsupported
+     */
+    virtual std::optional<dto::DTOList<dto::FolderDTO>> findAllInProject(const std::string& projectId) {
+        (void)projectId;
+        return std::nullopt;
+    }
     
     /**
      * @brief Delete a folder by its ID
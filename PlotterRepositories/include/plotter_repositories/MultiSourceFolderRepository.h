@@ -6,6 +6,7 @@
 #include "plotter_repositories/DataSourceRouter.h"
 #include "plotter_repositories/EntityDTOMapper.h"
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <sstream>
 
@@ -44,6 +45,7 @@ public:
     std::vector<Folder> findAll() override;
     std::vector<Folder> findByParentProjectId(const std::string& parentProjectId) override;
     std::vector<Folder> findByParentFolderId(const std::string& parentFolderId) override;
+    std::vector<Folder> findAllInProject(const std::string& projectId) override;
     bool deleteById(const std::string& id) override;
     void update(const Folder& folder) override;
     bool exists(const std::string& id) override;
@@ -88,7 +90,7 @@ std::string MultiSourceFolderRepository<RouterType>::save(const Folder& folder)
 template<typename RouterType>
 std::optional<Folder> MultiSourceFolderRepository<RouterType>::findById(const std::string& id) {
     try {
-        auto dtoPtr = router->template executeRead<std::optional<dto::FolderDTO*>>(
+        auto found = router->template executeRead<dto::DTOPtr<dto::FolderDTO>>(
             [&id](FolderDataSource* ds) {
                 try {
                     return ds->findById(id);
@@ -100,15 +102,13 @@ std::optional<Folder> MultiSourceFolderRepository<RouterType>::findById(const st
             }
         );
         
-        if (!dtoPtr || !*dtoPtr) {
+        if (!found) {
             return std::nullopt;
         }
         
-        // Convert DTO to entity using the provided mapper
-        Folder entity = mapper->toEntity(**dtoPtr);
-        delete *dtoPtr; // Clean up DTO allocated by data source
-        
-        return entity;
+        // Convert DTO to entity using the provided mapper; the DTO is
+        // discarded afterwards, so its fields can be moved out
+        return mapper->toEntity(std::move(*found));
     } catch (const std::exception& e) {
         std::ostringstream oss;
         oss << "MultiSourceFolderRepository::findById failed for id '" << id << "': " << e.what();
@@ -119,7 +119,7 @@ std::optional<Folder> MultiSourceFolderRepository<RouterType>::findById(const st
 template<typename RouterType>
 std::vector<Folder> MultiSourceFolderRepository<RouterType>::findAll() {
     try {
-        auto dtoPtrs = router->template executeRead<std::vector<dto::FolderDTO*>>(
+        auto dtos = router->template executeRead<dto::DTOList<dto::FolderDTO>>(
             [](FolderDataSource* ds) {
                 try {
                     return ds->findAll();
@@ -132,13 +132,7 @@ std::vector<Folder> MultiSourceFolderRepository<RouterType>::findAll() {
         );
         
         // Convert DTOs to entities using the provided mapper
-        std::vector<Folder> folders;
-        for (auto* dtoPtr : dtoPtrs) {
-            folders.push_back(mapper->toEntity(*dtoPtr));
-            delete dtoPtr; // Clean up DTO allocated by data source
-        }
-        
-        return folders;
+        return mapper->toEntities(std::move(dtos));
     } catch (const std::exception& e) {
         std::ostringstream oss;
         oss << "MultiSourceFolderRepository::findAll failed: " << e.what();
@@ -149,7 +143,7 @@ std::vector<Folder> MultiSourceFolderRepository<RouterType>::findAll() {
 template<typename RouterType>
 std::vector<Folder> MultiSourceFolderRepository<RouterType>::findByParentProjectId(const std::string& parentProjectId) {
     try {
-        auto dtoPtrs = router->template executeRead<std::vector<dto::FolderDTO*>>(
+        auto dtos = router->template executeRead<dto::DTOList<dto::FolderDTO>>(
             [&parentProjectId](FolderDataSource* ds) {
                 try {
                     return ds->findByProjectId(parentProjectId);
@@ -162,13 +156,7 @@ std::vector<Folder> MultiSourceFolderRepository<RouterType>::findByParentProject
         );
         
         // Convert DTOs to entities using the provided mapper
-        std::vector<Folder> folders;
-        for (auto* dtoPtr : dtoPtrs) {
-            folders.push_back(mapper->toEntity(*dtoPtr));
-            delete dtoPtr; // Clean up DTO allocated by data source
-        }
-        
-        return folders;
+        return mapper->toEntities(std::move(dtos));
     } catch (const std::exception& e) {
         std::ostringstream oss;
         oss << "MultiSourceFolderRepository::findByParentProjectId failed for projectId '" << parentProjectId << "': " << e.what();
@@ -179,7 +167,7 @@ std::vector<Folder> MultiSourceFolderRepository<RouterType>::findByParentProject
 template<typename RouterType>
 std::vector<Folder> MultiSourceFolderRepository<RouterType>::findByParentFolderId(const std::string& parentFolderId) {
     try {
-        auto dtoPtrs = router->template executeRead<std::vector<dto::FolderDTO*>>(
+        auto dtos = router->template executeRead<dto::DTOList<dto::FolderDTO>>(
             [&parentFolderId](FolderDataSource* ds) {
                 try {
                     return ds->findByParentFolderId(parentFolderId);
@@ -192,13 +180,7 @@ std::vector<Folder> MultiSourceFolderRepository<RouterType>::findByParentFolderI
         );
         
         // Convert DTOs to entities using the provided mapper
-        std::vector<Folder> folders;
-        for (auto* dtoPtr : dtoPtrs) {
-            folders.push_back(mapper->toEntity(*dtoPtr));
-            delete dtoPtr; // Clean up DTO allocated by data source
-        }
-        
-        return folders;
+        return mapper->toEntities(std::move(dtos));
     } catch (const std::exception& e) {
         std::ostringstream oss;
         oss << "MultiSourceFolderRepository::findByParentFolderId failed for folderId '" << parentFolderId << "': " << e.what();
@@ -206,6 +188,35 @@ std::vector<Folder> MultiSourceFolderRepository<RouterType>::findByParentFolderI
     }
 }
 
+template<typename RouterType>
+std::vector<Folder> MultiSourceFolderRepository<RouterType>::findAllInProject(const std::string& projectId) {
+    std::optional<dto::DTOList<dto::FolderDTO>> dtos;
+    try {
+        dtos = router->template executeRead<std::optional<dto::DTOList<dto::FolderDTO>>>(
+            [&projectId](FolderDataSource* ds) {
+                try {
+                    return ds->findAllInProject(projectId);
+                } catch (const std::exception& e) {
+                    std::ostringstream oss;
+                    oss << "DataSource '" << ds->getName() << "' failed to find folders in project: " << e.what();
+                    throw std::runtime_error(oss.str());
+                }
+            }
+        );
+        
+        if (dtos) {
+            return mapper->toEntities(std::move(*dtos));
+        }
+    } catch (const std::exception& e) {
+        std::ostringstream oss;
+        oss << "MultiSourceFolderRepository::findAllInProject failed for projectId '" << projectId << "': " << e.what();
+        throw std::runtime_error(oss.str());
+    }
+    
+    // The data source cannot list the tree in one go; walk it level by level
+    return FolderRepository::findAllInProject(projectId);
+}
+
 template<typename RouterType>
 bool MultiSourceFolderRepository<RouterType>::deleteById(const std::string& id) {
     try {
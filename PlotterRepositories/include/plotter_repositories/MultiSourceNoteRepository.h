@@ -12,6 +12,37 @@
 namespace plotter {
 namespace repositories {
 
+/**
+ * @brief NoteCursor that maps a data source's DTO cursor one note at a time
+ * 
+ * Each DTO is moved into its note as soon as it is read, so the cursor
+ * holds one row rather than the whole result.
+ */
+class MappedNoteCursor : public NoteCursor {
+private:
+    std::unique_ptr<dto::DTOCursor<dto::NoteDTO>> dtos;
+    NoteDTOMapper* mapper;
+    std::string operation;  // Repository method that opened the cursor, for errors
+    
+public:
+    MappedNoteCursor(std::unique_ptr<dto::DTOCursor<dto::NoteDTO>> dtos, NoteDTOMapper* mapper, std::string operation)
+        : dtos(std::move(dtos)), mapper(mapper), operation(std::move(operation)) {}
+    
+    std::optional<Note> next() override {
+        try {
+            dto::NoteDTO* row = dtos->next();
+            if (!row) {
+                return std::nullopt;
+            }
+            return mapper->toEntity(std::move(*row));
+        } catch (const std::exception& e) {
+            std::ostringstream oss;
+            oss << "MultiSourceNoteRepository::" << operation << " failed: " << e.what();
+            throw std::runtime_error(oss.str());
+        }
+    }
+};
+
 /**
  * @brief Multi-source implementation of NoteRepository
  * 
@@ -43,7 +74,11 @@ public:
     std::optional<Note> findById(const std::string& id) override;
     std::vector<Note> findAll() override;
     std::vector<Note> findByParentFolderId(const std::string& parentFolderId) override;
+    std::vector<Note> findByParentFolderIds(const std::vector<std::string>& parentFolderIds) override;
     std::vector<Note> search(const std::string& searchTerm) override;
+    std::unique_ptr<NoteCursor> streamAll() override;
+    std::unique_ptr<NoteCursor> streamByParentFolderId(const std::string& parentFolderId) override;
+    std::unique_ptr<NoteCursor> streamSearch(const std::string& searchTerm) override;
     bool deleteById(const std::string& id) override;
     void update(const Note& note) override;
     bool exists(const std::string& id) override;
@@ -94,7 +129,7 @@ std::string MultiSourceNoteRepository<RouterType>::save(const Note& note) {
 template<typename RouterType>
 std::optional<Note> MultiSourceNoteRepository<RouterType>::findById(const std::string& id) {
     try {
-        auto dtoPtr = router->template executeRead<std::optional<dto::NoteDTO*>>(
+        auto found = router->template executeRead<dto::DTOPtr<dto::NoteDTO>>(
             [&id](NoteDataSource* ds) {
                 try {
                     return ds->findById(id);
@@ -107,10 +142,8 @@ std::optional<Note> MultiSourceNoteRepository<RouterType>::findById(const std::s
         );
         
         // Convert DTO to entity if found using the provided mapper
-        if (dtoPtr && *dtoPtr) {
-            Note entity = mapper->toEntity(**dtoPtr);
-            delete *dtoPtr; // Clean up DTO allocated by data source
-            return entity;
+        if (found) {
+            return mapper->toEntity(std::move(*found));
         }
         
         return std::nullopt;
@@ -124,7 +157,7 @@ std::optional<Note> MultiSourceNoteRepository<RouterType>::findById(const std::s
 template<typename RouterType>
 std::vector<Note> MultiSourceNoteRepository<RouterType>::findAll() {
     try {
-        auto dtoPtrs = router->template executeRead<std::vector<dto::NoteDTO*>>(
+        auto dtos = router->template executeRead<dto::DTOList<dto::NoteDTO>>(
             [](NoteDataSource* ds) {
                 try {
                     return ds->findAll();
@@ -137,13 +170,7 @@ std::vector<Note> MultiSourceNoteRepository<RouterType>::findAll() {
         );
         
         // Convert DTOs to entities using the provided mapper
-        std::vector<Note> notes;
-        for (auto* dtoPtr : dtoPtrs) {
-            notes.push_back(mapper->toEntity(*dtoPtr));
-            delete dtoPtr; // Clean up DTO allocated by data source
-        }
-        
-        return notes;
+        return mapper->toEntities(std::move(dtos));
     } catch (const std::exception& e) {
         std::ostringstream oss;
         oss << "MultiSourceNoteRepository::findAll failed: " << e.what();
@@ -154,7 +181,7 @@ std::vector<Note> MultiSourceNoteRepository<RouterType>::findAll() {
 template<typename RouterType>
 std::vector<Note> MultiSourceNoteRepository<RouterType>::findByParentFolderId(const std::string& parentFolderId) {
     try {
-        auto dtoPtrs = router->template executeRead<std::vector<dto::NoteDTO*>>(
+        auto dtos = router->template executeRead<dto::DTOList<dto::NoteDTO>>(
             [&parentFolderId](NoteDataSource* ds) {
                 try {
                     return ds->findByParentFolderId(parentFolderId);
@@ -167,13 +194,7 @@ std::vector<Note> MultiSourceNoteRepository<RouterType>::findByParentFolderId(co
         );
         
         // Convert DTOs to entities using the provided mapper
-        std::vector<Note> notes;
-        for (auto* dtoPtr : dtoPtrs) {
-            notes.push_back(mapper->toEntity(*dtoPtr));
-            delete dtoPtr; // Clean up DTO allocated by data source
-        }
-        
-        return notes;
+        return mapper->toEntities(std::move(dtos));
     } catch (const std::exception& e) {
         std::ostringstream oss;
         oss << "MultiSourceNoteRepository::findByParentFolderId failed for folderId '" << parentFolderId << "': " << e.what();
@@ -181,10 +202,34 @@ std::vector<Note> MultiSourceNoteRepository<RouterType>::findByParentFolderId(co
     }
 }
 
+template<typename RouterType>
+std::vector<Note> MultiSourceNoteRepository<RouterType>::findByParentFolderIds(const std::vector<std::string>& parentFolderIds) {
+    try {
+        auto dtos = router->template executeRead<dto::DTOList<dto::NoteDTO>>(
+            [&parentFolderIds](NoteDataSource* ds) {
+                try {
+                    return ds->findByParentFolderIds(parentFolderIds);
+                } catch (const std::exception& e) {
+                    std::ostringstream oss;
+                    oss << "DataSource '" << ds->getName() << "' failed to find notes by folders: " << e.what();
+                    throw std::runtime_error(oss.str());
+                }
+            }
+        );
+        
+        // Convert DTOs to entities using the provided mapper
+        return mapper->toEntities(std::move(dtos));
+    } catch (const std::exception& e) {
+        std::ostringstream oss;
+        oss << "MultiSourceNoteRepository::findByParentFolderIds failed for " << parentFolderIds.size() << " folders: " << e.what();
+        throw std::runtime_error(oss.str());
+    }
+}
+
 template<typename RouterType>
 std::vector<Note> MultiSourceNoteRepository<RouterType>::search(const std::string& searchTerm) {
     try {
-        auto dtoPtrs = router->template executeRead<std::vector<dto::NoteDTO*>>(
+        auto dtos = router->template executeRead<dto::DTOList<dto::NoteDTO>>(
             [&searchTerm](NoteDataSource* ds) {
                 try {
                     return ds->search(searchTerm);
@@ -197,13 +242,7 @@ std::vector<Note> MultiSourceNoteRepository<RouterType>::search(const std::strin
         );
         
         // Convert DTOs to entities using the provided mapper
-        std::vector<Note> notes;
-        for (auto* dtoPtr : dtoPtrs) {
-            notes.push_back(mapper->toEntity(*dtoPtr));
-            delete dtoPtr; // Clean up DTO allocated by data source
-        }
-        
-        return notes;
+        return mapper->toEntities(std::move(dtos));
     } catch (const std::exception& e) {
         std::ostringstream oss;
         oss << "MultiSourceNoteRepository::search failed for term '" << searchTerm << "': " << e.what();
@@ -211,6 +250,78 @@ std::vector<Note> MultiSourceNoteRepository<RouterType>::search(const std::strin
     }
 }
 
+template<typename RouterType>
+std::unique_ptr<NoteCursor> MultiSourceNoteRepository<RouterType>::streamAll() {
+    try {
+        auto dtos = router->template executeRead<std::unique_ptr<dto::DTOCursor<dto::NoteDTO>>>(
+            [](NoteDataSource* ds) {
+                try {
+                    return ds->streamAll();
+                } catch (const std::exception& e) {
+                    std::ostringstream oss;
+                    oss << "DataSource '" << ds->getName() << "' failed to stream all notes: " << e.what();
+                    throw std::runtime_error(oss.str());
+                }
+            }
+        );
+        
+        // Notes are mapped as the caller pulls them
+        return std::make_unique<MappedNoteCursor>(std::move(dtos), mapper, "streamAll");
+    } catch (const std::exception& e) {
+        std::ostringstream oss;
+        oss << "MultiSourceNoteRepository::streamAll failed: " << e.what();
+        throw std::runtime_error(oss.str());
+    }
+}
+
+template<typename RouterType>
+std::unique_ptr<NoteCursor> MultiSourceNoteRepository<RouterType>::streamByParentFolderId(const std::string& parentFolderId) {
+    try {
+        auto dtos = router->template executeRead<std::unique_ptr<dto::DTOCursor<dto::NoteDTO>>>(
+            [&parentFolderId](NoteDataSource* ds) {
+                try {
+                    return ds->streamByParentFolderId(parentFolderId);
+                } catch (const std::exception& e) {
+                    std::ostringstream oss;
+                    oss << "DataSource '" << ds->getName() << "' failed to stream notes by folder: " << e.what();
+                    throw std::runtime_error(oss.str());
+                }
+            }
+        );
+        
+        // Notes are mapped as the caller pulls them
+        return std::make_unique<MappedNoteCursor>(std::move(dtos), mapper, "streamByParentFolderId");
+    } catch (const std::exception& e) {
+        std::ostringstream oss;
+        oss << "MultiSourceNoteRepository::streamByParentFolderId failed for folderId '" << parentFolderId << "': " << e.what();
+        throw std::runtime_error(oss.str());
+    }
+}
+
+template<typename RouterType>
+std::unique_ptr<NoteCursor> MultiSourceNoteRepository<RouterType>::streamSearch(const std::string& searchTerm) {
+    try {
+        auto dtos = router->template executeRead<std::unique_ptr<dto::DTOCursor<dto::NoteDTO>>>(
+            [&searchTerm](NoteDataSource* ds) {
+                try {
+                    return ds->streamSearch(searchTerm);
+                } catch (const std::exception& e) {
+                    std::ostringstream oss;
+                    oss << "DataSource '" << ds->getName() << "' failed to stream search results: " << e.what();
+                    throw std::runtime_error(oss.str());
+                }
+            }
+        );
+        
+        // Notes are mapped as the caller pulls them
+        return std::make_unique<MappedNoteCursor>(std::move(dtos), mapper, "streamSearch");
+    } catch (const std::exception& e) {
+        std::ostringstream oss;
+        oss << "MultiSourceNoteRepository::streamSearch failed for term '" << searchTerm << "': " << e.what();
+        throw std::runtime_error(oss.str());
+    }
+}
+
 template<typename RouterType>
 bool MultiSourceNoteRepository<RouterType>::deleteById(const std::string& id) {
     try {
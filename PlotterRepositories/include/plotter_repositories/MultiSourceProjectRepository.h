@@ -64,7 +64,7 @@ public:
     
     std::optional<Project> findById(const std::string& id) override {
         try {
-            auto dtoPtr = router->template executeRead<std::optional<dto::ProjectDTO*>>(
+            auto found = router->template executeRead<dto::DTOPtr<dto::ProjectDTO>>(
                 [&id](ProjectDataSource* ds) {
                     try {
                         return ds->findById(id);
@@ -76,15 +76,13 @@ public:
                 }
             );
             
-            if (!dtoPtr || !*dtoPtr) {
+            if (!found) {
                 return std::nullopt;
             }
             
-            // Convert DTO to entity using the provided mapper
-            Project entity = mapper->toEntity(**dtoPtr);
-            delete *dtoPtr; // Clean up DTO allocated by data source
-            
-            return entity;
+            // Convert DTO to entity using the provided mapper; the DTO is
+            // discarded afterwards, so its fields can be moved out
+            return mapper->toEntity(std::move(*found));
         } catch (const std::exception& e) {
             std::ostringstream oss;
             oss << "MultiSourceProjectRepository::findById failed for id '" << id << "': " << e.what();
@@ -94,7 +92,7 @@ public:
     
     std::vector<Project> findAll() override {
         try {
-            auto dtoPtrs = router->template executeRead<std::vector<dto::ProjectDTO*>>(
+            auto dtos = router->template executeRead<dto::DTOList<dto::ProjectDTO>>(
                 [](ProjectDataSource* ds) {
                     try {
                         return ds->findAll();
@@ -107,13 +105,7 @@ public:
             );
             
             // Convert DTOs to entities using the provided mapper
-            std::vector<Project> projects;
-            for (auto* dtoPtr : dtoPtrs) {
-                projects.push_back(mapper->toEntity(*dtoPtr));
-                delete dtoPtr; // Clean up DTO allocated by data source
-            }
-            
-            return projects;
+            return mapper->toEntities(std::move(dtos));
         } catch (const std::exception& e) {
             std::ostringstream oss;
             oss << "MultiSourceProjectRepository::findAll failed: " << e.what();
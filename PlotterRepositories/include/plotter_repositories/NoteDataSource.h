@@ -3,7 +3,9 @@
 
 #include "DataSource.h"
 #include "BaseDTOs.h"
-#include <optional>
+#include "DTOCursor.h"
+#include "DTOList.h"
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -19,7 +21,9 @@ namespace repositories {
  * 
  * Data sources work with DTOs (inheriting from plotter::dto::NoteDTO).
  * The repository layer is responsible for converting between entities and DTOs.
- * 
+ * Lookups hand back owning handles (dto::DTOPtr, dto::DTOList), so callers
+ * never delete DTOs themselves.
+ *
  * Note: This interface handles Note metadata only. Actual note content
  * storage may be delegated to a separate content storage mechanism.
  */
@@ -40,32 +44,81 @@ public:
      * @brief Find a note by its ID
      * 
      * @param id The ID of the note to find
-     * @return An optional containing the note DTO if found, std::nullopt otherwise
+     * @return The note DTO, or a null handle if not found
      */
-    virtual std::optional<dto::NoteDTO*> findById(const std::string& id) = 0;
+    virtual dto::DTOPtr<dto::NoteDTO> findById(const std::string& id) = 0;
     
     /**
      * @brief Get all notes from the datasource
      * 
-     * @return A vector containing all note DTOs
+     * @return A list containing all note DTOs
      */
-    virtual std::vector<dto::NoteDTO*> findAll() = 0;
+    virtual dto::DTOList<dto::NoteDTO> findAll() = 0;
     
     /**
      * @brief Find notes by parent folder ID
      * 
      * @param parentFolderId The ID of the parent folder
-     * @return A vector of note DTOs belonging to the folder
+     * @return A list of note DTOs belonging to the folder
+     */
+    virtual dto::DTOList<dto::NoteDTO> findByParentFolderId(const std::string& parentFolderId) = 0;
+    
+    /**
+     * @brief Find the notes of several folders at once
+     * 
+     * The default issues one findByParentFolderId() per folder.
+     * 
+     * @param parentFolderIds The IDs of the parent folders
+     * @return A list of note DTOs belonging to any of the folders
      */
-    virtual std::vector<dto::NoteDTO*> findByParentFolderId(const std::string& parentFolderId) = 0;
+    virtual dto::DTOList<dto::NoteDTO> findByParentFolderIds(const std::vector<std::string>& parentFolderIds) {
+        dto::DTOList<dto::NoteDTO> notes;
+        for (const auto& parentFolderId : parentFolderIds) {
+            notes.append(findByParentFolderId(parentFolderId));
+        }
+        return notes;
+    }
     
     /**
      * @brief Search notes by name or content
      * 
      * @param searchTerm The term to search for
-     * @return A vector of note DTOs matching the search
+     * @return A list of note DTOs matching the search
+     */
+    virtual dto::DTOList<dto::NoteDTO> search(const std::string& searchTerm) = 0;
+    
+    /**
+     * @brief Read all notes one at a time
+     * 
+     * Same notes as findAll(), without holding them all in memory. The
+     * default wraps findAll(); data sources that can read row by row
+     * override it.
+     * 
+     * @return A cursor over all note DTOs
+     */
+    virtual std::unique_ptr<dto::DTOCursor<dto::NoteDTO>> streamAll() {
+        return std::make_unique<dto::DTOListCursor<dto::NoteDTO>>(findAll());
+    }
+    
+    /**
+     * @brief Read the notes of a folder one at a time
+     * 
+     * @param parentFolderId The ID of the parent folder
+     * @return A cursor over the same note DTOs as findByParentFolderId()
+     */
+    virtual std::unique_ptr<dto::DTOCursor<dto::NoteDTO>> streamByParentFolderId(const std::string& parentFolderId) {
+        return std::make_unique<dto::DTOListCursor<dto::NoteDTO>>(findByParentFolderId(parentFolderId));
+    }
+    
+    /**
+     * @brief Read the notes matching a search one at a time
+     * 
+     * @param searchTerm The term to search for
+     * @return A cursor over the same note DTOs as search()
      */
-    virtual std::vector<dto::NoteDTO*> search(const std::string& searchTerm) = 0;
+    virtual std::unique_ptr<dto::DTOCursor<dto::NoteDTO>> streamSearch(const std::string& searchTerm) {
+        return std::make_unique<dto::DTOListCursor<dto::NoteDTO>>(search(searchTerm));
+    }
     
     /**
      * @brief Delete a note by its ID
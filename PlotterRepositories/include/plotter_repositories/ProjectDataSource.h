@@ -3,7 +3,7 @@
 
 #include "DataSource.h"
 #include "BaseDTOs.h"
-#include <optional>
+#include "DTOList.h"
 #include <vector>
 #include <memory>
 
@@ -42,16 +42,16 @@ public:
      * @brief Find a project by its ID
      * 
      * @param id The ID of the project to find
-     * @return An optional containing the project DTO if found, std::nullopt otherwise
+     * @return The project DTO, or a null handle if not found
      */
-    virtual std::optional<dto::ProjectDTO*> findById(const std::string& id) = 0;
+    virtual dto::DTOPtr<dto::ProjectDTO> findById(const std::string& id) = 0;
     
     /**
      * @brief Get all projects from the datasource
      * 
-     * @return A vector containing all project DTOs
+     * @return A list containing all project DTOs
      */
-    virtual std::vector<dto::ProjectDTO*> findAll() = 0;
+    virtual dto::DTOList<dto::ProjectDTO> findAll() = 0;
     
     /**
      * @brief Delete a project by its ID
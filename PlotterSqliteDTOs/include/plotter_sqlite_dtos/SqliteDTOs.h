@@ -2,6 +2,8 @@
 #define PLOTTER_SQLITE_DTOS_H
 
 #include "BaseDTOs.h"
+#include "ChangeMask.h"
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -22,6 +24,7 @@ struct SqliteProjectDTO : public plotter::dto::ProjectDTO {
     long long createdAt;        // Unix timestamp in milliseconds
     long long updatedAt;        // Unix timestamp in milliseconds
     std::vector<std::string> folderIds;  // IDs of folders in this project
+    plotter::dto::ChangeMask changes;  // Fields an update has to write
     
     SqliteProjectDTO() : createdAt(0), updatedAt(0) {}
 };
@@ -43,6 +46,7 @@ struct SqliteFolderDTO : public plotter::dto::FolderDTO {
     long long updatedAt;
     std::vector<std::string> noteIds;       // IDs of notes in this folder
     std::vector<std::string> subfolderIds;  // IDs of subfolders
+    plotter::dto::ChangeMask changes;  // Fields an update has to write
     
     SqliteFolderDTO() : createdAt(0), updatedAt(0) {}
 };
@@ -52,6 +56,8 @@ struct SqliteFolderDTO : public plotter::dto::FolderDTO {
  * 
  * Inherits from base NoteDTO and defines SQLite-specific fields.
  * This DTO represents how Note metadata is stored in the SQLite database.
+ * Listing queries leave the content out: such DTOs have contentLoaded unset
+ * and a contentLoader that fetches the content when the note is read.
  */
 struct SqliteNoteDTO : public plotter::dto::NoteDTO {
     std::string id;
@@ -61,8 +67,11 @@ struct SqliteNoteDTO : public plotter::dto::NoteDTO {
     std::string parentFolderId;
     long long createdAt;
     long long updatedAt;
+    bool contentLoaded;         // False when content was not fetched; writes then keep the stored content
+    std::function<std::string()> contentLoader;  // Fetches the content when contentLoaded is false
+    plotter::dto::ChangeMask changes;  // Fields an update has to write
     
-    SqliteNoteDTO() : createdAt(0), updatedAt(0) {}
+    SqliteNoteDTO() : createdAt(0), updatedAt(0), contentLoaded(true) {}
 };
 
 /**
@@ -5,6 +5,7 @@
 #include "plotter_sqlite/SqliteDatabase.h"
 #include "plotter_sqlite_dtos/SqliteDTOs.h"
 #include <memory>
+#include <optional>
 #include <string>
 #include <chrono>
 
@@ -27,7 +28,6 @@ private:
 
     // Helper methods
     void updateMetrics(bool success, double responseTimeMs);
-    sqlite_dtos::SqliteFolderDTO* rowToDTO(SqliteStatement& stmt);
     std::vector<std::string> getNoteIdsByFolderId(const std::string& folderId);
     std::vector<std::string> getSubfolderIdsByParentId(const std::string& parentId);
 
@@ -53,10 +53,11 @@ public:
 
     // FolderDataSource interface
     std::string save(const plotter::dto::FolderDTO& folderDTO) override;
-    std::optional<plotter::dto::FolderDTO*> findById(const std::string& id) override;
-    std::vector<plotter::dto::FolderDTO*> findAll() override;
-    std::vector<plotter::dto::FolderDTO*> findByProjectId(const std::string& projectId) override;
-    std::vector<plotter::dto::FolderDTO*> findByParentFolderId(const std::string& parentFolderId) override;
+    plotter::dto::DTOPtr<plotter::dto::FolderDTO> findById(const std::string& id) override;
+    plotter::dto::DTOList<plotter::dto::FolderDTO> findAll() override;
+    plotter::dto::DTOList<plotter::dto::FolderDTO> findByProjectId(const std::string& projectId) override;
+    plotter::dto::DTOList<plotter::dto::FolderDTO> findByParentFolderId(const std::string& parentFolderId) override;
+    std::optional<plotter::dto::DTOList<plotter::dto::FolderDTO>> findAllInProject(const std::string& projectId) override;
     bool deleteById(const std::string& id) override;
     bool update(const plotter::dto::FolderDTO& folderDTO) override;
     bool exists(const std::string& id) override;
@@ -5,6 +5,7 @@
 #include "plotter_sqlite/SqliteDatabase.h"
 #include <memory>
 #include <string>
+#include <vector>
 #include <chrono>
 
 namespace plotter {
@@ -16,6 +17,14 @@ namespace sqlite {
  * Provides persistent storage for Note metadata using SQLite database.
  * Note: This only stores note metadata (id, name, path, parent folder).
  * Actual note content is stored via the NoteStorage interface.
+ *
+ * findById returns the content; listings (findAll, findByParentFolderId,
+ * search) skip the content column and hand out DTOs whose contentLoader
+ * fetches it for the notes that are actually read.
+ *
+ * The stream* variants step through the same listing queries one row at a
+ * time. A cursor needs the connection it was opened on: once the data
+ * source disconnects, its next() throws.
  */
 class SqliteNoteDataSource : public plotter::repositories::NoteDataSource {
 private:
@@ -27,6 +36,8 @@ private:
 
     // Helper methods
     void updateMetrics(bool success, double responseTimeMs);
+    std::unique_ptr<plotter::dto::DTOCursor<plotter::dto::NoteDTO>> openListing(
+        const char* sql, const std::vector<std::string>& parameters);
     long long getCurrentTimestamp();
 
 public:
@@ -51,10 +62,14 @@ public:
 
     // NoteDataSource interface - works with DTOs
     std::string save(const plotter::dto::NoteDTO& noteDTO) override;
-    std::optional<plotter::dto::NoteDTO*> findById(const std::string& id) override;
-    std::vector<plotter::dto::NoteDTO*> findAll() override;
-    std::vector<plotter::dto::NoteDTO*> findByParentFolderId(const std::string& parentFolderId) override;
-    std::vector<plotter::dto::NoteDTO*> search(const std::string& searchTerm) override;
+    plotter::dto::DTOPtr<plotter::dto::NoteDTO> findById(const std::string& id) override;
+    plotter::dto::DTOList<plotter::dto::NoteDTO> findAll() override;
+    plotter::dto::DTOList<plotter::dto::NoteDTO> findByParentFolderId(const std::string& parentFolderId) override;
+    plotter::dto::DTOList<plotter::dto::NoteDTO> findByParentFolderIds(const std::vector<std::string>& parentFolderIds) override;
+    plotter::dto::DTOList<plotter::dto::NoteDTO> search(const std::string& searchTerm) override;
+    std::unique_ptr<plotter::dto::DTOCursor<plotter::dto::NoteDTO>> streamAll() override;
+    std::unique_ptr<plotter::dto::DTOCursor<plotter::dto::NoteDTO>> streamByParentFolderId(const std::string& parentFolderId) override;
+    std::unique_ptr<plotter::dto::DTOCursor<plotter::dto::NoteDTO>> streamSearch(const std::string& searchTerm) override;
     bool deleteById(const std::string& id) override;
     bool update(const plotter::dto::NoteDTO& noteDTO) override;
     bool exists(const std::string& id) override;
@@ -27,7 +27,6 @@ private:
 
     // Helper methods
     void updateMetrics(bool success, double responseTimeMs);
-    sqlite_dtos::SqliteProjectDTO* rowToDTO(SqliteStatement& stmt);
     std::vector<std::string> getFolderIdsByProjectId(const std::string& projectId);
 
 public:
@@ -52,8 +51,8 @@ public:
 
     // ProjectDataSource interface
     std::string save(const plotter::dto::ProjectDTO& projectDTO) override;
-    std::optional<plotter::dto::ProjectDTO*> findById(const std::string& id) override;
-    std::vector<plotter::dto::ProjectDTO*> findAll() override;
+    plotter::dto::DTOPtr<plotter::dto::ProjectDTO> findById(const std::string& id) override;
+    plotter::dto::DTOList<plotter::dto::ProjectDTO> findAll() override;
     bool deleteById(const std::string& id) override;
     bool update(const plotter::dto::ProjectDTO& projectDTO) override;
     bool exists(const std::string& id) override;
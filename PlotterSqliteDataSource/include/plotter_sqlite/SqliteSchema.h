@@ -0,0 +1,269 @@
+#ifndef SQLITE_SCHEMA_H
+#define SQLITE_SCHEMA_H
+
+#include "SqliteDatabase.h"
+#include "plotter_sqlite_dtos/SqliteDTOs.h"
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace plotter {
+namespace sqlite {
+namespace schema {
+
+/**
+ * @brief SQL text built at compile time
+ *
+ * Holds N characters plus the terminating NUL, so c_str() can go straight
+ * to SqliteStatement.
+ */
+template<size_t N>
+struct FixedString {
+    char data[N + 1] = {};
+
+    constexpr FixedString() = default;
+
+    constexpr FixedString(const char (&text)[N + 1]) {
+        for (size_t i = 0; i < N; i++) {
+            data[i] = text[i];
+        }
+    }
+
+    constexpr const char* c_str() const { return data; }
+    static constexpr size_t size() { return N; }
+};
+
+template<size_t N>
+constexpr FixedString<N - 1> fixed(const char (&text)[N]) {
+    return FixedString<N - 1>(text);
+}
+
+template<size_t N>
+constexpr const FixedString<N>& fixed(const FixedString<N>& text) {
+    return text;
+}
+
+template<size_t... Ns>
+constexpr FixedString<(Ns + ... + 0)> concatFixed(const FixedString<Ns>&... parts) {
+    FixedString<(Ns + ... + 0)> result;
+    size_t position = 0;
+    auto append = [&](const auto& part) {
+        for (size_t i = 0; i < part.size(); i++) {
+            result.data[position++] = part.data[i];
+        }
+    };
+    (append(parts), ...);
+    return result;
+}
+
+/**
+ * @brief Join string literals and FixedStrings into one FixedString
+ */
+template<typename... Parts>
+constexpr auto concat(const Parts&... parts) {
+    return concatFixed(fixed(parts)...);
+}
+
+/**
+ * @brief One table column and the DTO member it maps to
+ *
+ * Nullable text columns store an empty member as NULL.
+ */
+template<typename Dto, typename T>
+struct Column {
+    const char* name;
+    T Dto::* member;
+    bool nullable;
+};
+
+template<typename Dto, typename T>
+constexpr Column<Dto, T> column(const char* name, T Dto::* member) {
+    return Column<Dto, T>{name, member, false};
+}
+
+template<typename Dto>
+constexpr Column<Dto, std::string> nullableColumn(const char* name, std::string Dto::* member) {
+    return Column<Dto, std::string>{name, member, true};
+}
+
+namespace detail {
+
+constexpr size_t length(const char* text) {
+    size_t n = 0;
+    while (text[n] != '\0') {
+        n++;
+    }
+    return n;
+}
+
+template<typename Table>
+constexpr size_t columnCount() {
+    return std::tuple_size<decltype(Table::columns)>::value;
+}
+
+// Length of "a, b, c" for the table's column names
+template<typename Table>
+constexpr size_t columnListLength() {
+    size_t total = 0;
+    std::apply([&](const auto&... fields) { ((total += length(fields.name) + 2), ...); }, Table::columns);
+    return total - 2;
+}
+
+template<typename Table>
+constexpr FixedString<columnListLength<Table>()> columnList() {
+    FixedString<columnListLength<Table>()> result;
+    size_t position = 0;
+    std::apply([&](const auto&... fields) {
+        auto append = [&](const char* name) {
+            if (position > 0) {
+                result.data[position++] = ',';
+                result.data[position++] = ' ';
+            }
+            for (size_t i = 0; name[i] != '\0'; i++) {
+                result.data[position++] = name[i];
+            }
+        };
+        (append(fields.name), ...);
+    }, Table::columns);
+    return result;
+}
+
+// "?, ?, ?" with one placeholder per column
+template<typename Table>
+constexpr FixedString<columnCount<Table>() * 3 - 2> placeholderList() {
+    FixedString<columnCount<Table>() * 3 - 2> result;
+    for (size_t i = 0, position = 0; i < columnCount<Table>(); i++) {
+        if (i > 0) {
+            result.data[position++] = ',';
+            result.data[position++] = ' ';
+        }
+        result.data[position++] = '?';
+    }
+    return result;
+}
+
+inline void bindValue(SqliteStatement& stmt, int index, const std::string& value, bool nullable) {
+    if (nullable && value.empty()) {
+        stmt.bindNull(index);
+    } else {
+        stmt.bindString(index, value);
+    }
+}
+
+inline void bindValue(SqliteStatement& stmt, int index, long long value, bool) {
+    stmt.bindInt64(index, value);
+}
+
+// NULL text reads back as an empty string
+inline void readValue(SqliteStatement& stmt, int index, std::string& value) {
+    value = stmt.getColumnString(index);
+}
+
+inline void readValue(SqliteStatement& stmt, int index, long long& value) {
+    value = stmt.getColumnInt64(index);
+}
+
+} // namespace detail
+
+/**
+ * @brief Column names of a table, comma separated, in declaration order
+ *
+ * For SELECT lists and INSERT column lists.
+ */
+template<typename Table>
+constexpr auto columnNames = detail::columnList<Table>();
+
+/**
+ * @brief One "?" per column of a table, comma separated
+ */
+template<typename Table>
+constexpr auto placeholders = detail::placeholderList<Table>();
+
+/**
+ * @brief Bind every column of a table from a DTO
+ *
+ * Parameters are numbered in column order from first.
+ *
+ * @return The index of the next parameter
+ */
+template<typename Table>
+int bindRow(SqliteStatement& stmt, const typename Table::Dto& dto, int first = 1) {
+    int index = first;
+    std::apply([&](const auto&... fields) {
+        (detail::bindValue(stmt, index++, dto.*fields.member, fields.nullable), ...);
+    }, Table::columns);
+    return index;
+}
+
+/**
+ * @brief Fill a DTO from the current row of a statement selecting columnNames<Table>
+ */
+template<typename Table>
+void readRow(SqliteStatement& stmt, typename Table::Dto& dto) {
+    int index = 0;
+    std::apply([&](const auto&... fields) {
+        (detail::readValue(stmt, index++, dto.*fields.member), ...);
+    }, Table::columns);
+}
+
+// ================ Tables ================
+//
+// Columns as created by SqliteDatabase::initializeSchema(). Queries select
+// and insert them in the order listed here.
+
+struct ProjectTable {
+    using Dto = sqlite_dtos::SqliteProjectDTO;
+    static constexpr auto columns = std::make_tuple(
+        column("id", &Dto::id),
+        column("name", &Dto::name),
+        column("description", &Dto::description),
+        column("created_at", &Dto::createdAt),
+        column("updated_at", &Dto::updatedAt));
+};
+
+struct FolderTable {
+    using Dto = sqlite_dtos::SqliteFolderDTO;
+    static constexpr auto columns = std::make_tuple(
+        column("id", &Dto::id),
+        column("name", &Dto::name),
+        column("description", &Dto::description),
+        nullableColumn("parent_project_id", &Dto::parentProjectId),
+        nullableColumn("parent_folder_id", &Dto::parentFolderId),
+        column("created_at", &Dto::createdAt),
+        column("updated_at", &Dto::updatedAt));
+};
+
+struct NoteTable {
+    using Dto = sqlite_dtos::SqliteNoteDTO;
+    static constexpr auto columns = std::make_tuple(
+        column("id", &Dto::id),
+        column("name", &Dto::name),
+        column("path", &Dto::path),
+        column("content", &Dto::content),
+        nullableColumn("parent_folder_id", &Dto::parentFolderId),
+        column("created_at", &Dto::createdAt),
+        column("updated_at", &Dto::updatedAt));
+};
+
+/**
+ * @brief Projection of the notes table used by listings
+ *
+ * Leaves out the content, which is fetched per note when it is read.
+ */
+struct NoteListing {
+    using Dto = sqlite_dtos::SqliteNoteDTO;
+    static constexpr auto columns = std::make_tuple(
+        column("id", &Dto::id),
+        column("name", &Dto::name),
+        column("path", &Dto::path),
+        nullableColumn("parent_folder_id", &Dto::parentFolderId),
+        column("created_at", &Dto::createdAt),
+        column("updated_at", &Dto::updatedAt));
+};
+
+} // namespace schema
+} // namespace sqlite
+} // namespace plotter
+
+#endif // SQLITE_SCHEMA_H
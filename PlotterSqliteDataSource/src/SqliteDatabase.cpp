@@ -37,7 +37,9 @@ void SqliteDatabase::connect() {
 
 void SqliteDatabase::disconnect() {
     if (connected && db) {
-        sqlite3_close(db);
+        // Statements still open, such as an unfinished cursor, keep the
+        // connection alive until they are finalized
+        sqlite3_close_v2(db);
         db = nullptr;
         connected = false;
     }
@@ -1,8 +1,40 @@
 #include "plotter_sqlite/SqliteFolderDataSource.h"
+#include "plotter_sqlite/SqliteSchema.h"
 
 namespace plotter {
 namespace sqlite {
 
+namespace {
+
+using schema::FolderTable;
+
+// Statements are assembled at compile time from the FolderTable columns
+constexpr auto SELECT_FOLDERS = schema::concat("SELECT ", schema::columnNames<FolderTable>, " FROM folders");
+constexpr auto SELECT_BY_ID = schema::concat(SELECT_FOLDERS, " WHERE id = ?;");
+constexpr auto SELECT_ALL = schema::concat(SELECT_FOLDERS, ";");
+constexpr auto SELECT_BY_PROJECT = schema::concat(SELECT_FOLDERS, " WHERE parent_project_id = ?;");
+constexpr auto SELECT_BY_PARENT = schema::concat(SELECT_FOLDERS, " WHERE parent_folder_id = ?;");
+
+// Every folder below the project's top-level folders; UNION drops a folder
+// reached twice, which also ends the recursion on a cycle
+constexpr auto SELECT_PROJECT_TREE = schema::concat(R"(
+    WITH RECURSIVE tree(id) AS (
+        SELECT id FROM folders WHERE parent_project_id = ?
+        UNION
+        SELECT f.id FROM folders f JOIN tree t ON f.parent_folder_id = t.id
+    ))", SELECT_FOLDERS, " WHERE id IN tree;");
+
+constexpr auto UPSERT = schema::concat(
+    "INSERT INTO folders (", schema::columnNames<FolderTable>, ") VALUES (", schema::placeholders<FolderTable>, R"()
+    ON CONFLICT(id) DO UPDATE SET
+        name = excluded.name,
+        description = excluded.description,
+        parent_project_id = excluded.parent_project_id,
+        parent_folder_id = excluded.parent_folder_id,
+        updated_at = excluded.updated_at;)");
+
+} // namespace
+
 SqliteFolderDataSource::SqliteFolderDataSource(const std::string& name, const std::string& dbPath, int priority)
     : name(name), priority(priority), database(std::make_shared<SqliteDatabase>(dbPath)), available(false) {}
 
@@ -81,36 +113,8 @@ std::string SqliteFolderDataSource::save(const plotter::dto::FolderDTO& folderDT
 
         const sqlite_dtos::SqliteFolderDTO& dto = dynamic_cast<const sqlite_dtos::SqliteFolderDTO&>(folderDTO);
 
-        const char* sql = R"(
-            INSERT INTO folders (id, name, description, parent_project_id, parent_folder_id, created_at, updated_at)
-            VALUES (?, ?, ?, ?, ?, ?, ?)
-            ON CONFLICT(id) DO UPDATE SET
-                name = excluded.name,
-                description = excluded.description,
-                parent_project_id = excluded.parent_project_id,
-                parent_folder_id = excluded.parent_folder_id,
-                updated_at = excluded.updated_at;
-        )";
-
-        SqliteStatement stmt(database->getHandle(), sql);
-        stmt.bindString(1, dto.id);
-        stmt.bindString(2, dto.name);
-        stmt.bindString(3, dto.description);
-        
-        if (dto.parentProjectId.empty()) {
-            stmt.bindNull(4);
-        } else {
-            stmt.bindString(4, dto.parentProjectId);
-        }
-        
-        if (dto.parentFolderId.empty()) {
-            stmt.bindNull(5);
-        } else {
-            stmt.bindString(5, dto.parentFolderId);
-        }
-        
-        stmt.bindInt64(6, dto.createdAt);
-        stmt.bindInt64(7, dto.updatedAt);
+        SqliteStatement stmt(database->getHandle(), UPSERT.c_str());
+        schema::bindRow<FolderTable>(stmt, dto);
 
         if (!stmt.execute()) {
             throw std::runtime_error("Failed to save folder");
@@ -129,7 +133,7 @@ std::string SqliteFolderDataSource::save(const plotter::dto::FolderDTO& folderDT
     }
 }
 
-std::optional<plotter::dto::FolderDTO*> SqliteFolderDataSource::findById(const std::string& id) {
+plotter::dto::DTOPtr<plotter::dto::FolderDTO> SqliteFolderDataSource::findById(const std::string& id) {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -137,17 +141,14 @@ std::optional<plotter::dto::FolderDTO*> SqliteFolderDataSource::findById(const s
             throw std::runtime_error("Database is not available");
         }
 
-        const char* sql = R"(
-            SELECT id, name, description, parent_project_id, parent_folder_id, created_at, updated_at
-            FROM folders WHERE id = ?;
-        )";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
+        SqliteStatement stmt(database->getHandle(), SELECT_BY_ID.c_str());
         stmt.bindString(1, id);
 
-        std::optional<plotter::dto::FolderDTO*> result;
+        plotter::dto::DTOPtr<plotter::dto::FolderDTO> result;
         if (stmt.step() == SQLITE_ROW) {
-            result = rowToDTO(stmt);
+            auto dto = std::make_unique<sqlite_dtos::SqliteFolderDTO>();
+            schema::readRow<FolderTable>(stmt, *dto);
+            result = std::move(dto);
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -163,7 +164,7 @@ std::optional<plotter::dto::FolderDTO*> SqliteFolderDataSource::findById(const s
     }
 }
 
-std::vector<plotter::dto::FolderDTO*> SqliteFolderDataSource::findAll() {
+plotter::dto::DTOList<plotter::dto::FolderDTO> SqliteFolderDataSource::findAll() {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -171,16 +172,11 @@ std::vector<plotter::dto::FolderDTO*> SqliteFolderDataSource::findAll() {
             throw std::runtime_error("Database is not available");
         }
 
-        const char* sql = R"(
-            SELECT id, name, description, parent_project_id, parent_folder_id, created_at, updated_at
-            FROM folders;
-        )";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
-        std::vector<plotter::dto::FolderDTO*> folders;
+        SqliteStatement stmt(database->getHandle(), SELECT_ALL.c_str());
+        plotter::dto::DTOList<plotter::dto::FolderDTO> folders;
 
         while (stmt.step() == SQLITE_ROW) {
-            folders.push_back(rowToDTO(stmt));
+            schema::readRow<FolderTable>(stmt, folders.emplace_back<sqlite_dtos::SqliteFolderDTO>());
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -196,7 +192,7 @@ std::vector<plotter::dto::FolderDTO*> SqliteFolderDataSource::findAll() {
     }
 }
 
-std::vector<plotter::dto::FolderDTO*> SqliteFolderDataSource::findByProjectId(const std::string& projectId) {
+plotter::dto::DTOList<plotter::dto::FolderDTO> SqliteFolderDataSource::findByProjectId(const std::string& projectId) {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -204,18 +200,13 @@ std::vector<plotter::dto::FolderDTO*> SqliteFolderDataSource::findByProjectId(co
             throw std::runtime_error("Database is not available");
         }
 
-        const char* sql = R"(
-            SELECT id, name, description, parent_project_id, parent_folder_id, created_at, updated_at
-            FROM folders WHERE parent_project_id = ?;
-        )";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
+        SqliteStatement stmt(database->getHandle(), SELECT_BY_PROJECT.c_str());
         stmt.bindString(1, projectId);
         
-        std::vector<plotter::dto::FolderDTO*> folders;
+        plotter::dto::DTOList<plotter::dto::FolderDTO> folders;
 
         while (stmt.step() == SQLITE_ROW) {
-            folders.push_back(rowToDTO(stmt));
+            schema::readRow<FolderTable>(stmt, folders.emplace_back<sqlite_dtos::SqliteFolderDTO>());
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -231,7 +222,7 @@ std::vector<plotter::dto::FolderDTO*> SqliteFolderDataSource::findByProjectId(co
     }
 }
 
-std::vector<plotter::dto::FolderDTO*> SqliteFolderDataSource::findByParentFolderId(const std::string& parentFolderId) {
+plotter::dto::DTOList<plotter::dto::FolderDTO> SqliteFolderDataSource::findByParentFolderId(const std::string& parentFolderId) {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -239,18 +230,44 @@ std::vector<plotter::dto::FolderDTO*> SqliteFolderDataSource::findByParentFolder
             throw std::runtime_error("Database is not available");
         }
 
-        const char* sql = R"(
-            SELECT id, name, description, parent_project_id, parent_folder_id, created_at, updated_at
-            FROM folders WHERE parent_folder_id = ?;
-        )";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
+        SqliteStatement stmt(database->getHandle(), SELECT_BY_PARENT.c_str());
         stmt.bindString(1, parentFolderId);
         
-        std::vector<plotter::dto::FolderDTO*> folders;
+        plotter::dto::DTOList<plotter::dto::FolderDTO> folders;
 
         while (stmt.step() == SQLITE_ROW) {
-            folders.push_back(rowToDTO(stmt));
+            schema::readRow<FolderTable>(stmt, folders.emplace_back<sqlite_dtos::SqliteFolderDTO>());
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        updateMetrics(true, elapsed.count());
+
+        return folders;
+    } catch (const std::exception& e) {
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        updateMetrics(false, elapsed.count());
+        throw;
+    }
+}
+
+std::optional<plotter::dto::DTOList<plotter::dto::FolderDTO>> SqliteFolderDataSource::findAllInProject(
+    const std::string& projectId) {
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    try {
+        if (!isAvailable()) {
+            throw std::runtime_error("Database is not available");
+        }
+
+        SqliteStatement stmt(database->getHandle(), SELECT_PROJECT_TREE.c_str());
+        stmt.bindString(1, projectId);
+        
+        plotter::dto::DTOList<plotter::dto::FolderDTO> folders;
+
+        while (stmt.step() == SQLITE_ROW) {
+            schema::readRow<FolderTable>(stmt, folders.emplace_back<sqlite_dtos::SqliteFolderDTO>());
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -309,30 +326,38 @@ bool SqliteFolderDataSource::update(const plotter::dto::FolderDTO& folderDTO) {
             return false;
         }
 
-        const char* sql = R"(
-            UPDATE folders 
-            SET name = ?, description = ?, parent_project_id = ?, parent_folder_id = ?, updated_at = ?
-            WHERE id = ?;
-        )";
+        // Only the changed columns are written
+        const plotter::dto::ChangeMask& changes = dto.changes;
+        std::string sql = "UPDATE folders SET ";
+        if (changes.has(plotter::dto::ChangeMask::NAME)) sql += "name = ?, ";
+        if (changes.has(plotter::dto::ChangeMask::DESCRIPTION)) sql += "description = ?, ";
+        if (changes.has(plotter::dto::ChangeMask::PARENT)) sql += "parent_project_id = ?, parent_folder_id = ?, ";
+        sql += "updated_at = ? WHERE id = ?;";
 
         SqliteStatement stmt(database->getHandle(), sql);
-        stmt.bindString(1, dto.name);
-        stmt.bindString(2, dto.description);
-        
-        if (dto.parentProjectId.empty()) {
-            stmt.bindNull(3);
-        } else {
-            stmt.bindString(3, dto.parentProjectId);
+        int index = 1;
+        if (changes.has(plotter::dto::ChangeMask::NAME)) {
+            stmt.bindString(index++, dto.name);
         }
-        
-        if (dto.parentFolderId.empty()) {
-            stmt.bindNull(4);
-        } else {
-            stmt.bindString(4, dto.parentFolderId);
+        if (changes.has(plotter::dto::ChangeMask::DESCRIPTION)) {
+            stmt.bindString(index++, dto.description);
+        }
+        if (changes.has(plotter::dto::ChangeMask::PARENT)) {
+            if (dto.parentProjectId.empty()) {
+                stmt.bindNull(index++);
+            } else {
+                stmt.bindString(index++, dto.parentProjectId);
+            }
+            
+            if (dto.parentFolderId.empty()) {
+                stmt.bindNull(index++);
+            } else {
+                stmt.bindString(index++, dto.parentFolderId);
+            }
         }
         
-        stmt.bindInt64(5, dto.updatedAt);
-        stmt.bindString(6, dto.id);
+        stmt.bindInt64(index++, dto.updatedAt);
+        stmt.bindString(index++, dto.id);
 
         bool success = stmt.execute();
 
@@ -413,18 +438,6 @@ void SqliteFolderDataSource::updateMetrics(bool success, double responseTimeMs)
     metrics.lastAccessTime = std::chrono::system_clock::now();
 }
 
-sqlite_dtos::SqliteFolderDTO* SqliteFolderDataSource::rowToDTO(SqliteStatement& stmt) {
-    sqlite_dtos::SqliteFolderDTO* dto = new sqlite_dtos::SqliteFolderDTO();
-    dto->id = stmt.getColumnString(0);
-    dto->name = stmt.getColumnString(1);
-    dto->description = stmt.getColumnString(2);
-    dto->parentProjectId = stmt.isColumnNull(3) ? "" : stmt.getColumnString(3);
-    dto->parentFolderId = stmt.isColumnNull(4) ? "" : stmt.getColumnString(4);
-    dto->createdAt = stmt.getColumnInt64(5);
-    dto->updatedAt = stmt.getColumnInt64(6);
-    return dto;
-}
-
 std::vector<std::string> SqliteFolderDataSource::getNoteIdsByFolderId(const std::string& folderId) {
     std::vector<std::string> noteIds;
     
@@ -1,11 +1,106 @@
 #include "plotter_sqlite/SqliteNoteDataSource.h"
+#include "plotter_sqlite/SqliteSchema.h"
 #include "plotter_sqlite_dtos/SqliteDTOs.h"
+#include <algorithm>
 #include <iostream>
 #include <sqlite3.h>
 
 namespace plotter {
 namespace sqlite {
 
+namespace {
+
+using schema::NoteTable;
+using schema::NoteListing;
+
+// Statements are assembled at compile time from the NoteTable columns and the
+// NoteListing projection
+constexpr auto SELECT_BY_ID = schema::concat(
+    "SELECT ", schema::columnNames<NoteTable>, " FROM notes WHERE id = ?;");
+constexpr auto LIST_NOTES = schema::concat("SELECT ", schema::columnNames<NoteListing>, " FROM notes");
+constexpr auto LIST_ALL = schema::concat(LIST_NOTES, ";");
+constexpr auto LIST_BY_PARENT = schema::concat(LIST_NOTES, " WHERE parent_folder_id = ?;");
+constexpr auto LIST_BY_PARENTS = schema::concat(LIST_NOTES, " WHERE parent_folder_id IN (");
+constexpr auto LIST_MATCHING = schema::concat(LIST_NOTES, " WHERE name LIKE ? OR content LIKE ?;");
+
+constexpr auto INSERT_NOTE = schema::concat(
+    "INSERT INTO notes (", schema::columnNames<NoteTable>, ") VALUES (", schema::placeholders<NoteTable>, ")");
+
+// A DTO whose content was never fetched must not overwrite the stored content
+constexpr auto UPSERT = schema::concat(INSERT_NOTE, R"(
+    ON CONFLICT(id) DO UPDATE SET
+        name = excluded.name,
+        path = excluded.path,
+        content = excluded.content,
+        parent_folder_id = excluded.parent_folder_id,
+        updated_at = excluded.updated_at;)");
+constexpr auto UPSERT_KEEPING_CONTENT = schema::concat(INSERT_NOTE, R"(
+    ON CONFLICT(id) DO UPDATE SET
+        name = excluded.name,
+        path = excluded.path,
+        parent_folder_id = excluded.parent_folder_id,
+        updated_at = excluded.updated_at;)");
+
+// Folder IDs bound per statement by findByParentFolderIds(), well under
+// SQLite's host parameter limit
+constexpr size_t FOLDERS_PER_QUERY = 500;
+
+std::string loadContent(const std::shared_ptr<SqliteDatabase>& database, const std::string& id) {
+    if (!database->isConnected()) {
+        throw std::runtime_error("Database is not available");
+    }
+
+    SqliteStatement stmt(database->getHandle(), "SELECT content FROM notes WHERE id = ?;");
+    stmt.bindString(1, id);
+    if (stmt.step() != SQLITE_ROW) {
+        throw std::runtime_error("Note not found: " + id);
+    }
+    return stmt.isColumnNull(0) ? "" : stmt.getColumnString(0);
+}
+
+void readListingRow(SqliteStatement& stmt, const std::shared_ptr<SqliteDatabase>& database,
+                    sqlite_dtos::SqliteNoteDTO& dto) {
+    schema::readRow<NoteListing>(stmt, dto);
+    dto.contentLoaded = false;
+    std::string id = dto.id;
+    dto.contentLoader = [database, id]() { return loadContent(database, id); };
+}
+
+// Steps a listing statement one row per next(), refilling the same DTO
+class ListingCursor : public plotter::dto::DTOCursor<plotter::dto::NoteDTO> {
+public:
+    ListingCursor(std::shared_ptr<SqliteDatabase> database, std::unique_ptr<SqliteStatement> stmt)
+        : database(std::move(database)), handle(this->database->getHandle()), stmt(std::move(stmt)) {}
+
+    plotter::dto::NoteDTO* next() override {
+        if (!stmt) {
+            return nullptr;
+        }
+        if (!database->isConnected() || database->getHandle() != handle) {
+            throw std::runtime_error("Database is not available");
+        }
+
+        int rc = stmt->step();
+        if (rc == SQLITE_ROW) {
+            readListingRow(*stmt, database, row);
+            return &row;
+        }
+        stmt.reset();  // Done with the query; finalize it now rather than with the cursor
+        if (rc != SQLITE_DONE) {
+            throw std::runtime_error("Failed to read notes: " + std::string(sqlite3_errstr(rc)));
+        }
+        return nullptr;
+    }
+
+private:
+    std::shared_ptr<SqliteDatabase> database;
+    sqlite3* handle;  // Connection the statement was prepared on
+    std::unique_ptr<SqliteStatement> stmt;
+    sqlite_dtos::SqliteNoteDTO row;
+};
+
+} // namespace
+
 SqliteNoteDataSource::SqliteNoteDataSource(const std::string& name, const std::string& dbPath, int priority)
     : name(name), priority(priority), database(std::make_shared<SqliteDatabase>(dbPath)), available(false) {}
 
@@ -84,31 +179,9 @@ std::string SqliteNoteDataSource::save(const plotter::dto::NoteDTO& noteDTO) {
 
         const sqlite_dtos::SqliteNoteDTO& dto = dynamic_cast<const sqlite_dtos::SqliteNoteDTO&>(noteDTO);
 
-        const char* sql = R"(
-            INSERT INTO notes (id, name, path, content, parent_folder_id, created_at, updated_at)
-            VALUES (?, ?, ?, ?, ?, ?, ?)
-            ON CONFLICT(id) DO UPDATE SET
-                name = excluded.name,
-                path = excluded.path,
-                content = excluded.content,
-                parent_folder_id = excluded.parent_folder_id,
-                updated_at = excluded.updated_at;
-        )";
-
+        const char* sql = dto.contentLoaded ? UPSERT.c_str() : UPSERT_KEEPING_CONTENT.c_str();
         SqliteStatement stmt(database->getHandle(), sql);
-        stmt.bindString(1, dto.id);
-        stmt.bindString(2, dto.name);
-        stmt.bindString(3, dto.path);
-        stmt.bindString(4, dto.content);
-        
-        if (dto.parentFolderId.empty()) {
-            stmt.bindNull(5);
-        } else {
-            stmt.bindString(5, dto.parentFolderId);
-        }
-        
-        stmt.bindInt64(6, dto.createdAt);
-        stmt.bindInt64(7, dto.updatedAt);
+        schema::bindRow<NoteTable>(stmt, dto);
 
         if (!stmt.execute()) {
             throw std::runtime_error("Failed to save note");
@@ -127,7 +200,7 @@ std::string SqliteNoteDataSource::save(const plotter::dto::NoteDTO& noteDTO) {
     }
 }
 
-std::optional<plotter::dto::NoteDTO*> SqliteNoteDataSource::findById(const std::string& id) {
+plotter::dto::DTOPtr<plotter::dto::NoteDTO> SqliteNoteDataSource::findById(const std::string& id) {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -135,23 +208,14 @@ std::optional<plotter::dto::NoteDTO*> SqliteNoteDataSource::findById(const std::
             throw std::runtime_error("Database is not available");
         }
 
-        const char* sql = "SELECT id, name, path, content, parent_folder_id, created_at, updated_at FROM notes WHERE id = ?;";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
+        SqliteStatement stmt(database->getHandle(), SELECT_BY_ID.c_str());
         stmt.bindString(1, id);
 
-        std::optional<plotter::dto::NoteDTO*> result;
+        plotter::dto::DTOPtr<plotter::dto::NoteDTO> result;
         if (stmt.step() == SQLITE_ROW) {
-            auto* dto = new sqlite_dtos::SqliteNoteDTO();
-            dto->id = stmt.getColumnString(0);
-            dto->name = stmt.getColumnString(1);
-            dto->path = stmt.getColumnString(2);
-            dto->content = stmt.isColumnNull(3) ? "" : stmt.getColumnString(3);
-            dto->parentFolderId = stmt.isColumnNull(4) ? "" : stmt.getColumnString(4);
-            dto->createdAt = stmt.getColumnInt64(5);
-            dto->updatedAt = stmt.getColumnInt64(6);
-            
-            result = dto;
+            auto dto = std::make_unique<sqlite_dtos::SqliteNoteDTO>();
+            schema::readRow<NoteTable>(stmt, *dto);
+            result = std::move(dto);
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -167,7 +231,7 @@ std::optional<plotter::dto::NoteDTO*> SqliteNoteDataSource::findById(const std::
     }
 }
 
-std::vector<plotter::dto::NoteDTO*> SqliteNoteDataSource::findAll() {
+plotter::dto::DTOList<plotter::dto::NoteDTO> SqliteNoteDataSource::findAll() {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -175,22 +239,11 @@ std::vector<plotter::dto::NoteDTO*> SqliteNoteDataSource::findAll() {
             throw std::runtime_error("Database is not available");
         }
 
-        const char* sql = "SELECT id, name, path, content, parent_folder_id, created_at, updated_at FROM notes;";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
-        std::vector<plotter::dto::NoteDTO*> notes;
+        SqliteStatement stmt(database->getHandle(), LIST_ALL.c_str());
+        plotter::dto::DTOList<plotter::dto::NoteDTO> notes;
 
         while (stmt.step() == SQLITE_ROW) {
-            auto* dto = new sqlite_dtos::SqliteNoteDTO();
-            dto->id = stmt.getColumnString(0);
-            dto->name = stmt.getColumnString(1);
-            dto->path = stmt.getColumnString(2);
-            dto->content = stmt.isColumnNull(3) ? "" : stmt.getColumnString(3);
-            dto->parentFolderId = stmt.isColumnNull(4) ? "" : stmt.getColumnString(4);
-            dto->createdAt = stmt.getColumnInt64(5);
-            dto->updatedAt = stmt.getColumnInt64(6);
-            
-            notes.push_back(dto);
+            readListingRow(stmt, database, notes.emplace_back<sqlite_dtos::SqliteNoteDTO>());
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -206,7 +259,7 @@ std::vector<plotter::dto::NoteDTO*> SqliteNoteDataSource::findAll() {
     }
 }
 
-std::vector<plotter::dto::NoteDTO*> SqliteNoteDataSource::findByParentFolderId(const std::string& parentFolderId) {
+plotter::dto::DTOList<plotter::dto::NoteDTO> SqliteNoteDataSource::findByParentFolderId(const std::string& parentFolderId) {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -214,24 +267,13 @@ std::vector<plotter::dto::NoteDTO*> SqliteNoteDataSource::findByParentFolderId(c
             throw std::runtime_error("Database is not available");
         }
 
-        const char* sql = "SELECT id, name, path, content, parent_folder_id, created_at, updated_at FROM notes WHERE parent_folder_id = ?;";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
+        SqliteStatement stmt(database->getHandle(), LIST_BY_PARENT.c_str());
         stmt.bindString(1, parentFolderId);
         
-        std::vector<plotter::dto::NoteDTO*> notes;
+        plotter::dto::DTOList<plotter::dto::NoteDTO> notes;
 
         while (stmt.step() == SQLITE_ROW) {
-            auto* dto = new sqlite_dtos::SqliteNoteDTO();
-            dto->id = stmt.getColumnString(0);
-            dto->name = stmt.getColumnString(1);
-            dto->path = stmt.getColumnString(2);
-            dto->content = stmt.isColumnNull(3) ? "" : stmt.getColumnString(3);
-            dto->parentFolderId = stmt.isColumnNull(4) ? "" : stmt.getColumnString(4);
-            dto->createdAt = stmt.getColumnInt64(5);
-            dto->updatedAt = stmt.getColumnInt64(6);
-            
-            notes.push_back(dto);
+            readListingRow(stmt, database, notes.emplace_back<sqlite_dtos::SqliteNoteDTO>());
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -247,7 +289,8 @@ std::vector<plotter::dto::NoteDTO*> SqliteNoteDataSource::findByParentFolderId(c
     }
 }
 
-std::vector<plotter::dto::NoteDTO*> SqliteNoteDataSource::search(const std::string& searchTerm) {
+plotter::dto::DTOList<plotter::dto::NoteDTO> SqliteNoteDataSource::findByParentFolderIds(
+    const std::vector<std::string>& parentFolderIds) {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -255,26 +298,55 @@ std::vector<plotter::dto::NoteDTO*> SqliteNoteDataSource::search(const std::stri
             throw std::runtime_error("Database is not available");
         }
 
-        const char* sql = "SELECT id, name, path, content, parent_folder_id, created_at, updated_at FROM notes WHERE name LIKE ? OR content LIKE ?;";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
+        plotter::dto::DTOList<plotter::dto::NoteDTO> notes;
+
+        for (size_t first = 0; first < parentFolderIds.size(); first += FOLDERS_PER_QUERY) {
+            size_t count = std::min(FOLDERS_PER_QUERY, parentFolderIds.size() - first);
+            std::string sql = LIST_BY_PARENTS.c_str();
+            for (size_t i = 0; i < count; i++) {
+                sql += i == 0 ? "?" : ", ?";
+            }
+            sql += ");";
+
+            SqliteStatement stmt(database->getHandle(), sql);
+            for (size_t i = 0; i < count; i++) {
+                stmt.bindString(static_cast<int>(i) + 1, parentFolderIds[first + i]);
+            }
+            while (stmt.step() == SQLITE_ROW) {
+                readListingRow(stmt, database, notes.emplace_back<sqlite_dtos::SqliteNoteDTO>());
+            }
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        updateMetrics(true, elapsed.count());
+
+        return notes;
+    } catch (const std::exception& e) {
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        updateMetrics(false, elapsed.count());
+        throw;
+    }
+}
+
+plotter::dto::DTOList<plotter::dto::NoteDTO> SqliteNoteDataSource::search(const std::string& searchTerm) {
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    try {
+        if (!isAvailable()) {
+            throw std::runtime_error("Database is not available");
+        }
+
+        SqliteStatement stmt(database->getHandle(), LIST_MATCHING.c_str());
         std::string pattern = "%" + searchTerm + "%";
         stmt.bindString(1, pattern);
         stmt.bindString(2, pattern);
         
-        std::vector<plotter::dto::NoteDTO*> notes;
+        plotter::dto::DTOList<plotter::dto::NoteDTO> notes;
 
         while (stmt.step() == SQLITE_ROW) {
-            auto* dto = new sqlite_dtos::SqliteNoteDTO();
-            dto->id = stmt.getColumnString(0);
-            dto->name = stmt.getColumnString(1);
-            dto->path = stmt.getColumnString(2);
-            dto->content = stmt.isColumnNull(3) ? "" : stmt.getColumnString(3);
-            dto->parentFolderId = stmt.isColumnNull(4) ? "" : stmt.getColumnString(4);
-            dto->createdAt = stmt.getColumnInt64(5);
-            dto->updatedAt = stmt.getColumnInt64(6);
-            
-            notes.push_back(dto);
+            readListingRow(stmt, database, notes.emplace_back<sqlite_dtos::SqliteNoteDTO>());
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -290,6 +362,19 @@ std::vector<plotter::dto::NoteDTO*> SqliteNoteDataSource::search(const std::stri
     }
 }
 
+std::unique_ptr<plotter::dto::DTOCursor<plotter::dto::NoteDTO>> SqliteNoteDataSource::streamAll() {
+    return openListing(LIST_ALL.c_str(), {});
+}
+
+std::unique_ptr<plotter::dto::DTOCursor<plotter::dto::NoteDTO>> SqliteNoteDataSource::streamByParentFolderId(const std::string& parentFolderId) {
+    return openListing(LIST_BY_PARENT.c_str(), {parentFolderId});
+}
+
+std::unique_ptr<plotter::dto::DTOCursor<plotter::dto::NoteDTO>> SqliteNoteDataSource::streamSearch(const std::string& searchTerm) {
+    std::string pattern = "%" + searchTerm + "%";
+    return openListing(LIST_MATCHING.c_str(), {pattern, pattern});
+}
+
 bool SqliteNoteDataSource::deleteById(const std::string& id) {
     auto start = std::chrono::high_resolution_clock::now();
     
@@ -338,27 +423,38 @@ bool SqliteNoteDataSource::update(const plotter::dto::NoteDTO& noteDTO) {
 
         std::cout << "[DEBUG] SqliteNoteDataSource::update - note exists, proceeding with UPDATE" << std::endl;
 
-        const char* sql = R"(
-            UPDATE notes 
-            SET name = ?, path = ?, content = ?, parent_folder_id = ?, updated_at = ?
-            WHERE id = ?;
-        )";
+        // Only the changed columns are written; content also needs to have been loaded
+        const plotter::dto::ChangeMask& changes = dto.changes;
+        bool writeContent = changes.has(plotter::dto::ChangeMask::CONTENT) && dto.contentLoaded;
+        std::string sql = "UPDATE notes SET ";
+        if (changes.has(plotter::dto::ChangeMask::NAME)) sql += "name = ?, ";
+        if (changes.has(plotter::dto::ChangeMask::PATH)) sql += "path = ?, ";
+        if (writeContent) sql += "content = ?, ";
+        if (changes.has(plotter::dto::ChangeMask::PARENT)) sql += "parent_folder_id = ?, ";
+        sql += "updated_at = ? WHERE id = ?;";
 
         SqliteStatement stmt(database->getHandle(), sql);
-        stmt.bindString(1, dto.name);
-        stmt.bindString(2, dto.path);
-        stmt.bindString(3, dto.content);
-        
-        std::cout << "[DEBUG] SqliteNoteDataSource::update - binding content with length: " << dto.content.length() << std::endl;
-        
-        if (dto.parentFolderId.empty()) {
-            stmt.bindNull(4);
-        } else {
-            stmt.bindString(4, dto.parentFolderId);
+        int index = 1;
+        if (changes.has(plotter::dto::ChangeMask::NAME)) {
+            stmt.bindString(index++, dto.name);
+        }
+        if (changes.has(plotter::dto::ChangeMask::PATH)) {
+            stmt.bindString(index++, dto.path);
+        }
+        if (writeContent) {
+            stmt.bindString(index++, dto.content);
+            std::cout << "[DEBUG] SqliteNoteDataSource::update - binding content with length: " << dto.content.length() << std::endl;
+        }
+        if (changes.has(plotter::dto::ChangeMask::PARENT)) {
+            if (dto.parentFolderId.empty()) {
+                stmt.bindNull(index++);
+            } else {
+                stmt.bindString(index++, dto.parentFolderId);
+            }
         }
         
-        stmt.bindInt64(5, dto.updatedAt);
-        stmt.bindString(6, dto.id);
+        stmt.bindInt64(index++, dto.updatedAt);
+        stmt.bindString(index++, dto.id);
 
         int result = stmt.step();
         bool success = (result == SQLITE_DONE);
@@ -449,6 +545,35 @@ void SqliteNoteDataSource::updateMetrics(bool success, double responseTimeMs) {
     metrics.lastAccessTime = std::chrono::system_clock::now();
 }
 
+std::unique_ptr<plotter::dto::DTOCursor<plotter::dto::NoteDTO>> SqliteNoteDataSource::openListing(
+    const char* sql, const std::vector<std::string>& parameters) {
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    try {
+        if (!isAvailable()) {
+            throw std::runtime_error("Database is not available");
+        }
+
+        auto stmt = std::make_unique<SqliteStatement>(database->getHandle(), sql);
+        for (size_t i = 0; i < parameters.size(); i++) {
+            stmt->bindString(static_cast<int>(i) + 1, parameters[i]);
+        }
+        auto cursor = std::make_unique<ListingCursor>(database, std::move(stmt));
+
+        // Only opening the query is measured; rows are read at the caller's pace
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        updateMetrics(true, elapsed.count());
+
+        return cursor;
+    } catch (const std::exception& e) {
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        updateMetrics(false, elapsed.count());
+        throw;
+    }
+}
+
 long long SqliteNoteDataSource::getCurrentTimestamp() {
     return std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()
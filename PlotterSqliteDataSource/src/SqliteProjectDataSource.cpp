@@ -1,8 +1,27 @@
 #include "plotter_sqlite/SqliteProjectDataSource.h"
+#include "plotter_sqlite/SqliteSchema.h"
 
 namespace plotter {
 namespace sqlite {
 
+namespace {
+
+using schema::ProjectTable;
+
+// Query text generated from ProjectTable
+constexpr auto SELECT_PROJECTS = schema::concat("SELECT ", schema::columnNames<ProjectTable>, " FROM projects");
+constexpr auto SELECT_BY_ID = schema::concat(SELECT_PROJECTS, " WHERE id = ?;");
+constexpr auto SELECT_ALL = schema::concat(SELECT_PROJECTS, ";");
+
+constexpr auto UPSERT = schema::concat(
+    "INSERT INTO projects (", schema::columnNames<ProjectTable>, ") VALUES (", schema::placeholders<ProjectTable>, R"()
+    ON CONFLICT(id) DO UPDATE SET
+        name = excluded.name,
+        description = excluded.description,
+        updated_at = excluded.updated_at;)");
+
+} // namespace
+
 SqliteProjectDataSource::SqliteProjectDataSource(const std::string& name, const std::string& dbPath, int priority)
     : name(name), priority(priority), database(std::make_shared<SqliteDatabase>(dbPath)), available(false) {}
 
@@ -82,21 +101,8 @@ std::string SqliteProjectDataSource::save(const plotter::dto::ProjectDTO& projec
         // Cast to concrete SQLite DTO
         const sqlite_dtos::SqliteProjectDTO& dto = dynamic_cast<const sqlite_dtos::SqliteProjectDTO&>(projectDTO);
 
-        const char* sql = R"(
-            INSERT INTO projects (id, name, description, created_at, updated_at)
-            VALUES (?, ?, ?, ?, ?)
-            ON CONFLICT(id) DO UPDATE SET
-                name = excluded.name,
-                description = excluded.description,
-                updated_at = excluded.updated_at;
-        )";
-
-        SqliteStatement stmt(database->getHandle(), sql);
-        stmt.bindString(1, dto.id);
-        stmt.bindString(2, dto.name);
-        stmt.bindString(3, dto.description);
-        stmt.bindInt64(4, dto.createdAt);
-        stmt.bindInt64(5, dto.updatedAt);
+        SqliteStatement stmt(database->getHandle(), UPSERT.c_str());
+        schema::bindRow<ProjectTable>(stmt, dto);
 
         if (!stmt.execute()) {
             throw std::runtime_error("Failed to save project");
@@ -115,7 +121,7 @@ std::string SqliteProjectDataSource::save(const plotter::dto::ProjectDTO& projec
     }
 }
 
-std::optional<plotter::dto::ProjectDTO*> SqliteProjectDataSource::findById(const std::string& id) {
+plotter::dto::DTOPtr<plotter::dto::ProjectDTO> SqliteProjectDataSource::findById(const std::string& id) {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -123,15 +129,14 @@ std::optional<plotter::dto::ProjectDTO*> SqliteProjectDataSource::findById(const
             throw std::runtime_error("Database is not available");
         }
 
-        // Query project
-        const char* sql = "SELECT id, name, description, created_at, updated_at FROM projects WHERE id = ?;";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
+        SqliteStatement stmt(database->getHandle(), SELECT_BY_ID.c_str());
         stmt.bindString(1, id);
 
-        std::optional<plotter::dto::ProjectDTO*> result;
+        plotter::dto::DTOPtr<plotter::dto::ProjectDTO> result;
         if (stmt.step() == SQLITE_ROW) {
-            result = rowToDTO(stmt);
+            auto dto = std::make_unique<sqlite_dtos::SqliteProjectDTO>();
+            schema::readRow<ProjectTable>(stmt, *dto);
+            result = std::move(dto);
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -147,7 +152,7 @@ std::optional<plotter::dto::ProjectDTO*> SqliteProjectDataSource::findById(const
     }
 }
 
-std::vector<plotter::dto::ProjectDTO*> SqliteProjectDataSource::findAll() {
+plotter::dto::DTOList<plotter::dto::ProjectDTO> SqliteProjectDataSource::findAll() {
     auto start = std::chrono::high_resolution_clock::now();
     
     try {
@@ -155,13 +160,11 @@ std::vector<plotter::dto::ProjectDTO*> SqliteProjectDataSource::findAll() {
             throw std::runtime_error("Database is not available");
         }
 
-        const char* sql = "SELECT id, name, description, created_at, updated_at FROM projects;";
-        
-        SqliteStatement stmt(database->getHandle(), sql);
-        std::vector<plotter::dto::ProjectDTO*> projects;
+        SqliteStatement stmt(database->getHandle(), SELECT_ALL.c_str());
+        plotter::dto::DTOList<plotter::dto::ProjectDTO> projects;
 
         while (stmt.step() == SQLITE_ROW) {
-            projects.push_back(rowToDTO(stmt));
+            schema::readRow<ProjectTable>(stmt, projects.emplace_back<sqlite_dtos::SqliteProjectDTO>());
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -221,17 +224,23 @@ bool SqliteProjectDataSource::update(const plotter::dto::ProjectDTO& projectDTO)
             return false;
         }
 
-        const char* sql = R"(
-            UPDATE projects 
-            SET name = ?, description = ?, updated_at = ?
-            WHERE id = ?;
-        )";
+        // Only the changed columns are written
+        const plotter::dto::ChangeMask& changes = dto.changes;
+        std::string sql = "UPDATE projects SET ";
+        if (changes.has(plotter::dto::ChangeMask::NAME)) sql += "name = ?, ";
+        if (changes.has(plotter::dto::ChangeMask::DESCRIPTION)) sql += "description = ?, ";
+        sql += "updated_at = ? WHERE id = ?;";
 
         SqliteStatement stmt(database->getHandle(), sql);
-        stmt.bindString(1, dto.name);
-        stmt.bindString(2, dto.description);
-        stmt.bindInt64(3, dto.updatedAt);
-        stmt.bindString(4, dto.id);
+        int index = 1;
+        if (changes.has(plotter::dto::ChangeMask::NAME)) {
+            stmt.bindString(index++, dto.name);
+        }
+        if (changes.has(plotter::dto::ChangeMask::DESCRIPTION)) {
+            stmt.bindString(index++, dto.description);
+        }
+        stmt.bindInt64(index++, dto.updatedAt);
+        stmt.bindString(index++, dto.id);
 
         bool success = stmt.execute();
 
@@ -312,16 +321,6 @@ void SqliteProjectDataSource::updateMetrics(bool success, double responseTimeMs)
     metrics.lastAccessTime = std::chrono::system_clock::now();
 }
 
-sqlite_dtos::SqliteProjectDTO* SqliteProjectDataSource::rowToDTO(SqliteStatement& stmt) {
-    sqlite_dtos::SqliteProjectDTO* dto = new sqlite_dtos::SqliteProjectDTO();
-    dto->id = stmt.getColumnString(0);
-    dto->name = stmt.getColumnString(1);
-    dto->description = stmt.getColumnString(2);
-    dto->createdAt = stmt.getColumnInt64(3);
-    dto->updatedAt = stmt.getColumnInt64(4);
-    return dto;
-}
-
 std::vector<std::string> SqliteProjectDataSource::getFolderIdsByProjectId(const std::string& projectId) {
     std::vector<std::string> folderIds;
     
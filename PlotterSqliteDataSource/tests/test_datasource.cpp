@@ -2,9 +2,12 @@
 #include <cassert>
 #include <stdexcept>
 #include <memory>
+#include <set>
+#include <string>
 #include "plotter_sqlite/SqliteProjectDataSource.h"
 #include "plotter_sqlite/SqliteFolderDataSource.h"
 #include "plotter_sqlite/SqliteNoteDataSource.h"
+#include "plotter_sqlite/SqliteSchema.h"
 #include "plotter_sqlite_dtos/SqliteDTOs.h"
 
 using namespace plotter::sqlite;
@@ -65,16 +68,14 @@ TEST(test_project_datasource_save_and_find) {
     
     // Find by ID
     auto foundDto = ds.findById("proj-1");
-    assert(foundDto.has_value());
-    assert(foundDto.value() != nullptr);
+    assert(foundDto != nullptr);
     
-    auto* sqliteDto = dynamic_cast<SqliteProjectDTO*>(foundDto.value());
+    auto* sqliteDto = dynamic_cast<SqliteProjectDTO*>(foundDto.get());
     assert(sqliteDto != nullptr);
     assert(sqliteDto->id == "proj-1");
     assert(sqliteDto->name == "Test Project");
     assert(sqliteDto->description == "A test project");
     
-    delete foundDto.value();
     ds.disconnect();
 }
 
@@ -97,11 +98,45 @@ TEST(test_project_datasource_find_all) {
     auto allProjects = ds.findAll();
     assert(allProjects.size() == 3);
     
-    // Clean up
-    for (auto* dto : allProjects) {
-        delete dto;
+    ds.disconnect();
+}
+
+TEST(test_project_datasource_list_owns_dtos) {
+    SqliteProjectDataSource ds("test-db", ":memory:", 100);
+    ds.connect();
+    
+    // Enough rows to spill over several arena blocks
+    const int count = 500;
+    for (int i = 0; i < count; i++) {
+        SqliteProjectDTO dto;
+        dto.id = "proj-" + std::to_string(i);
+        dto.name = "Project with a name too long for small-string storage " + std::to_string(i);
+        dto.createdAt = 1234567890;
+        dto.updatedAt = 1234567890;
+        ds.save(dto);
     }
     
+    auto listed = ds.findAll();
+    assert(listed.size() == count);
+    std::set<std::string> ids;
+    for (plotter::dto::ProjectDTO& dto : listed) {
+        auto* sqliteDto = dynamic_cast<SqliteProjectDTO*>(&dto);
+        assert(sqliteDto != nullptr);
+        ids.insert(sqliteDto->id);
+    }
+    assert(ids.size() == count);
+    // Every row is the same concrete type, so mappers can check it once
+    assert(listed.holdsOnly<SqliteProjectDTO>());
+    assert(!listed.holdsOnly<plotter::dto::ProjectDTO>());
+    
+    // Moving the list hands over the DTOs without copying them
+    plotter::dto::ProjectDTO* first = &listed[0];
+    plotter::dto::DTOList<plotter::dto::ProjectDTO> moved = std::move(listed);
+    assert(listed.empty());
+    assert(moved.size() == count);
+    assert(&moved[0] == first);
+    assert(moved.holdsOnly<SqliteProjectDTO>());
+    
     ds.disconnect();
 }
 
@@ -125,11 +160,10 @@ TEST(test_project_datasource_update) {
     
     // Verify update
     auto found = ds.findById("proj-1");
-    auto* sqliteDto = dynamic_cast<SqliteProjectDTO*>(found.value());
+    auto* sqliteDto = dynamic_cast<SqliteProjectDTO*>(found.get());
     assert(sqliteDto->name == "Updated Name");
     assert(sqliteDto->description == "Updated Description");
     
-    delete found.value();
     ds.disconnect();
 }
 
@@ -152,7 +186,7 @@ TEST(test_project_datasource_delete) {
     
     // Verify deleted
     auto found = ds.findById("proj-1");
-    assert(!found.has_value());
+    assert(found == nullptr);
     
     ds.disconnect();
 }
@@ -230,14 +264,13 @@ TEST(test_folder_datasource_save_and_find) {
     
     // Find
     auto found = folderDs.findById("folder-1");
-    assert(found.has_value());
+    assert(found != nullptr);
     
-    auto* sqliteDto = dynamic_cast<SqliteFolderDTO*>(found.value());
+    auto* sqliteDto = dynamic_cast<SqliteFolderDTO*>(found.get());
     assert(sqliteDto->id == "folder-1");
     assert(sqliteDto->name == "Documents");
     assert(sqliteDto->parentProjectId == "proj-1");
     
-    delete found.value();
     folderDs.disconnect();
     projDs2.disconnect();
     
@@ -278,13 +311,12 @@ TEST(test_folder_datasource_with_children) {
     
     // Find - just verify folder was saved
     auto found = folderDs.findById("folder-1");
-    auto* sqliteDto = dynamic_cast<SqliteFolderDTO*>(found.value());
+    auto* sqliteDto = dynamic_cast<SqliteFolderDTO*>(found.get());
     
     // Verify basic properties (children require separate queries via junction tables)
     assert(sqliteDto->id == "folder-1");
     assert(sqliteDto->name == "Work");
     
-    delete found.value();
     folderDs.disconnect();
     projDs.disconnect();
     
@@ -292,6 +324,67 @@ TEST(test_folder_datasource_with_children) {
     std::remove("/tmp/test_folder2.db");
 }
 
+TEST(test_folder_datasource_lists_project_tree) {
+    std::remove("/tmp/test_folder_tree.db");
+    SqliteProjectDataSource projDs("proj-ds", "/tmp/test_folder_tree.db", 100);
+    projDs.connect();
+    for (const char* id : {"proj-1", "proj-2"}) {
+        SqliteProjectDTO proj;
+        proj.id = id;
+        proj.name = id;
+        projDs.save(proj);
+    }
+    
+    SqliteFolderDataSource folderDs("folder-ds", "/tmp/test_folder_tree.db", 100);
+    folderDs.connect();
+    auto saveFolder = [&](const std::string& id, const std::string& projectId, const std::string& parentId) {
+        SqliteFolderDTO dto;
+        dto.id = id;
+        dto.name = id;
+        dto.parentProjectId = projectId;
+        dto.parentFolderId = parentId;
+        folderDs.save(dto);
+    };
+    saveFolder("top", "proj-1", "");
+    saveFolder("child", "", "top");
+    saveFolder("grandchild", "", "child");
+    saveFolder("other-top", "proj-2", "");
+    saveFolder("other-child", "", "other-top");
+    
+    // One query returns the whole tree below the project, and nothing else
+    auto tree = folderDs.findAllInProject("proj-1");
+    assert(tree.has_value());
+    std::set<std::string> folderIds;
+    for (auto& folder : *tree) {
+        folderIds.insert(static_cast<SqliteFolderDTO&>(folder).id);
+    }
+    assert((folderIds == std::set<std::string>{"top", "child", "grandchild"}));
+    
+    SqliteNoteDataSource noteDs("note-ds", "/tmp/test_folder_tree.db", 100);
+    noteDs.connect();
+    for (const char* folderId : {"top", "grandchild", "other-child"}) {
+        SqliteNoteDTO dto;
+        dto.id = std::string("note-in-") + folderId;
+        dto.name = dto.id;
+        dto.path = "/" + dto.id + ".md";
+        dto.parentFolderId = folderId;
+        noteDs.save(dto);
+    }
+    
+    auto notes = noteDs.findByParentFolderIds({folderIds.begin(), folderIds.end()});
+    std::set<std::string> noteIds;
+    for (auto& note : notes) {
+        noteIds.insert(static_cast<SqliteNoteDTO&>(note).id);
+    }
+    assert((noteIds == std::set<std::string>{"note-in-top", "note-in-grandchild"}));
+    assert(noteDs.findByParentFolderIds({}).empty());
+    
+    noteDs.disconnect();
+    folderDs.disconnect();
+    projDs.disconnect();
+    std::remove("/tmp/test_folder_tree.db");
+}
+
 // ============================================================================
 // SqliteNoteDataSource Tests
 // ============================================================================
@@ -341,14 +434,13 @@ TEST(test_note_datasource_save_and_find) {
     
     // Find
     auto found = noteDs.findById("note-1");
-    assert(found.has_value());
+    assert(found != nullptr);
     
-    auto* sqliteDto = dynamic_cast<SqliteNoteDTO*>(found.value());
+    auto* sqliteDto = dynamic_cast<SqliteNoteDTO*>(found.get());
     assert(sqliteDto->id == "note-1");
     assert(sqliteDto->name == "Meeting Notes");
     assert(sqliteDto->content == "Today we discussed...");
     
-    delete found.value();
     noteDs.disconnect();
     folderDs.disconnect();
     projDs.disconnect();
@@ -402,10 +494,9 @@ TEST(test_note_datasource_update_content) {
     
     // Verify
     auto found = noteDs.findById("note-1");
-    auto* sqliteDto = dynamic_cast<SqliteNoteDTO*>(found.value());
+    auto* sqliteDto = dynamic_cast<SqliteNoteDTO*>(found.get());
     assert(sqliteDto->content == "Updated content");
     
-    delete found.value();
     noteDs.disconnect();
     folderDs.disconnect();
     projDs.disconnect();
@@ -413,6 +504,272 @@ TEST(test_note_datasource_update_content) {
     std::remove("/tmp/test_note2.db");
 }
 
+TEST(test_note_datasource_listing_skips_content) {
+    SqliteProjectDataSource projDs("proj-ds", "/tmp/test_note3.db", 100);
+    projDs.connect();
+    SqliteProjectDTO proj;
+    proj.id = "proj-1";
+    proj.name = "Test Project";
+    projDs.save(proj);
+    
+    SqliteFolderDataSource folderDs("folder-ds", "/tmp/test_note3.db", 100);
+    folderDs.connect();
+    SqliteFolderDTO folder;
+    folder.id = "folder-1";
+    folder.name = "Folder";
+    folder.parentProjectId = "proj-1";
+    folderDs.save(folder);
+    
+    SqliteNoteDataSource noteDs("note-ds", "/tmp/test_note3.db", 100);
+    noteDs.connect();
+    SqliteNoteDTO dto;
+    dto.id = "note-1";
+    dto.name = "Listed";
+    dto.path = "/notes/listed.md";
+    dto.content = "Large content";
+    dto.parentFolderId = "folder-1";
+    noteDs.save(dto);
+    
+    // Listings leave the content to the loader
+    auto listed = noteDs.findByParentFolderId("folder-1");
+    assert(listed.size() == 1);
+    auto* listedDto = dynamic_cast<SqliteNoteDTO*>(&listed[0]);
+    assert(!listedDto->contentLoaded);
+    assert(listedDto->content.empty());
+    assert(listedDto->contentLoader() == "Large content");
+    
+    // Writing back a DTO without content keeps the stored content
+    listedDto->name = "Renamed";
+    assert(noteDs.update(*listedDto));
+    noteDs.save(*listedDto);
+    auto found = noteDs.findById("note-1");
+    auto* foundDto = dynamic_cast<SqliteNoteDTO*>(found.get());
+    assert(foundDto->contentLoaded);
+    assert(foundDto->name == "Renamed");
+    assert(foundDto->content == "Large content");
+    
+    // Search still matches on content
+    auto matches = noteDs.search("Large");
+    assert(matches.size() == 1);
+    
+    // A loader used after the connection is closed reports the failure
+    noteDs.disconnect();
+    bool threw = false;
+    try {
+        listedDto->contentLoader();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    folderDs.disconnect();
+    projDs.disconnect();
+    
+    std::remove("/tmp/test_note3.db");
+}
+
+TEST(test_note_datasource_streams_rows) {
+    std::remove("/tmp/test_note_stream.db");
+    SqliteProjectDataSource projDs("proj-ds", "/tmp/test_note_stream.db", 100);
+    projDs.connect();
+    SqliteProjectDTO proj;
+    proj.id = "proj-1";
+    proj.name = "Test Project";
+    projDs.save(proj);
+    
+    SqliteFolderDataSource folderDs("folder-ds", "/tmp/test_note_stream.db", 100);
+    folderDs.connect();
+    SqliteFolderDTO folder;
+    folder.id = "folder-1";
+    folder.name = "Folder";
+    folder.parentProjectId = "proj-1";
+    folderDs.save(folder);
+    
+    SqliteNoteDataSource noteDs("note-ds", "/tmp/test_note_stream.db", 100);
+    noteDs.connect();
+    const int count = 50;
+    for (int i = 0; i < count; i++) {
+        SqliteNoteDTO dto;
+        dto.id = "note-" + std::to_string(i);
+        dto.name = "Streamed " + std::to_string(i);
+        dto.path = "/notes/" + std::to_string(i) + ".md";
+        dto.content = i % 2 == 0 ? "even" : "odd";
+        dto.parentFolderId = i < 10 ? "folder-1" : "";
+        noteDs.save(dto);
+    }
+    
+    // Every row comes through the same DTO, refilled on each step
+    auto cursor = noteDs.streamAll();
+    std::set<std::string> ids;
+    plotter::dto::NoteDTO* first = nullptr;
+    while (plotter::dto::NoteDTO* row = cursor->next()) {
+        if (!first) {
+            first = row;
+        }
+        assert(row == first);
+        auto* sqliteDto = dynamic_cast<SqliteNoteDTO*>(row);
+        assert(sqliteDto != nullptr);
+        assert(!sqliteDto->contentLoaded);
+        ids.insert(sqliteDto->id);
+        if (sqliteDto->id == "note-3") {
+            assert(sqliteDto->contentLoader() == "odd");
+        }
+    }
+    assert(ids.size() == count);
+    assert(cursor->next() == nullptr);
+    
+    int inFolder = 0;
+    auto byFolder = noteDs.streamByParentFolderId("folder-1");
+    while (byFolder->next()) {
+        inFolder++;
+    }
+    assert(inFolder == 10);
+    
+    int matched = 0;
+    auto matches = noteDs.streamSearch("even");
+    while (matches->next()) {
+        matched++;
+    }
+    assert(matched == count / 2);
+    
+    // A cursor left open across a disconnect fails instead of reading a closed handle
+    auto open = noteDs.streamAll();
+    assert(open->next() != nullptr);
+    noteDs.disconnect();
+    bool threw = false;
+    try {
+        open->next();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    open.reset();
+    folderDs.disconnect();
+    projDs.disconnect();
+    
+    std::remove("/tmp/test_note_stream.db");
+}
+
+TEST(test_partial_updates_write_only_changed_fields) {
+    SqliteProjectDataSource projDs("proj-ds", "/tmp/test_partial.db", 100);
+    projDs.connect();
+    SqliteProjectDTO proj;
+    proj.id = "proj-1";
+    proj.name = "Project";
+    proj.description = "Kept description";
+    projDs.save(proj);
+    
+    SqliteFolderDataSource folderDs("folder-ds", "/tmp/test_partial.db", 100);
+    folderDs.connect();
+    SqliteFolderDTO folder;
+    folder.id = "folder-1";
+    folder.name = "Folder";
+    folder.parentProjectId = "proj-1";
+    folderDs.save(folder);
+    
+    SqliteNoteDataSource noteDs("note-ds", "/tmp/test_partial.db", 100);
+    noteDs.connect();
+    SqliteNoteDTO note;
+    note.id = "note-1";
+    note.name = "Note";
+    note.path = "/notes/note.md";
+    note.content = "Stored content";
+    note.parentFolderId = "folder-1";
+    noteDs.save(note);
+    
+    // A rename carries stale values in the other fields; only the name is written
+    note.name = "Renamed";
+    note.content = "stale";
+    note.path = "/stale.md";
+    note.parentFolderId = "";
+    note.changes = plotter::dto::ChangeMask(plotter::dto::ChangeMask::NAME);
+    assert(noteDs.update(note));
+    auto found = noteDs.findById("note-1");
+    auto* stored = dynamic_cast<SqliteNoteDTO*>(found.get());
+    assert(stored->name == "Renamed");
+    assert(stored->content == "Stored content");
+    assert(stored->path == "/notes/note.md");
+    assert(stored->parentFolderId == "folder-1");
+    
+    proj.name = "Renamed project";
+    proj.description = "";
+    proj.changes = plotter::dto::ChangeMask(plotter::dto::ChangeMask::NAME);
+    assert(projDs.update(proj));
+    auto foundProject = projDs.findById("proj-1");
+    auto* storedProject = dynamic_cast<SqliteProjectDTO*>(foundProject.get());
+    assert(storedProject->name == "Renamed project");
+    assert(storedProject->description == "Kept description");
+    
+    folder.description = "Described";
+    folder.parentProjectId = "";
+    folder.changes = plotter::dto::ChangeMask(plotter::dto::ChangeMask::DESCRIPTION);
+    assert(folderDs.update(folder));
+    auto foundFolder = folderDs.findById("folder-1");
+    auto* storedFolder = dynamic_cast<SqliteFolderDTO*>(foundFolder.get());
+    assert(storedFolder->description == "Described");
+    assert(storedFolder->parentProjectId == "proj-1");
+    
+    noteDs.disconnect();
+    folderDs.disconnect();
+    projDs.disconnect();
+    std::remove("/tmp/test_partial.db");
+}
+
+// ============================================================================
+// Schema Descriptor Tests
+// ============================================================================
+
+TEST(test_schema_generates_sql) {
+    constexpr auto select = schema::concat("SELECT ", schema::columnNames<schema::NoteListing>, " FROM notes;");
+    static_assert(select.size() == std::char_traits<char>::length(select.c_str()), "no stray NULs");
+    assert(std::string(select.c_str()) ==
+           "SELECT id, name, path, parent_folder_id, created_at, updated_at FROM notes;");
+    assert(std::string(schema::placeholders<schema::FolderTable>.c_str()) == "?, ?, ?, ?, ?, ?, ?");
+}
+
+TEST(test_schema_binds_and_reads_rows) {
+    SqliteDatabase database(":memory:");
+    database.connect();
+    
+    SqliteProjectDTO project;
+    project.id = "proj-1";
+    project.name = "Project";
+    SqliteStatement insertProject(database.getHandle(),
+        schema::concat("INSERT INTO projects (", schema::columnNames<schema::ProjectTable>,
+                       ") VALUES (", schema::placeholders<schema::ProjectTable>, ");").c_str());
+    assert(schema::bindRow<schema::ProjectTable>(insertProject, project) == 6);
+    assert(insertProject.execute());
+    
+    // Column order is the descriptor's, and empty parents go in as NULL
+    constexpr auto insert = schema::concat("INSERT INTO folders (", schema::columnNames<schema::FolderTable>,
+                                           ") VALUES (", schema::placeholders<schema::FolderTable>, ");");
+    SqliteFolderDTO folder;
+    folder.id = "folder-1";
+    folder.name = "Folder";
+    folder.parentProjectId = "proj-1";
+    folder.createdAt = 11;
+    folder.updatedAt = 22;
+    SqliteStatement insertFolder(database.getHandle(), insert.c_str());
+    schema::bindRow<schema::FolderTable>(insertFolder, folder);
+    assert(insertFolder.execute());
+    
+    SqliteStatement nullCheck(database.getHandle(), "SELECT parent_folder_id IS NULL FROM folders;");
+    assert(nullCheck.step() == SQLITE_ROW);
+    assert(nullCheck.getColumnInt(0) == 1);
+    
+    SqliteStatement select(database.getHandle(),
+        schema::concat("SELECT ", schema::columnNames<schema::FolderTable>, " FROM folders;").c_str());
+    assert(select.step() == SQLITE_ROW);
+    SqliteFolderDTO read;
+    schema::readRow<schema::FolderTable>(select, read);
+    assert(read.id == "folder-1");
+    assert(read.parentProjectId == "proj-1");
+    assert(read.parentFolderId.empty());
+    assert(read.createdAt == 11);
+    assert(read.updatedAt == 22);
+    
+    database.disconnect();
+}
+
 // ============================================================================
 // Health Check and Metrics Tests
 // ============================================================================
@@ -462,6 +819,7 @@ int main() {
     run_test_project_datasource_connect();
     run_test_project_datasource_save_and_find();
     run_test_project_datasource_find_all();
+    run_test_project_datasource_list_owns_dtos();
     run_test_project_datasource_update();
     run_test_project_datasource_delete();
     run_test_project_datasource_exists();
@@ -470,11 +828,20 @@ int main() {
     std::cout << "\n--- SqliteFolderDataSource Tests ---" << std::endl;
     run_test_folder_datasource_save_and_find();
     run_test_folder_datasource_with_children();
+    run_test_folder_datasource_lists_project_tree();
     
     // Note datasource tests
     std::cout << "\n--- SqliteNoteDataSource Tests ---" << std::endl;
     run_test_note_datasource_save_and_find();
     run_test_note_datasource_update_content();
+    run_test_note_datasource_listing_skips_content();
+    run_test_note_datasource_streams_rows();
+    run_test_partial_updates_write_only_changed_fields();
+    
+    // Schema descriptor tests
+    std::cout << "\n--- Schema Descriptor Tests ---" << std::endl;
+    run_test_schema_generates_sql();
+    run_test_schema_binds_and_reads_rows();
     
     // Health and metrics tests
     std::cout << "\n--- Health and Metrics Tests ---" << std::endl;
@@ -37,6 +37,16 @@ public:
      * @return Domain entity
      */
     Project toEntity(const dto::ProjectDTO& dto) override;
+    Project toEntity(dto::ProjectDTO&& dto) override;
+    
+    /**
+     * @brief Convert a list of SqliteProjectDTOs to Project entities
+     * 
+     * The DTO type is checked once for the whole list; a list of mixed
+     * types falls back to checking each DTO.
+     */
+    std::vector<Project> toEntities(dto::DTOList<dto::ProjectDTO>&& dtos) override;
+    dto::DTOList<dto::ProjectDTO> toDTOs(const std::vector<Project>& entities) override;
 };
 
 /**
@@ -48,6 +58,9 @@ class SqliteFolderMapper : public repositories::FolderDTOMapper {
 public:
     dto::FolderDTO* toDTO(const Folder& entity) override;
     Folder toEntity(const dto::FolderDTO& dto) override;
+    Folder toEntity(dto::FolderDTO&& dto) override;
+    std::vector<Folder> toEntities(dto::DTOList<dto::FolderDTO>&& dtos) override;
+    dto::DTOList<dto::FolderDTO> toDTOs(const std::vector<Folder>& entities) override;
 };
 
 /**
@@ -59,6 +72,9 @@ class SqliteNoteMapper : public repositories::NoteDTOMapper {
 public:
     dto::NoteDTO* toDTO(const Note& entity) override;
     Note toEntity(const dto::NoteDTO& dto) override;
+    Note toEntity(dto::NoteDTO&& dto) override;
+    std::vector<Note> toEntities(dto::DTOList<dto::NoteDTO>&& dtos) override;
+    dto::DTOList<dto::NoteDTO> toDTOs(const std::vector<Note>& entities) override;
 };
 
 } // namespace sqlite_mappers
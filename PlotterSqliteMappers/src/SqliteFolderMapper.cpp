@@ -2,23 +2,55 @@
 #include "plotter_sqlite_dtos/SqliteDTOs.h"
 // Use real entities instead of stubs
 #include "Folder.h"
+#include <utility>
 
 namespace plotter {
 namespace sqlite_mappers {
 
+namespace {
+
+// Builds the entity from a const DTO (copying its strings) or from an
+// expiring one (moving them): std::forward keeps the DTO's value category
+// for each member it is applied to
+template<typename Dto>
+Folder buildFolder(Dto&& dto) {
+    Folder folder(std::forward<Dto>(dto).id, std::forward<Dto>(dto).name, std::forward<Dto>(dto).description,
+                  dto.parentProjectId, dto.parentFolderId);
+
+    // Add note IDs from DTO
+    for (const auto& noteId : dto.noteIds) {
+        folder.addNoteId(noteId);
+    }
+
+    // Add subfolder IDs from DTO
+    for (const auto& subfolderId : dto.subfolderIds) {
+        folder.addSubfolderId(subfolderId);
+    }
+
+    folder.clearDirtyFields();  // Loaded state matches the store
+    return folder;
+}
+
+void fillFolder(const Folder& entity, sqlite_dtos::SqliteFolderDTO& dto, long long now) {
+    dto.id = entity.getId();
+    dto.name = entity.getName();
+    dto.description = entity.getDescription();
+    dto.parentProjectId = entity.getParentProjectId();
+    dto.parentFolderId = entity.getParentFolderId();
+    dto.noteIds.assign(entity.getNoteIds().begin(), entity.getNoteIds().end());
+    dto.subfolderIds.assign(entity.getSubfolderIds().begin(), entity.getSubfolderIds().end());
+    dto.createdAt = now;
+    dto.updatedAt = now;
+    dto.changes = repositories::changeMaskOf(entity.getDirtyFields());
+}
+
+} // namespace
+
 // ================ SqliteFolderMapper ================
 
 dto::FolderDTO* SqliteFolderMapper::toDTO(const Folder& entity) {
     auto* dto = new sqlite_dtos::SqliteFolderDTO();
-    dto->id = entity.getId();
-    dto->name = entity.getName();
-    dto->description = entity.getDescription();
-    dto->parentProjectId = entity.getParentProjectId();
-    dto->parentFolderId = entity.getParentFolderId();
-    dto->noteIds = entity.getNoteIds();
-    dto->subfolderIds = entity.getSubfolderIds();
-    dto->createdAt = sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp();
-    dto->updatedAt = sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp();
+    fillFolder(entity, *dto, sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp());
     return dto;
 }
 
@@ -28,21 +60,37 @@ Folder SqliteFolderMapper::toEntity(const dto::FolderDTO& dto) {
     if (!sqliteDto) {
         throw std::runtime_error("SqliteFolderMapper::toEntity - DTO is not a SqliteFolderDTO");
     }
-    
-    Folder folder(sqliteDto->id, sqliteDto->name, sqliteDto->description,
-                  sqliteDto->parentProjectId, sqliteDto->parentFolderId);
-    
-    // Add note IDs from DTO
-    for (const auto& noteId : sqliteDto->noteIds) {
-        folder.addNoteId(noteId);
+    return buildFolder(*sqliteDto);
+}
+
+Folder SqliteFolderMapper::toEntity(dto::FolderDTO&& dto) {
+    auto* sqliteDto = dynamic_cast<sqlite_dtos::SqliteFolderDTO*>(&dto);
+    if (!sqliteDto) {
+        throw std::runtime_error("SqliteFolderMapper::toEntity - DTO is not a SqliteFolderDTO");
     }
-    
-    // Add subfolder IDs from DTO
-    for (const auto& subfolderId : sqliteDto->subfolderIds) {
-        folder.addSubfolderId(subfolderId);
+    return buildFolder(std::move(*sqliteDto));
+}
+
+std::vector<Folder> SqliteFolderMapper::toEntities(dto::DTOList<dto::FolderDTO>&& dtos) {
+    if (!dtos.holdsOnly<sqlite_dtos::SqliteFolderDTO>()) {
+        return FolderDTOMapper::toEntities(std::move(dtos));  // Checks each DTO
     }
-    
-    return folder;
+    std::vector<Folder> folders;
+    folders.reserve(dtos.size());
+    for (dto::FolderDTO& listed : dtos) {
+        folders.push_back(buildFolder(static_cast<sqlite_dtos::SqliteFolderDTO&&>(listed)));
+    }
+    return folders;
+}
+
+dto::DTOList<dto::FolderDTO> SqliteFolderMapper::toDTOs(const std::vector<Folder>& entities) {
+    dto::DTOList<dto::FolderDTO> dtos;
+    dtos.reserve(entities.size());
+    long long now = sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp();
+    for (const Folder& entity : entities) {
+        fillFolder(entity, dtos.emplace_back<sqlite_dtos::SqliteFolderDTO>(), now);
+    }
+    return dtos;
 }
 
 } // namespace sqlite_mappers
@@ -2,20 +2,50 @@
 #include "plotter_sqlite_dtos/SqliteDTOs.h"
 // Use real entities instead of stubs
 #include "Note.h"
+#include <utility>
 
 namespace plotter {
 namespace sqlite_mappers {
 
+namespace {
+
+// Builds the entity from a const DTO (copying its strings) or from an
+// expiring one (moving them): std::forward keeps the DTO's value category
+// for each member it is applied to
+template<typename Dto>
+Note buildNote(Dto&& dto) {
+    Note note(std::forward<Dto>(dto).id, std::forward<Dto>(dto).name, std::forward<Dto>(dto).path, dto.parentFolderId);
+    if (dto.contentLoaded) {
+        note.setContent(std::forward<Dto>(dto).content);
+    } else if (dto.contentLoader) {
+        note.setContentLoader(std::forward<Dto>(dto).contentLoader);
+    }
+    note.clearDirtyFields();  // Loaded state matches the store
+    return note;
+}
+
+void fillNote(const Note& entity, sqlite_dtos::SqliteNoteDTO& dto, long long now) {
+    dto.id = entity.getId();
+    dto.name = entity.getName();
+    dto.path = entity.getPath();
+    dto.parentFolderId = entity.getParentFolderId();
+    // Content that was never read is left out, so saving keeps the stored copy
+    dto.contentLoaded = entity.isContentLoaded();
+    if (dto.contentLoaded) {
+        dto.content = entity.getContent();
+    }
+    dto.createdAt = now;
+    dto.updatedAt = now;
+    dto.changes = repositories::changeMaskOf(entity.getDirtyFields());
+}
+
+} // namespace
+
 // ================ SqliteNoteMapper ================
 
 dto::NoteDTO* SqliteNoteMapper::toDTO(const Note& entity) {
     auto* dto = new sqlite_dtos::SqliteNoteDTO();
-    dto->id = entity.getId();
-    dto->name = entity.getName();
-    dto->path = entity.getPath();
-    dto->parentFolderId = entity.getParentFolderId();
-    dto->createdAt = sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp();
-    dto->updatedAt = sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp();
+    fillNote(entity, *dto, sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp());
     return dto;
 }
 
@@ -25,9 +55,37 @@ Note SqliteNoteMapper::toEntity(const dto::NoteDTO& dto) {
     if (!sqliteDto) {
         throw std::runtime_error("SqliteNoteMapper::toEntity - DTO is not a SqliteNoteDTO");
     }
-    
-    Note note(sqliteDto->id, sqliteDto->name, sqliteDto->path, sqliteDto->parentFolderId);
-    return note;
+    return buildNote(*sqliteDto);
+}
+
+Note SqliteNoteMapper::toEntity(dto::NoteDTO&& dto) {
+    auto* sqliteDto = dynamic_cast<sqlite_dtos::SqliteNoteDTO*>(&dto);
+    if (!sqliteDto) {
+        throw std::runtime_error("SqliteNoteMapper::toEntity - DTO is not a SqliteNoteDTO");
+    }
+    return buildNote(std::move(*sqliteDto));
+}
+
+std::vector<Note> SqliteNoteMapper::toEntities(dto::DTOList<dto::NoteDTO>&& dtos) {
+    if (!dtos.holdsOnly<sqlite_dtos::SqliteNoteDTO>()) {
+        return NoteDTOMapper::toEntities(std::move(dtos));  // Checks each DTO
+    }
+    std::vector<Note> notes;
+    notes.reserve(dtos.size());
+    for (dto::NoteDTO& listed : dtos) {
+        notes.push_back(buildNote(static_cast<sqlite_dtos::SqliteNoteDTO&&>(listed)));
+    }
+    return notes;
+}
+
+dto::DTOList<dto::NoteDTO> SqliteNoteMapper::toDTOs(const std::vector<Note>& entities) {
+    dto::DTOList<dto::NoteDTO> dtos;
+    dtos.reserve(entities.size());
+    long long now = sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp();
+    for (const Note& entity : entities) {
+        fillNote(entity, dtos.emplace_back<sqlite_dtos::SqliteNoteDTO>(), now);
+    }
+    return dtos;
 }
 
 } // namespace sqlite_mappers
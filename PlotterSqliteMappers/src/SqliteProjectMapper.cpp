@@ -2,20 +2,46 @@
 #include "plotter_sqlite_dtos/SqliteDTOs.h"
 // Use real entities instead of stubs
 #include "Project.h"
+#include <utility>
 
 namespace plotter {
 namespace sqlite_mappers {
 
+namespace {
+
+// Builds the entity from a const DTO (copying its strings) or from an
+// expiring one (moving them): std::forward keeps the DTO's value category
+// for each member it is applied to
+template<typename Dto>
+Project buildProject(Dto&& dto) {
+    Project project(std::forward<Dto>(dto).id, std::forward<Dto>(dto).name, std::forward<Dto>(dto).description);
+
+    // Add folder IDs from DTO
+    for (const auto& folderId : dto.folderIds) {
+        project.addFolderId(folderId);
+    }
+
+    project.clearDirtyFields();  // Loaded state matches the store
+    return project;
+}
+
+void fillProject(const Project& entity, sqlite_dtos::SqliteProjectDTO& dto, long long now) {
+    dto.id = entity.getId();
+    dto.name = entity.getName();
+    dto.description = entity.getDescription();
+    dto.folderIds.assign(entity.getFolderIds().begin(), entity.getFolderIds().end());
+    dto.createdAt = now;
+    dto.updatedAt = now;
+    dto.changes = repositories::changeMaskOf(entity.getDirtyFields());
+}
+
+} // namespace
+
 // ================ SqliteProjectMapper ================
 
 dto::ProjectDTO* SqliteProjectMapper::toDTO(const Project& entity) {
     auto* dto = new sqlite_dtos::SqliteProjectDTO();
-    dto->id = entity.getId();
-    dto->name = entity.getName();
-    dto->description = entity.getDescription();
-    dto->folderIds = entity.getFolderIds();
-    dto->createdAt = sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp();
-    dto->updatedAt = sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp();
+    fillProject(entity, *dto, sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp());
     return dto;
 }
 
@@ -25,15 +51,37 @@ Project SqliteProjectMapper::toEntity(const dto::ProjectDTO& dto) {
     if (!sqliteDto) {
         throw std::runtime_error("SqliteProjectMapper::toEntity - DTO is not a SqliteProjectDTO");
     }
-    
-    Project project(sqliteDto->id, sqliteDto->name, sqliteDto->description);
-    
-    // Add folder IDs from DTO
-    for (const auto& folderId : sqliteDto->folderIds) {
-        project.addFolderId(folderId);
+    return buildProject(*sqliteDto);
+}
+
+Project SqliteProjectMapper::toEntity(dto::ProjectDTO&& dto) {
+    auto* sqliteDto = dynamic_cast<sqlite_dtos::SqliteProjectDTO*>(&dto);
+    if (!sqliteDto) {
+        throw std::runtime_error("SqliteProjectMapper::toEntity - DTO is not a SqliteProjectDTO");
     }
-    
-    return project;
+    return buildProject(std::move(*sqliteDto));
+}
+
+std::vector<Project> SqliteProjectMapper::toEntities(dto::DTOList<dto::ProjectDTO>&& dtos) {
+    if (!dtos.holdsOnly<sqlite_dtos::SqliteProjectDTO>()) {
+        return ProjectDTOMapper::toEntities(std::move(dtos));  // Checks each DTO
+    }
+    std::vector<Project> projects;
+    projects.reserve(dtos.size());
+    for (dto::ProjectDTO& listed : dtos) {
+        projects.push_back(buildProject(static_cast<sqlite_dtos::SqliteProjectDTO&&>(listed)));
+    }
+    return projects;
+}
+
+dto::DTOList<dto::ProjectDTO> SqliteProjectMapper::toDTOs(const std::vector<Project>& entities) {
+    dto::DTOList<dto::ProjectDTO> dtos;
+    dtos.reserve(entities.size());
+    long long now = sqlite_dtos::SqliteDTOUtils::getCurrentTimestamp();
+    for (const Project& entity : entities) {
+        fillProject(entity, dtos.emplace_back<sqlite_dtos::SqliteProjectDTO>(), now);
+    }
+    return dtos;
 }
 
 } // namespace sqlite_mappers
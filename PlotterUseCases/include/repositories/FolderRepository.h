@@ -3,7 +3,10 @@
 
 #include "Folder.h"
 #include <memory>
+#include <iterator>
 #include <optional>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 /**
@@ -57,6 +60,31 @@ public:
      */
     virtual std::vector<Folder> findByParentFolderId(const std::string& parentFolderId) = 0;
     
+    /**
+     * @brief Find every folder of a project, at any depth
+     * 
+     * The default walks the tree level by level, with one
+     * findByParentFolderId() per folder. Repositories whose storage can
+     * list a whole tree in one query override it.
+     * 
+     * @param projectId The ID of the project
+     * @return A vector containing the project's folders, in no particular order
+     */
+    virtual std::vector<Folder> findAllInProject(const std::string& projectId) {
+        std::vector<Folder> folders = findByParentProjectId(projectId);
+        std::unordered_set<std::string> listed;
+        for (size_t next = 0; next < folders.size(); next++) {
+            std::string folderId = folders[next].getId();
+            if (!listed.insert(folderId).second) {
+                continue;
+            }
+            std::vector<Folder> subfolders = findByParentFolderId(folderId);
+            folders.insert(folders.end(), std::make_move_iterator(subfolders.begin()),
+                           std::make_move_iterator(subfolders.end()));
+        }
+        return folders;
+    }
+    
     /**
      * @brief Delete a folder by its ID
      * 
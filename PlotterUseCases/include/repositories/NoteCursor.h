@@ -0,0 +1,48 @@
+#ifndef NOTECURSOR_H
+#define NOTECURSOR_H
+
+#include "Note.h"
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Pull-based sequence of notes
+ * 
+ * Yields notes one at a time, so jobs such as exports or statistics can go
+ * through any number of notes while holding only the current one.
+ */
+class NoteCursor {
+public:
+    virtual ~NoteCursor() = default;
+    
+    /**
+     * @brief Get the next note
+     * 
+     * @return The next note, or std::nullopt once the cursor is exhausted
+     * @throws std::runtime_error if the notes cannot be read
+     */
+    virtual std::optional<Note> next() = 0;
+};
+
+/**
+ * @brief Cursor over notes that are already in memory
+ */
+class VectorNoteCursor : public NoteCursor {
+public:
+    explicit VectorNoteCursor(std::vector<Note> notes) : notes(std::move(notes)) {}
+    
+    std::optional<Note> next() override {
+        if (position == notes.size()) {
+            return std::nullopt;
+        }
+        return std::move(notes[position++]);
+    }
+    
+private:
+    std::vector<Note> notes;
+    size_t position = 0;
+};
+
+#endif // NOTECURSOR_H
@@ -2,8 +2,11 @@
 #define NOTEREPOSITORY_H
 
 #include "Note.h"
+#include "NoteCursor.h"
+#include <iterator>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 /**
@@ -49,6 +52,24 @@ public:
      */
     virtual std::vector<Note> findByParentFolderId(const std::string& parentFolderId) = 0;
     
+    /**
+     * @brief Find the notes of several folders at once
+     * 
+     * The default issues one findByParentFolderId() per folder.
+     * 
+     * @param parentFolderIds The IDs of the parent folders
+     * @return A vector containing the notes of all those folders
+     */
+    virtual std::vector<Note> findByParentFolderIds(const std::vector<std::string>& parentFolderIds) {
+        std::vector<Note> notes;
+        for (const auto& parentFolderId : parentFolderIds) {
+            std::vector<Note> folderNotes = findByParentFolderId(parentFolderId);
+            notes.insert(notes.end(), std::make_move_iterator(folderNotes.begin()),
+                         std::make_move_iterator(folderNotes.end()));
+        }
+        return notes;
+    }
+    
     /**
      * @brief Search notes by name or content
      * 
@@ -57,6 +78,39 @@ public:
      */
     virtual std::vector<Note> search(const std::string& searchTerm) = 0;
     
+    /**
+     * @brief Go through all notes one at a time
+     * 
+     * Yields the same notes as findAll(). The default reads them all up
+     * front; repositories backed by a data source that can read row by row
+     * override it to keep memory use flat.
+     * 
+     * @return A cursor over all notes
+     */
+    virtual std::unique_ptr<NoteCursor> streamAll() {
+        return std::make_unique<VectorNoteCursor>(findAll());
+    }
+    
+    /**
+     * @brief Go through the notes of a folder one at a time
+     * 
+     * @param parentFolderId The ID of the parent folder
+     * @return A cursor over the same notes as findByParentFolderId()
+     */
+    virtual std::unique_ptr<NoteCursor> streamByParentFolderId(const std::string& parentFolderId) {
+        return std::make_unique<VectorNoteCursor>(findByParentFolderId(parentFolderId));
+    }
+    
+    /**
+     * @brief Go through the notes matching a search one at a time
+     * 
+     * @param searchTerm The term to search for in note names or content
+     * @return A cursor over the same notes as search()
+     */
+    virtual std::unique_ptr<NoteCursor> streamSearch(const std::string& searchTerm) {
+        return std::make_unique<VectorNoteCursor>(search(searchTerm));
+    }
+    
     /**
      * @brief Delete a note by its ID
      * 
@@ -0,0 +1,78 @@
+#ifndef LOADPROJECTSNAPSHOTUSECASE_H
+#define LOADPROJECTSNAPSHOTUSECASE_H
+
+#include "repositories/ProjectRepository.h"
+#include "repositories/FolderRepository.h"
+#include "repositories/NoteRepository.h"
+#include "ProjectSnapshot.h"
+#include <memory>
+#include <optional>
+#include <string>
+
+/**
+ * @brief Use case for loading a whole project tree into a ProjectSnapshot
+ * 
+ * Meant for read-only traversals (statistics, export, tree rendering): the
+ * hierarchy is fetched with two bulk listings, FolderRepository::findAllInProject()
+ * and NoteRepository::findByParentFolderIds(), instead of a findById per node,
+ * and every later ancestor, descendant or child query is answered by the
+ * snapshot without touching the repositories. Against SQLite that is one
+ * recursive query for the folders and one for the notes; repositories without
+ * a bulk listing fall back to one listing per folder. Note content is not read.
+ */
+class LoadProjectSnapshotUseCase {
+public:
+    /**
+     * @brief Request DTO for loading a project snapshot
+     */
+    struct Request {
+        std::string projectId;
+    };
+
+    /**
+     * @brief Response DTO for snapshot loading
+     */
+    struct Response {
+        std::optional<ProjectSnapshot> snapshot;
+        bool success;
+        std::string errorMessage;
+    };
+
+private:
+    std::shared_ptr<ProjectRepository> projectRepository;
+    std::shared_ptr<FolderRepository> folderRepository;
+    std::shared_ptr<NoteRepository> noteRepository;
+
+public:
+    /**
+     * @brief Constructor
+     * 
+     * @param projectRepo The project repository
+     * @param folderRepo The folder repository
+     * @param noteRepo The note repository
+     */
+    LoadProjectSnapshotUseCase(
+        std::shared_ptr<ProjectRepository> projectRepo,
+        std::shared_ptr<FolderRepository> folderRepo,
+        std::shared_ptr<NoteRepository> noteRepo
+    );
+
+    /**
+     * @brief Execute the use case
+     * 
+     * @param request The request containing the project ID
+     * @return Response containing the snapshot or an error
+     */
+    Response execute(const Request& request);
+
+private:
+    /**
+     * @brief Validate the request
+     * 
+     * @param request The request to validate
+     * @return Error message if validation fails, empty string if valid
+     */
+    std::string validateRequest(const Request& request);
+};
+
+#endif // LOADPROJECTSNAPSHOTUSECASE_H
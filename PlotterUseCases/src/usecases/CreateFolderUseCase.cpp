@@ -1,6 +1,6 @@
 #include "usecases/CreateFolderUseCase.h"
 #include "Folder.h"
-#include <chrono>
+#include "IdGenerator.h"
 #include <stdexcept>
 
 CreateFolderUseCase::CreateFolderUseCase(
@@ -68,10 +68,7 @@ CreateFolderUseCase::Response CreateFolderUseCase::execute(const Request& reques
 }
 
 std::string CreateFolderUseCase::generateFolderId() {
-    // In a real system, you'd use a UUID library or proper ID generation service
-    auto now = std::chrono::system_clock::now().time_since_epoch();
-    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
-    return "folder_" + std::to_string(millis);
+    return "folder_" + IdGenerator::next();
 }
 
 std::string CreateFolderUseCase::validateRequest(const Request& request) {
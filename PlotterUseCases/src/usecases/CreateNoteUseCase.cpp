@@ -1,6 +1,6 @@
 #include "usecases/CreateNoteUseCase.h"
 #include "Note.h"
-#include <chrono>
+#include "IdGenerator.h"
 #include <stdexcept>
 #include <algorithm>
 
@@ -64,10 +64,7 @@ CreateNoteUseCase::Response CreateNoteUseCase::execute(const Request& request) {
 }
 
 std::string CreateNoteUseCase::generateNoteId() {
-    // In a real system, you'd use a UUID library or proper ID generation service
-    auto now = std::chrono::system_clock::now().time_since_epoch();
-    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
-    return "note_" + std::to_string(millis);
+    return "note_" + IdGenerator::next();
 }
 
 std::string CreateNoteUseCase::generateNotePath(const std::string& noteId, const std::string& noteName) {
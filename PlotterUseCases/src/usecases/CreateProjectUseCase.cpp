@@ -1,6 +1,6 @@
 #include "usecases/CreateProjectUseCase.h"
 #include "Project.h"
-#include <chrono>
+#include "IdGenerator.h"
 #include <stdexcept>
 
 CreateProjectUseCase::CreateProjectUseCase(
@@ -84,10 +84,7 @@ CreateProjectUseCase::Response CreateProjectUseCase::execute(const Request& requ
 }
 
 std::string CreateProjectUseCase::generateProjectId() {
-    // In a real system, you'd use a UUID library or proper ID generation service
-    auto now = std::chrono::system_clock::now().time_since_epoch();
-    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
-    return "proj_" + std::to_string(millis);
+    return "proj_" + IdGenerator::next();
 }
 
 std::string CreateProjectUseCase::validateRequest(const Request& request) {
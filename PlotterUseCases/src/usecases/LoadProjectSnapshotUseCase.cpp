@@ -0,0 +1,70 @@
+#include "usecases/LoadProjectSnapshotUseCase.h"
+#include <stdexcept>
+#include <unordered_set>
+
+LoadProjectSnapshotUseCase::LoadProjectSnapshotUseCase(
+    std::shared_ptr<ProjectRepository> projectRepo,
+    std::shared_ptr<FolderRepository> folderRepo,
+    std::shared_ptr<NoteRepository> noteRepo
+) : projectRepository(projectRepo), folderRepository(folderRepo), noteRepository(noteRepo) {
+    if (!projectRepository) {
+        throw std::invalid_argument("ProjectRepository cannot be null");
+    }
+    if (!folderRepository) {
+        throw std::invalid_argument("FolderRepository cannot be null");
+    }
+    if (!noteRepository) {
+        throw std::invalid_argument("NoteRepository cannot be null");
+    }
+}
+
+LoadProjectSnapshotUseCase::Response LoadProjectSnapshotUseCase::execute(const Request& request) {
+    Response response;
+
+    // Validate request
+    std::string validationError = validateRequest(request);
+    if (!validationError.empty()) {
+        response.success = false;
+        response.errorMessage = validationError;
+        return response;
+    }
+
+    try {
+        auto project = projectRepository->findById(request.projectId);
+        if (!project.has_value()) {
+            response.success = false;
+            response.errorMessage = "Project not found: " + request.projectId;
+            return response;
+        }
+
+        // Two bulk listings: every folder of the project, then the notes of
+        // all of them. The snapshot sorts out the structure.
+        std::vector<Folder> folders = folderRepository->findAllInProject(request.projectId);
+        std::vector<std::string> folderIds;
+        folderIds.reserve(folders.size());
+        std::unordered_set<std::string> listed;
+        for (const Folder& folder : folders) {
+            if (listed.insert(folder.getId()).second) {
+                folderIds.push_back(folder.getId());
+            }
+        }
+        std::vector<Note> notes = noteRepository->findByParentFolderIds(folderIds);
+
+        response.snapshot.emplace(*project, folders, notes);
+        response.success = true;
+        return response;
+
+    } catch (const std::exception& e) {
+        response.success = false;
+        response.errorMessage = "Failed to load project snapshot: " + std::string(e.what());
+        return response;
+    }
+}
+
+std::string LoadProjectSnapshotUseCase::validateRequest(const Request& request) {
+    if (request.projectId.empty()) {
+        return "Project ID cannot be empty";
+    }
+
+    return ""; // Valid
+}
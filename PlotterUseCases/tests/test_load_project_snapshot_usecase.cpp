@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "usecases/LoadProjectSnapshotUseCase.h"
+#include "InMemoryProjectRepository.h"
+#include "InMemoryFolderRepository.h"
+#include "InMemoryNoteRepository.h"
+#include <memory>
+#include <stdexcept>
+
+// The snapshot never reads note content
+class UnusedNoteStorage : public NoteStorage {
+public:
+    std::string loadNote(const std::string&) override {
+        throw std::runtime_error("Note content should not be loaded");
+    }
+    void saveNote(const std::string&, const std::string&) override {}
+    bool noteExists(const std::string&) override { return false; }
+};
+
+class LoadProjectSnapshotUseCaseTest : public ::testing::Test {
+protected:
+    std::shared_ptr<InMemoryProjectRepository> projectRepo;
+    std::shared_ptr<InMemoryFolderRepository> folderRepo;
+    std::shared_ptr<InMemoryNoteRepository> noteRepo;
+    std::unique_ptr<LoadProjectSnapshotUseCase> useCase;
+
+    void SetUp() override {
+        projectRepo = std::make_shared<InMemoryProjectRepository>();
+        folderRepo = std::make_shared<InMemoryFolderRepository>();
+        noteRepo = std::make_shared<InMemoryNoteRepository>(std::make_shared<UnusedNoteStorage>());
+        useCase = std::make_unique<LoadProjectSnapshotUseCase>(projectRepo, folderRepo, noteRepo);
+
+        // proj-1 / folder-a / { folder-b / note-2, note-1 }
+        Project project("proj-1", "Project", "");
+        project.addFolderId("folder-a");
+        projectRepo->save(project);
+
+        Folder folderA("folder-a", "A", "", "proj-1", "");
+        folderA.addSubfolderId("folder-b");
+        folderA.addNoteId("note-1");
+        folderRepo->save(folderA);
+
+        Folder folderB("folder-b", "B", "", "", "folder-a");
+        folderB.addNoteId("note-2");
+        folderRepo->save(folderB);
+
+        noteRepo->save(Note("note-1", "One", "one.md", "folder-a"));
+        noteRepo->save(Note("note-2", "Two", "two.md", "folder-b"));
+    }
+};
+
+TEST_F(LoadProjectSnapshotUseCaseTest, LoadSnapshot_NestedProject_Success) {
+    LoadProjectSnapshotUseCase::Request request;
+    request.projectId = "proj-1";
+
+    auto response = useCase->execute(request);
+
+    ASSERT_TRUE(response.success);
+    ASSERT_TRUE(response.snapshot.has_value());
+    const ProjectSnapshot& snapshot = *response.snapshot;
+    EXPECT_EQ(snapshot.size(), 5u);
+    EXPECT_EQ(snapshot.folderCount(), 2u);
+    EXPECT_EQ(snapshot.noteCount(), 2u);
+
+    ProjectSnapshot::Index note2 = snapshot.indexOf("note-2");
+    ASSERT_NE(note2, ProjectSnapshot::NONE);
+    EXPECT_EQ(snapshot.depth(note2), 3u);
+    EXPECT_TRUE(snapshot.isAncestor(snapshot.indexOf("folder-a"), note2));
+    EXPECT_EQ(snapshot.name(snapshot.parent(note2)), "B");
+}
+
+TEST_F(LoadProjectSnapshotUseCaseTest, LoadSnapshot_NonExistentProject_Fails) {
+    LoadProjectSnapshotUseCase::Request request;
+    request.projectId = "missing";
+
+    auto response = useCase->execute(request);
+
+    EXPECT_FALSE(response.success);
+    EXPECT_FALSE(response.snapshot.has_value());
+    EXPECT_NE(response.errorMessage.find("not found"), std::string::npos);
+}
+
+TEST_F(LoadProjectSnapshotUseCaseTest, LoadSnapshot_EmptyId_ValidationError) {
+    LoadProjectSnapshotUseCase::Request request;
+
+    auto response = useCase->execute(request);
+
+    EXPECT_FALSE(response.success);
+    EXPECT_FALSE(response.errorMessage.empty());
+}